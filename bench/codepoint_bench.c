@@ -0,0 +1,79 @@
+// 码点表生成微基准：逐元素 realloc（旧 GenerateCJKCodepoints）对比位图集合 + 静态范围表
+//
+// 用法: codepoint_bench [迭代次数]
+
+#include "codepoint_set.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static unsigned long allocationCount = 0;
+
+static void *CountedRealloc(void *ptr, size_t size) {
+    allocationCount++;
+    return realloc(ptr, size);
+}
+
+static void *CountedMalloc(size_t size) {
+    allocationCount++;
+    return malloc(size);
+}
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// 旧实现：每个码点 realloc 一次
+static int *GenerateCodepointsLegacy(int *codepointCount) {
+    int *codepoints = NULL;
+    int count = 0;
+
+    for (int r = 0; r < CODEPOINT_RANGES_CJK_COUNT; r++) {
+        for (int c = CODEPOINT_RANGES_CJK[r].first; c <= CODEPOINT_RANGES_CJK[r].last; c++) {
+            codepoints = (int *)CountedRealloc(codepoints, (count + 1) * sizeof(int));
+            codepoints[count++] = c;
+        }
+    }
+
+    *codepointCount = count;
+    return codepoints;
+}
+
+// 新实现：范围表写入位图，按集合大小一次分配后导出
+static int *GenerateCodepointsFromSet(int *codepointCount) {
+    static CodepointSet set;
+    ClearCodepointSet(&set);
+    AddCodepointRanges(&set, CODEPOINT_RANGES_CJK, CODEPOINT_RANGES_CJK_COUNT);
+
+    int *codepoints = (int *)CountedMalloc(set.count * sizeof(int));
+    *codepointCount = CodepointSetToArray(&set, codepoints, set.count);
+    return codepoints;
+}
+
+static void RunCase(const char *name, int *(*generate)(int *), int iterations) {
+    allocationCount = 0;
+    long checksum = 0;
+    int count = 0;
+
+    double start = NowSeconds();
+    for (int i = 0; i < iterations; i++) {
+        int *codepoints = generate(&count);
+        checksum += codepoints[count - 1];
+        free(codepoints);
+    }
+    double elapsed = NowSeconds() - start;
+
+    printf("%-10s 码点 %6d | 每次 %9.1f us | 每次分配 %8lu 次 | checksum %ld\n",
+           name, count, elapsed * 1e6 / iterations, allocationCount / iterations, checksum);
+}
+
+int main(int argc, char **argv) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 200;
+    if (iterations <= 0) iterations = 1;
+
+    RunCase("realloc", GenerateCodepointsLegacy, iterations);
+    RunCase("bitset", GenerateCodepointsFromSet, iterations);
+    return 0;
+}
@@ -0,0 +1,223 @@
+// 无窗口的垃圾模拟基准：每组创建独立的 TrashWorld，注入帧时间、边界与窗口加速度，按固定种子生成垃圾
+//
+// 用法: trash_bench [-n 数量]... [-s 步数] [-r 种子] [-a 加速度x,加速度y] [-t 线程数] [-w 宽x高] [-p] [-f 间隔]
+//   -n  垃圾数量，可重复，默认 100 1000 10000
+//   -s  每组模拟的帧数，默认 600（10 秒）
+//   -r  随机种子，默认 12345
+//   -a  每 120 帧施加 10 帧的窗口加速度，默认不晃动
+//   -t  总线程数（含主线程），默认 1
+//   -w  窗口尺寸，默认按数量缩放，使堆积密度与 20 个垃圾的界面相当
+//   -p  关闭多线程物理路径
+//   -f  帧时间直方图：每隔这么多帧插入一个 250 ms 的长帧（模拟拖动窗口或卡顿），
+//       分别按旧的追赶方式（最多追赶 0.25 s）与现在的 TRASH_MAX_SUBSTEPS 上限步进，输出每帧更新耗时的分布
+//
+// 不创建窗口，也不调用任何绘制函数，可在 CI 上运行
+
+#include "trash_world.h"
+#include "trash_physics.h"
+#include "worker_pool.h"
+#include "raylib.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_FRAME_TIME (1.0f / 60.0f)
+#define BENCH_MAX_COUNTS 16
+#define BENCH_SHAKE_PERIOD 120
+#define BENCH_SHAKE_FRAMES 10
+#define BENCH_HITCH_TIME 0.25f          // 长帧的时长，也是旧版本追赶时间的上限
+#define BENCH_HISTOGRAM_BUCKETS 8       // 0.25 ms 起每档翻倍，最后一档为 16 ms 以上
+
+typedef struct {
+    int counts[BENCH_MAX_COUNTS];
+    int countCount;
+    int frames;
+    unsigned int seed;
+    Vector2 shake;
+    int threads;
+    int width;
+    int height;
+    bool parallel;
+    int hitchPeriod;    // 大于 0 时输出帧时间直方图
+} BenchOptions;
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static bool ParseOptions(int argc, char **argv, BenchOptions *options) {
+    *options = (BenchOptions){ .frames = 600, .seed = 12345u, .threads = 1, .parallel = true };
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (strcmp(arg, "-p") == 0) {
+            options->parallel = false;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        const char *value = argv[++i];
+
+        if (strcmp(arg, "-n") == 0 && options->countCount < BENCH_MAX_COUNTS) {
+            options->counts[options->countCount++] = atoi(value);
+        } else if (strcmp(arg, "-s") == 0) {
+            options->frames = atoi(value);
+        } else if (strcmp(arg, "-r") == 0) {
+            options->seed = (unsigned int)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "-a") == 0) {
+            if (sscanf(value, "%f,%f", &options->shake.x, &options->shake.y) != 2) return false;
+        } else if (strcmp(arg, "-t") == 0) {
+            options->threads = atoi(value);
+        } else if (strcmp(arg, "-w") == 0) {
+            if (sscanf(value, "%dx%d", &options->width, &options->height) != 2) return false;
+        } else if (strcmp(arg, "-f") == 0) {
+            options->hitchPeriod = atoi(value);
+        } else {
+            return false;
+        }
+    }
+
+    if (options->countCount == 0) {
+        const int defaults[] = { 100, 1000, 10000 };
+        for (int i = 0; i < 3; i++) options->counts[options->countCount++] = defaults[i];
+    }
+    if (options->frames < 1) options->frames = 1;
+    if (options->threads < 1) options->threads = 1;
+    return true;
+}
+
+// 界面默认 20 个垃圾对应 800x600 左右的窗口
+static void GetBenchBounds(const BenchOptions *options, int count, int *width, int *height) {
+    *width = options->width;
+    *height = options->height;
+    if (*width <= 0 || *height <= 0) {
+        float scale = sqrtf((float)count / 20.0f);
+        *width = (int)(800.0f * (scale > 1.0f ? scale : 1.0f));
+        *height = (int)(600.0f * (scale > 1.0f ? scale : 1.0f));
+    }
+}
+
+static TrashWorld *CreateBenchWorld(const BenchOptions *options, int count, int width, int height) {
+    TrashWorld *world = CreateTrashWorld();
+    if (world == NULL) return NULL;
+    SetTrashWorldBounds(world, width, height);
+    SetTrashWorldParallel(world, options->parallel);
+    SetRandomSeed(options->seed);
+
+    const int durations[] = { 25, 45, 60 };
+    for (int i = 0; i < count; i++) {
+        GenerateWorldTrash(world, durations[i % 3]);
+    }
+    ResetTrashWorldStats(world);
+    return world;
+}
+
+static void RunCase(const BenchOptions *options, int count) {
+    int width, height;
+    GetBenchBounds(options, count, &width, &height);
+    TrashWorld *world = CreateBenchWorld(options, count, width, height);
+    if (world == NULL) return;
+
+    double start = NowSeconds();
+    for (int frame = 0; frame < options->frames; frame++) {
+        bool shaking = (frame % BENCH_SHAKE_PERIOD) < BENCH_SHAKE_FRAMES;
+        StepTrashWorld(world, (TrashStepInput){
+            .deltaTime = BENCH_FRAME_TIME,
+            .width = width,
+            .height = height,
+            .windowAcceleration = shaking ? options->shake : (Vector2){ 0.0f, 0.0f }
+        });
+    }
+    double elapsed = NowSeconds() - start;
+
+    TrashStepStats stats = GetTrashWorldStats(world);
+    unsigned long steps = stats.steps > 0 ? stats.steps : 1;
+    printf("%6d 个垃圾 %dx%d | %5lu 步 %9.0f 步/秒 | %7.1f ns/垃圾步 | 候选对 %8.1f/步 接触 %8.1f/步 | 扩容 %lu 次 | %s\n",
+           count, width, height, stats.steps,
+           elapsed > 0.0 ? stats.steps / elapsed : 0.0,
+           stats.bodySteps > 0 ? elapsed * 1e9 / stats.bodySteps : 0.0,
+           (double)stats.pairsTested / steps, (double)stats.contacts / steps,
+           stats.allocations, IsTrashWorldAnimating(world) ? "仍在运动" : "已静止");
+
+    DestroyTrashWorld(world);
+}
+
+// 旧版本一帧内把最多 0.25 s 的时间全部追赶完；这里按每次不超过 TRASH_MAX_SUBSTEPS 步切开调用，
+// 总步数与旧版本相同（默认 60 Hz 步频）
+static void StepLegacyCatchUp(TrashWorld *world, TrashStepInput input) {
+    float remaining = (input.deltaTime < BENCH_HITCH_TIME) ? input.deltaTime : BENCH_HITCH_TIME;
+    float chunk = BENCH_FRAME_TIME * TRASH_MAX_SUBSTEPS;
+    do {
+        input.deltaTime = (remaining < chunk) ? remaining : chunk;
+        StepTrashWorld(world, input);
+        remaining -= input.deltaTime;
+    } while (remaining > 0.0f);
+}
+
+static void RunHistogram(const BenchOptions *options, int count, bool legacy) {
+    int width, height;
+    GetBenchBounds(options, count, &width, &height);
+    TrashWorld *world = CreateBenchWorld(options, count, width, height);
+    if (world == NULL) return;
+
+    unsigned long buckets[BENCH_HISTOGRAM_BUCKETS] = {0};
+    double worst = 0.0;
+    for (int frame = 0; frame < options->frames; frame++) {
+        bool shaking = (frame % BENCH_SHAKE_PERIOD) < BENCH_SHAKE_FRAMES;
+        bool hitch = frame > 0 && frame % options->hitchPeriod == 0;
+        TrashStepInput input = {
+            .deltaTime = hitch ? BENCH_HITCH_TIME : BENCH_FRAME_TIME,
+            .width = width,
+            .height = height,
+            .windowAcceleration = shaking ? options->shake : (Vector2){ 0.0f, 0.0f }
+        };
+
+        double start = NowSeconds();
+        if (legacy) {
+            StepLegacyCatchUp(world, input);
+        } else {
+            StepTrashWorld(world, input);
+        }
+        double cost = (NowSeconds() - start) * 1000.0;
+        if (cost > worst) worst = cost;
+
+        int bucket = 0;
+        for (double limit = 0.25; bucket < BENCH_HISTOGRAM_BUCKETS - 1 && cost >= limit; limit *= 2.0) bucket++;
+        buckets[bucket]++;
+    }
+
+    printf("%6d 个垃圾 %s | <0.25ms %5lu | <0.5 %5lu | <1 %5lu | <2 %5lu | <4 %5lu | <8 %5lu | <16 %5lu | >=16 %5lu | 最长 %6.2f ms\n",
+           count, legacy ? "追赶 0.25 s" : "上限 4 步  ",
+           buckets[0], buckets[1], buckets[2], buckets[3], buckets[4], buckets[5], buckets[6], buckets[7], worst);
+
+    DestroyTrashWorld(world);
+}
+
+int main(int argc, char **argv) {
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, &options)) {
+        fprintf(stderr, "用法: %s [-n 数量]... [-s 步数] [-r 种子] [-a x,y] [-t 线程数] [-w 宽x高] [-p] [-f 间隔]\n", argv[0]);
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    if (options.threads > 1) InitWorkerPool(options.threads - 1);
+    printf("种子 %u，每组 %d 帧，%d 线程，多线程路径%s，SIMD %s\n",
+           options.seed, options.frames, options.threads,
+           options.parallel ? "开启" : "关闭", IsTrashSimdEnabled() ? "开启" : "关闭");
+
+    for (int i = 0; i < options.countCount; i++) {
+        if (options.hitchPeriod > 0) {
+            RunHistogram(&options, options.counts[i], true);
+            RunHistogram(&options, options.counts[i], false);
+        } else {
+            RunCase(&options, options.counts[i]);
+        }
+    }
+
+    if (options.threads > 1) ShutdownWorkerPool();
+    return 0;
+}
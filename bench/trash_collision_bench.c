@@ -0,0 +1,136 @@
+// 垃圾碰撞步进基准：逐对检测（旧 UpdateTrash 的 O(n²) 循环）对比均匀网格宽阶段
+//
+// 用法: trash_collision_bench [步数倍率]
+// 垃圾按固定种子生成在与数量成比例的区域内，受重力落向底部堆积，两种实现使用相同的初始状态
+
+#include "trash_collision.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_TIME_STEP (1.0f / 60.0f)
+#define BENCH_GRAVITY (9.8f * 8.0f)
+
+typedef struct {
+    TrashBodies bodies;
+    float width;
+    float height;
+} BenchWorld;
+
+static unsigned int benchSeed = 12345u;
+
+static float RandomRange(float min, float max) {
+    benchSeed = benchSeed * 1664525u + 1013904223u;
+    return min + (max - min) * (float)(benchSeed >> 8) / (float)(1u << 24);
+}
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// 每个垃圾平均占 100x100 像素，与界面上 20 个垃圾堆积时的密度相当
+static void InitBenchWorld(BenchWorld *world, int count) {
+    benchSeed = 12345u;
+    memset(&world->bodies, 0, sizeof(TrashBodies));
+    world->width = 100.0f * sqrtf((float)count) * 1.6f;
+    world->height = 100.0f * sqrtf((float)count) / 1.6f;
+    ReserveTrashBodies(&world->bodies, count);
+
+    for (int i = 0; i < count; i++) {
+        float radius = RandomRange(15.0f, 30.0f);
+        float x = RandomRange(radius, world->width - radius);
+        float y = RandomRange(radius, world->height - radius);
+        float vx = RandomRange(-300.0f, 300.0f);
+        float vy = RandomRange(-300.0f, 300.0f);
+        PushTrashBody(&world->bodies, x, y, vx, vy, radius, 0.85f, 0.8f);
+    }
+}
+
+static void CopyBenchWorld(BenchWorld *dst, const BenchWorld *src) {
+    const TrashBodies *from = &src->bodies;
+    dst->width = src->width;
+    dst->height = src->height;
+    memset(&dst->bodies, 0, sizeof(TrashBodies));
+    ReserveTrashBodies(&dst->bodies, from->count);
+    for (int i = 0; i < from->count; i++) {
+        PushTrashBody(&dst->bodies, from->positionX[i], from->positionY[i], from->velocityX[i], from->velocityY[i],
+                      from->radius[i], from->bounceFactor[i], from->friction[i]);
+    }
+}
+
+// 使用与 UpdateTrash 相同的积分与边界函数（不含窗口加速度）
+static void IntegrateBenchWorld(BenchWorld *world) {
+    TrashIntegrator integrator = { 0.0f, BENCH_GRAVITY, 0.99f, BENCH_TIME_STEP };
+    IntegrateTrashBodies(&world->bodies, integrator);
+    ConstrainTrashBodies(&world->bodies, world->width, world->height, BENCH_TIME_STEP);
+}
+
+static int ResolveBruteForce(TrashBodies *bodies) {
+    int contacts = 0;
+    for (int i = 0; i < bodies->count; i++) {
+        for (int j = i + 1; j < bodies->count; j++) {
+            CollisionInfo info = GetTrashCollisionInfo(bodies, i, j);
+            if (info.collided) {
+                ResolveTrashCollision(bodies, i, j, info);
+                contacts++;
+            }
+        }
+    }
+    return contacts;
+}
+
+static void RunCase(const BenchWorld *initial, int steps) {
+    BenchWorld brute, grid;
+    CopyBenchWorld(&brute, initial);
+    CopyBenchWorld(&grid, initial);
+    TrashBroadPhase broadPhase;
+    InitTrashBroadPhase(&broadPhase);
+
+    long bruteContacts = 0, gridContacts = 0, gridPairs = 0;
+    double bruteTime = 0.0, gridTime = 0.0;
+
+    for (int s = 0; s < steps; s++) {
+        IntegrateBenchWorld(&brute);
+        double start = NowSeconds();
+        bruteContacts += ResolveBruteForce(&brute.bodies);
+        bruteTime += NowSeconds() - start;
+
+        IntegrateBenchWorld(&grid);
+        start = NowSeconds();
+        gridContacts += ResolveTrashCollisions(&broadPhase, &grid.bodies);
+        gridTime += NowSeconds() - start;
+        gridPairs += broadPhase.pairList.count;
+    }
+
+    int count = initial->bodies.count;
+    long allPairs = (long)count * (count - 1) / 2;
+    printf("%6d 个垃圾 %5d 步 | 逐对 %10.1f us/步 (检测 %9ld 对, 接触 %6.1f) | 网格 %8.1f us/步 (检测 %7.1f 对, 接触 %6.1f) | 加速 %6.1fx\n",
+           count, steps,
+           bruteTime * 1e6 / steps, allPairs, (double)bruteContacts / steps,
+           gridTime * 1e6 / steps, (double)gridPairs / steps, (double)gridContacts / steps,
+           gridTime > 0.0 ? bruteTime / gridTime : 0.0);
+
+    FreeTrashBroadPhase(&broadPhase);
+    FreeTrashBodies(&brute.bodies);
+    FreeTrashBodies(&grid.bodies);
+}
+
+int main(int argc, char **argv) {
+    int scale = (argc > 1) ? atoi(argv[1]) : 1;
+    if (scale <= 0) scale = 1;
+
+    const int counts[] = { 20, 1000, 10000 };
+    const int steps[] = { 2000, 120, 10 };
+
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++) {
+        BenchWorld world;
+        InitBenchWorld(&world, counts[i]);
+        RunCase(&world, steps[i] * scale);
+        FreeTrashBodies(&world.bodies);
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+// 垃圾积分基准：旧的结构体数组（Trash 记录）逐个积分，对比结构数组的标量版本与 SSE 版本
+//
+// 用法: trash_integrate_bench [步数倍率]
+// 同时校验标量版本与 SIMD 版本的结果差异
+
+#include "trash.h"
+#include "trash_physics.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_TIME_STEP (1.0f / 60.0f)
+#define BENCH_GRAVITY (9.8f * 8.0f)
+#define BENCH_WINDOW_X 120.0f          // 模拟拖动窗口时的加速度
+#define BENCH_WINDOW_Y -40.0f
+#define BENCH_TOLERANCE 1e-3f
+
+static unsigned int benchSeed = 12345u;
+
+static float RandomRange(float min, float max) {
+    benchSeed = benchSeed * 1664525u + 1013904223u;
+    return min + (max - min) * (float)(benchSeed >> 8) / (float)(1u << 24);
+}
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// 旧实现：Trash 记录中热字段与冷字段交错
+static void IntegrateRecords(Trash *trashes, int count) {
+    for (int i = 0; i < count; i++) {
+        if (!trashes[i].active || trashes[i].cleaning) continue;
+        trashes[i].velocity.y += BENCH_GRAVITY * BENCH_TIME_STEP;
+        trashes[i].velocity.x += BENCH_WINDOW_X * BENCH_TIME_STEP;
+        trashes[i].velocity.y += BENCH_WINDOW_Y * BENCH_TIME_STEP;
+        trashes[i].velocity.x *= 0.99f;
+        trashes[i].velocity.y *= 0.99f;
+        trashes[i].position.x += trashes[i].velocity.x * BENCH_TIME_STEP;
+        trashes[i].position.y += trashes[i].velocity.y * BENCH_TIME_STEP;
+    }
+}
+
+static void InitBodies(TrashBodies *bodies, Trash *records, int count) {
+    benchSeed = 12345u;
+    memset(bodies, 0, sizeof(TrashBodies));
+    ReserveTrashBodies(bodies, count);
+
+    for (int i = 0; i < count; i++) {
+        float x = RandomRange(0.0f, 1920.0f);
+        float y = RandomRange(0.0f, 1080.0f);
+        float vx = RandomRange(-300.0f, 300.0f);
+        float vy = RandomRange(-300.0f, 300.0f);
+        float radius = RandomRange(15.0f, 30.0f);
+        PushTrashBody(bodies, x, y, vx, vy, radius, 0.85f, 0.8f);
+        // 每 16 个有 1 个处于清理中，验证冻结掩码
+        bool cleaning = (i % 16) == 15;
+        if (cleaning) {
+            bodies->mobility[i] = 0.0f;
+            bodies->velocityX[i] = 0.0f;
+            bodies->velocityY[i] = 0.0f;
+        }
+        if (records != NULL) {
+            records[i] = (Trash){
+                .position = { x, y },
+                .velocity = { cleaning ? 0.0f : vx, cleaning ? 0.0f : vy },
+                .radius = radius,
+                .scale = radius / 30.0f,
+                .active = true,
+                .cleaning = cleaning,
+                .bounceFactor = 0.85f,
+                .friction = 0.8f
+            };
+        }
+    }
+}
+
+static float MaxDifference(const float *a, const float *b, int count) {
+    float maxDiff = 0.0f;
+    for (int i = 0; i < count; i++) {
+        float diff = fabsf(a[i] - b[i]);
+        if (diff > maxDiff) maxDiff = diff;
+    }
+    return maxDiff;
+}
+
+static void RunCase(int count, int steps) {
+    Trash *records = (Trash *)malloc((size_t)count * sizeof(Trash));
+    TrashBodies scalar, simd;
+    InitBodies(&scalar, records, count);
+    InitBodies(&simd, NULL, count);
+
+    TrashIntegrator integrator = {
+        .accelerationX = BENCH_WINDOW_X,
+        .accelerationY = BENCH_GRAVITY + BENCH_WINDOW_Y,
+        .damping = 0.99f,
+        .timeStep = BENCH_TIME_STEP
+    };
+
+    double start = NowSeconds();
+    for (int s = 0; s < steps; s++) IntegrateRecords(records, count);
+    double recordTime = NowSeconds() - start;
+
+    start = NowSeconds();
+    for (int s = 0; s < steps; s++) IntegrateTrashBodiesScalar(&scalar, integrator);
+    double scalarTime = NowSeconds() - start;
+
+    start = NowSeconds();
+    for (int s = 0; s < steps; s++) IntegrateTrashBodies(&simd, integrator);
+    double simdTime = NowSeconds() - start;
+
+    float diff = MaxDifference(scalar.positionX, simd.positionX, count);
+    float diffY = MaxDifference(scalar.positionY, simd.positionY, count);
+    if (diffY > diff) diff = diffY;
+
+    // 旧实现的加速度分三次累加，与合并后的结果只差舍入误差
+    float recordDiff = 0.0f;
+    for (int i = 0; i < count; i++) {
+        float dx = fabsf(records[i].position.x - scalar.positionX[i]);
+        float dy = fabsf(records[i].position.y - scalar.positionY[i]);
+        if (dx > recordDiff) recordDiff = dx;
+        if (dy > recordDiff) recordDiff = dy;
+    }
+
+    printf("%8d 个垃圾 %4d 步 | 记录 %8.2f ns/个 | 结构数组标量 %6.2f ns/个 | %s %6.2f ns/个 (%.1fx) | 标量/SIMD 差 %.2e %s | 旧实现差 %.2e\n",
+           count, steps,
+           recordTime * 1e9 / ((double)count * steps),
+           scalarTime * 1e9 / ((double)count * steps),
+           IsTrashSimdEnabled() ? "SSE" : "标量回退",
+           simdTime * 1e9 / ((double)count * steps),
+           simdTime > 0.0 ? recordTime / simdTime : 0.0,
+           diff, diff <= BENCH_TOLERANCE ? "通过" : "超出容差",
+           recordDiff);
+
+    free(records);
+    FreeTrashBodies(&scalar);
+    FreeTrashBodies(&simd);
+}
+
+int main(int argc, char **argv) {
+    int scale = (argc > 1) ? atoi(argv[1]) : 1;
+    if (scale <= 0) scale = 1;
+
+    const int counts[] = { 10000, 100000, 1000000 };
+    const int steps[] = { 2000, 200, 20 };
+
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++) {
+        RunCase(counts[i], steps[i] * scale);
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+// 多线程物理步进基准：1 到 N 个核心分别跑同一组初始状态，报告耗时、加速比与位置校验和
+//
+// 用法: trash_parallel_bench [最大线程数] [步数]
+// 校验和在所有线程数下必须相同，否则说明并行路径引入了与调度有关的结果差异
+
+#include "trash_collision.h"
+#include "trash_physics.h"
+#include "worker_pool.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_TIME_STEP (1.0f / 60.0f)
+#define BENCH_GRAVITY (9.8f * 8.0f)
+
+static unsigned int benchSeed = 12345u;
+
+static float RandomRange(float min, float max) {
+    benchSeed = benchSeed * 1664525u + 1013904223u;
+    return min + (max - min) * (float)(benchSeed >> 8) / (float)(1u << 24);
+}
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// 与 trash_collision_bench 相同的密度：每个垃圾平均占 100x100 像素
+static void InitBenchBodies(TrashBodies *bodies, int count, float *width, float *height) {
+    benchSeed = 12345u;
+    memset(bodies, 0, sizeof(TrashBodies));
+    *width = 100.0f * sqrtf((float)count) * 1.6f;
+    *height = 100.0f * sqrtf((float)count) / 1.6f;
+    ReserveTrashBodies(bodies, count);
+
+    for (int i = 0; i < count; i++) {
+        float radius = RandomRange(15.0f, 30.0f);
+        float x = RandomRange(radius, *width - radius);
+        float y = RandomRange(radius, *height - radius);
+        float vx = RandomRange(-300.0f, 300.0f);
+        float vy = RandomRange(-300.0f, 300.0f);
+        PushTrashBody(bodies, x, y, vx, vy, radius, 0.85f, 0.8f);
+    }
+}
+
+// 按位累加位置，任何一位不同都会反映在结果里
+static unsigned long long ChecksumBodies(const TrashBodies *bodies) {
+    unsigned long long hash = 1469598103934665603ULL;
+    for (int i = 0; i < bodies->count; i++) {
+        unsigned int bits[2];
+        memcpy(&bits[0], &bodies->positionX[i], sizeof(float));
+        memcpy(&bits[1], &bodies->positionY[i], sizeof(float));
+        hash = (hash ^ bits[0]) * 1099511628211ULL;
+        hash = (hash ^ bits[1]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+static double RunCase(int count, int steps, unsigned long long *checksum, long *contacts) {
+    TrashBodies bodies;
+    float width, height;
+    InitBenchBodies(&bodies, count, &width, &height);
+    TrashBroadPhase broadPhase;
+    InitTrashBroadPhase(&broadPhase);
+    TrashIntegrator integrator = { 0.0f, BENCH_GRAVITY, 0.99f, BENCH_TIME_STEP };
+
+    *contacts = 0;
+    double start = NowSeconds();
+    for (int s = 0; s < steps; s++) {
+        StepTrashBodiesParallel(&bodies, integrator, width, height);
+        *contacts += ResolveTrashCollisionsParallel(&broadPhase, &bodies);
+    }
+    double elapsed = NowSeconds() - start;
+
+    *checksum = ChecksumBodies(&bodies);
+    FreeTrashBroadPhase(&broadPhase);
+    FreeTrashBodies(&bodies);
+    return elapsed;
+}
+
+int main(int argc, char **argv) {
+    int maxThreads = (argc > 1) ? atoi(argv[1]) : GetCpuCoreCount();
+    int steps = (argc > 2) ? atoi(argv[2]) : 60;
+    if (maxThreads < 1) maxThreads = 1;
+    if (steps < 1) steps = 1;
+
+    const int counts[] = { 10000, 50000 };
+    printf("CPU 核心数 %d，每组 %d 步\n", GetCpuCoreCount(), steps);
+
+    for (int c = 0; c < (int)(sizeof(counts) / sizeof(counts[0])); c++) {
+        double baseTime = 0.0;
+        unsigned long long baseChecksum = 0;
+
+        for (int threads = 1; threads <= maxThreads; threads++) {
+            // 主线程也领取批次，所以 N 个核心对应 N-1 个工作线程
+            if (threads > 1) InitWorkerPool(threads - 1);
+
+            unsigned long long checksum;
+            long contacts;
+            double elapsed = RunCase(counts[c], steps, &checksum, &contacts);
+            if (threads == 1) {
+                baseTime = elapsed;
+                baseChecksum = checksum;
+            }
+
+            printf("%6d 个垃圾 %2d 线程 | %9.1f us/步 | 加速 %5.2fx | 接触 %8.1f/步 | 校验和 %016llx %s\n",
+                   counts[c], threads, elapsed * 1e6 / steps,
+                   elapsed > 0.0 ? baseTime / elapsed : 0.0,
+                   (double)contacts / steps, checksum,
+                   checksum == baseChecksum ? "一致" : "不一致");
+
+            if (threads > 1) ShutdownWorkerPool();
+        }
+    }
+    return 0;
+}
@@ -2,7 +2,10 @@
 #define ACHIEVEMENT_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <time.h>
+#include "state_format.h"
+#include "metrics.h"
 
 // 正面成就ID
 typedef enum {
@@ -37,45 +40,95 @@ typedef enum {
     NEG_COUNT                // 负面成就总数
 } NegativeAchievementID;
 
-// 成就结构体
+#define MAX_ACHIEVEMENT_DEFS 4096       // 正面与负面成就合计上限
+#define ACHIEVEMENT_BITSET_WORDS (MAX_ACHIEVEMENT_DEFS / 64)
+
+typedef enum {
+    RULE_AT_LEAST,    // >=
+    RULE_AT_MOST,     // <=
+    RULE_EQUAL        // ==
+} RuleComparator;
+
+// 成就定义：名称、描述与解锁规则。规则为「指标 比较 阈值」，只在该指标变化时判断；
+// 时间窗口 [hourStart, hourEnd) 为本地时间的小时，可跨午夜，两者相等表示不限时间。
+// metric 为 METRIC_COUNT 的成就没有规则，只能由代码解锁。
+// 名称与描述指向只读的字符串表（内置定义为字符串常量，文件定义为加载时保留的文件内容）
 typedef struct {
-    int id;
-    char name[50];
-    char description[100];
-    bool unlocked;
-    time_t unlockTime; // 解锁时间
-} Achievement;
+    const char *name;
+    const char *description;
+    bool negative;
+    MetricID metric;
+    RuleComparator comparator;
+    int threshold;
+    int hourStart;
+    int hourEnd;
+} AchievementDef;
 
-// 成就管理器
+// 稀疏的解锁时间表项，只为已解锁的成就保存，按定义编号升序
 typedef struct {
-    // 正面成就
-    Achievement achievements[ACH_COUNT];
-    // 负面成就
-    Achievement negativeAchievements[NEG_COUNT];
+    int def;
+    time_t time;
+} AchievementUnlock;
+
+// 成就管理器：解锁状态为按定义编号的位图，名称与描述不在这里
+typedef struct {
+    int achievementCount;        // 正面成就数
+    int negativeCount;           // 负面成就数
+    uint64_t unlocked[ACHIEVEMENT_BITSET_WORDS];
+    int unlockedCount;
+    AchievementUnlock *unlockTimes;
+    int unlockTimeCount;
+    int unlockTimeCapacity;
     
-    // 统计信息
-    int totalPomodoros;          // 总番茄钟计数
-    int cleanedTrashCount;       // 清理的垃圾总数
-    int generatedTrashCount;     // 产生的垃圾总数
-    int interruptionsCount;      // 中断次数
-    int longSessionCount;        // 45分钟番茄钟计数
-    int currentStreak;           // 当前连续番茄钟计数
+    // 成就判断用到的状态，累计计数在 MetricsStore 中
+    int currentStreak;           // 当前连续天数，同步到 METRIC_STREAK_DAYS
     time_t lastPomodoroDate;     // 上一个番茄钟完成的日期
-    int streakDays;              // 当前连续天数
     bool interruptionOccurred;  // 标记当前番茄钟是否被中断
-    int consecutivePomodoros;   // 连续完成的番茄钟数
-    int dailyPomodoros;         // 今日完成的番茄钟数
+    int consecutivePomodoros;   // 连续完成的番茄钟数，同步到 METRIC_CONSECUTIVE_POMODOROS
+    int dailyPomodoros;         // 今日完成的番茄钟数，同步到 METRIC_DAILY_POMODOROS
     time_t lastPomodoroDay;     // 上次完成番茄钟的日期
+    unsigned int version;       // 解锁状态变化时递增，成就界面据此判断是否需要重绘
+
+    // 未解锁规则按指标分组的索引：ruleOrder[metricStart[m], metricStart[m] + metricPending[m])
+    // 是依赖指标 m 且尚未解锁的定义编号，解锁后移出；ruleOrder 按定义数分配
+    unsigned short *ruleOrder;
+    int ruleCapacity;
+    unsigned short metricStart[METRIC_COUNT + 1];
+    unsigned short metricPending[METRIC_COUNT];
+    unsigned int dirtyMetrics;   // 上次判断以来变化过的指标（按位）
+    bool indexValid;             // 解锁状态被整体替换（初始化、读档）后需要重建索引
 } AchievementManager;
 
+// 成就定义表，进程内共享。未加载文件时使用内置定义（顺序与 AchievementID、NegativeAchievementID 一致）；
+// 文本文件每行一个成就，字段以 | 分隔，# 开头的行为注释：
+//   +或- | 名称 | 描述 | 指标名 | >= <= == | 阈值 [| 开始小时-结束小时]
+// 存档按成就在正面或负面列表中的位置保存，新成就只能追加在末尾
+bool LoadAchievementDefinitions(const char *filename);
+int GetAchievementDefCount(void);
+const AchievementDef *GetAchievementDef(int index);
+int GetAchievementDefIndex(bool negative, int slot);   // 正面或负面列表中第 slot 个成就的定义编号
+
 // 函数声明
-void InitAchievementManager(AchievementManager *manager);
+void InitAchievementManager(AchievementManager *manager);   // 清空解锁状态，保留已分配的内存；首次调用前需清零
+void FreeAchievementManager(AchievementManager *manager);
+void BindAchievementMetrics(AchievementManager *manager, MetricsStore *metrics);   // 指标变化时标记对应规则待判断
+bool IsAchievementUnlocked(const AchievementManager *manager, int def);
+time_t GetAchievementUnlockTime(const AchievementManager *manager, int def);   // 未解锁时为 0
 void UnlockAchievement(AchievementManager *manager, AchievementID id);
 void UnlockNegativeAchievement(AchievementManager *manager, NegativeAchievementID id);
-void CheckAchievements(AchievementManager *manager, bool pomodoroCompleted, bool trashCleaned, int duration);
+void CheckAchievements(AchievementManager *manager, MetricsStore *metrics, bool pomodoroCompleted);
+// 按指定时间检查（连续天数、时间窗口、解锁时间都取 now），回放事件日志时使用
+void CheckAchievementsAt(AchievementManager *manager, MetricsStore *metrics, bool pomodoroCompleted, time_t now);
+// 存档为容器格式中的 "ACHV" 段：u32 正面数 | u32 负面数 | u64 解锁位[正面] | u64 解锁位[负面]
+//   | u32 解锁时间数 | (u32 位置, i64 解锁时间) × 解锁时间数（负面成就的位置带最高位），
+// 之后是成就判断用的状态（i32，日期为 i64）；旧版本的结构体原样存档也能读取
+#define ACHIEVEMENT_SECTION_TAG STATE_TAG('A', 'C', 'H', 'V')
+#define ACHIEVEMENT_SECTION_VERSION 3
+void WriteAchievementSection(StateWriter *writer, const AchievementManager *manager);
+bool ReadAchievementSection(const StateFile *file, AchievementManager *manager);
+bool ReadLegacyAchievements(AchievementManager *manager, MetricsStore *metrics, const void *data, size_t size);
 void SaveAchievements(const AchievementManager *manager, const char *filename);
-void LoadAchievements(AchievementManager *manager, const char *filename);
+void LoadAchievements(AchievementManager *manager, MetricsStore *metrics, const char *filename);
 void ResetAchievements(AchievementManager *manager);
-bool IsAllTrashTypeCleaned(void);
 
 #endif // ACHIEVEMENT_H
\ No newline at end of file
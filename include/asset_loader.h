@@ -0,0 +1,22 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include "raylib.h"
+#include "font_cache.h"
+#include "icon_atlas.h"
+
+// 异步资源加载：图片解码与字体光栅化在工作线程完成，纹理上传留在主线程并按帧限时
+void InitAssetLoader(void);
+void QueueTextureAsset(Texture2D *target, const char *fileName, bool essential, bool bilinear);
+void QueueFontAsset(Font *target, FontLoadJob job, bool essential);
+void QueueIconAtlasAsset(IconAtlas *target, bool essential);   // 图标文件路径需预先通过 SetIconSource 设置
+void StartAssetLoading(void);
+
+// 在主线程上传已解码的资源，单次调用耗时不超过 budgetSeconds（至少上传一个），返回上传数量
+int PumpAssetLoader(double budgetSeconds);
+float GetAssetLoadProgress(bool essentialOnly);
+bool AreEssentialAssetsReady(void);   // essential 资源即主界面所需资源
+bool IsAssetLoadingComplete(void);
+void ShutdownAssetLoader(void);       // 等待后台任务并丢弃未上传的数据
+
+#endif // ASSET_LOADER_H
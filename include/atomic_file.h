@@ -0,0 +1,24 @@
+#ifndef ATOMIC_FILE_H
+#define ATOMIC_FILE_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#define ATOMIC_FILE_PATH_MAX 512
+
+// 原子写文件（不依赖 raylib）：先写到同目录的临时文件，落盘后改名覆盖目标，
+// 进程崩溃或断电时目标文件要么是旧内容，要么是完整的新内容
+typedef struct {
+    FILE *file;                             // 写入这里，Commit 或 Abort 之后为 NULL
+    char path[ATOMIC_FILE_PATH_MAX];
+    char tempPath[ATOMIC_FILE_PATH_MAX + 8];
+} AtomicFile;
+
+bool BeginAtomicFile(AtomicFile *atomic, const char *path);
+bool CommitAtomicFile(AtomicFile *atomic);    // 写入出错时放弃并返回 false，目标文件不变
+void AbortAtomicFile(AtomicFile *atomic);
+
+bool SyncFile(FILE *file);                    // fflush 之后把内核缓冲区写入磁盘
+bool TruncateFile(FILE *file, long length);   // 截断到 length 字节
+
+#endif // ATOMIC_FILE_H
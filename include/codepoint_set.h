@@ -0,0 +1,39 @@
+#ifndef CODEPOINT_SET_H
+#define CODEPOINT_SET_H
+
+#include <stdbool.h>
+
+// 码点集合覆盖的上限（基本多文种平面）
+#define CODEPOINT_SET_LIMIT 0x10000
+
+// 闭区间码点范围
+typedef struct {
+    int first;
+    int last;
+} CodepointRange;
+
+// 位图实现的码点集合，不依赖 raylib
+typedef struct {
+    unsigned int bits[CODEPOINT_SET_LIMIT / 32];
+    int count;
+} CodepointSet;
+
+// 预定义的静态范围表
+extern const CodepointRange CODEPOINT_RANGES_ASCII[];     // 可打印 ASCII
+extern const int CODEPOINT_RANGES_ASCII_COUNT;
+extern const CodepointRange CODEPOINT_RANGES_CJK[];       // ASCII + 拉丁补充 + CJK 标点 + CJK 统一表意文字
+extern const int CODEPOINT_RANGES_CJK_COUNT;
+
+void ClearCodepointSet(CodepointSet *set);
+bool AddCodepoint(CodepointSet *set, int codepoint);   // 新加入时返回 true
+void AddCodepointRange(CodepointSet *set, int first, int last);
+void AddCodepointRanges(CodepointSet *set, const CodepointRange *ranges, int rangeCount);
+int AddCodepointsFromText(CodepointSet *set, const char *text, int length);  // 返回新加入的数量
+bool HasCodepoint(const CodepointSet *set, int codepoint);
+
+// 返回 >= from 的下一个码点，没有时返回 -1（按字跳过空白区段）
+int NextCodepoint(const CodepointSet *set, int from);
+// 按升序写入 out，返回写入数量
+int CodepointSetToArray(const CodepointSet *set, int *out, int maxCount);
+
+#endif // CODEPOINT_SET_H
@@ -2,8 +2,10 @@
 #define DATA_H
 
 #include "raylib.h"
+#include "session_history.h"
+#include "metrics.h"
 
-// 统计数据类型
+// 统计面板的数据：MetricsStore 的派生视图，由 BindStatisticsView 注册的监听器在指标变化时更新
 typedef struct {
     int totalPomodoros;
     int cleanedTrash;
@@ -14,12 +16,16 @@ typedef struct {
     int pomodoros25;
     int pomodoros45;
     int pomodorosCustom;
+    unsigned int version;   // 任一字段变化时递增，统计界面静态层据此判断是否重绘
 } Statistics;
 
 // 统计界面函数
 void InitStatistics(Statistics *stats);
-void DrawStatisticsScreen(Statistics *stats, Font font, bool isDarkTheme, float screenWidth, float screenHeight);
-void SaveStatistics(const Statistics *stats, const char *filename);
-void LoadStatistics(Statistics *stats, const char *filename);
+void BindStatisticsView(Statistics *stats, MetricsStore *metrics);
+void DrawStatisticsScreen(const Statistics *stats, const SessionHistory *history, Font *font, bool isDarkTheme, float screenWidth, float screenHeight);
+void UnloadStatisticsScreen(void);   // 释放统计界面的静态层
+
+// 迁移旧版本直接写出结构体的 statistics.dat，读到的计数写入 metrics
+void LoadStatistics(MetricsStore *metrics, const char *filename);
 
 #endif // DATA_H
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef DIGIT_ATLAS_H
+#define DIGIT_ATLAS_H
+
+#include "raylib.h"
+
+#define DIGIT_LABEL_MAX 10       // int 最多 10 位
+
+// 数字图集：0-9 按固定字号预先渲染到一张纹理，另含一块白色区域，
+// 方块、数字标签、进度条都用这张纹理，整屏垃圾在同一批次中绘制
+typedef struct {
+    Texture2D texture;
+    Rectangle digits[10];        // 各数字在图集中的区域
+    Rectangle whiteRect;         // 纯白区域，纯色矩形从这里采样
+    float fontSize;              // 渲染字号，绘制时按目标字号缩放
+    float spacing;
+    bool ready;
+} DigitAtlas;
+
+// 数字标签：创建时拆好各位数字并按图集字号算好宽度，绘制时不再格式化或测量
+typedef struct {
+    unsigned char digits[DIGIT_LABEL_MAX];
+    int digitCount;
+    float width;                 // 图集字号下的宽度，小于 0 表示尚未计算
+} DigitLabel;
+
+bool LoadDigitAtlas(DigitAtlas *atlas, Font font, float fontSize, float spacing);   // 需要在 InitWindow 之后调用
+void UnloadDigitAtlas(DigitAtlas *atlas);
+DigitLabel MakeDigitLabel(const DigitAtlas *atlas, int value);    // 负数按绝对值显示
+
+// 批次绘制：Begin 与 End 之间只能调用 PushDigit* 系列函数
+void BeginDigitBatch(const DigitAtlas *atlas);
+void PushDigitRect(const DigitAtlas *atlas, Rectangle dest, Color color);
+void PushDigitLabel(const DigitAtlas *atlas, const DigitLabel *label, Vector2 center, float fontSize, Color color);
+void EndDigitBatch(void);
+
+#endif // DIGIT_ATLAS_H
@@ -0,0 +1,18 @@
+#ifndef FILE_MAP_H
+#define FILE_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// 只读内存映射文件（不依赖 raylib，可在工具和多线程代码中使用）
+typedef struct {
+    const unsigned char *data;
+    size_t size;
+    void *fileHandle;      // Windows 文件句柄
+    void *mappingHandle;   // Windows 映射句柄
+} MappedFile;
+
+bool MapFile(MappedFile *map, const char *fileName);
+void UnmapFile(MappedFile *map);
+
+#endif // FILE_MAP_H
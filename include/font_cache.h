@@ -0,0 +1,84 @@
+#ifndef FONT_CACHE_H
+#define FONT_CACHE_H
+
+#include "raylib.h"
+#include "file_map.h"
+
+// 预烘焙字体图集文件（由构建期 font_baker 生成）
+// 布局: BakedFontHeader | BakedGlyph[glyphCount]（按码点升序） | 图集像素数据
+// 像素为 PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA，可直接上传为纹理
+#define BAKED_FONT_MAGIC "TMFA"
+#define BAKED_FONT_VERSION 1
+
+typedef struct {
+    char magic[4];
+    int version;
+    int baseSize;
+    int glyphPadding;
+    int glyphCount;
+    int atlasWidth;
+    int atlasHeight;
+    int atlasFormat;
+} BakedFontHeader;
+
+typedef struct {
+    int value;
+    int offsetX;
+    int offsetY;
+    int advanceX;
+    Rectangle rec;       // 图集中的字形区域（不含间距）
+} BakedGlyph;
+
+// 字形缓存统计信息
+typedef struct {
+    int glyphCount;              // 当前常驻字形数
+    int atlasWidth;              // 图集宽度
+    int atlasHeight;             // 图集高度
+    int atlasBytes;              // 图集占用显存（字节）
+    int rebuildCount;            // 图集扩容次数
+    unsigned long lookups;       // 字形查询次数
+    unsigned long misses;        // 未命中（需要光栅化）的次数
+    double loadTime;             // 初始加载耗时（秒）
+} FontCacheStats;
+
+// 字体加载任务：PrepareFontLoad 只做 CPU 工作（可在工作线程执行），FinishFontLoad 在主线程上传纹理
+typedef struct {
+    // 输入
+    const char *bakedFile;       // 预烘焙图集，可为 NULL
+    const char *fontFile;        // 原始字体文件：无可用烘焙图集时光栅化，否则作为运行时回退
+    int fontSize;                // 光栅化字号；为 0 时只接受预烘焙图集
+    const char *seedText;        // 光栅化时的初始字符集
+    // 输出
+    bool prepared;
+    bool fromBaked;
+    MappedFile baked;
+    unsigned char *fileData;
+    int fileSize;
+    GlyphInfo *glyphs;
+    Rectangle *recs;
+    int glyphCount;
+    int baseSize;
+    int glyphPadding;
+    Image atlas;                 // 来自烘焙图集时 data 指向映射区
+    double cpuTime;
+} FontLoadJob;
+
+bool PrepareFontLoad(FontLoadJob *job);
+bool FinishFontLoad(Font *font, FontLoadJob *job);   // 成功后所有权转移到 font
+void ReleaseFontLoad(FontLoadJob *job);              // 放弃未上传的任务
+
+// 按需加载字体：只光栅化 ASCII 与 seedText 中出现的字符，其余字符在首次绘制时补充
+bool LoadFontCached(Font *font, const char *fileName, int fontSize, const char *seedText);
+// 映射预烘焙图集并直接上传；烘焙集合之外的字符在首次出现时从 fallbackFile 光栅化
+bool LoadFontBaked(Font *font, const char *bakedFile, const char *fallbackFile);
+// 确保 text 中的全部字符已在图集中，缺失的字符会被光栅化并扩容图集
+void RequireFontGlyphs(Font *font, const char *text);
+void UnloadFontCached(Font *font);
+FontCacheStats GetFontCacheStats(const Font *font);
+void LogFontCacheStats(const Font *font, const char *name);
+
+// 带字形缓存与文本缓存的测量/绘制，任意字体均可使用（未通过 LoadFontCached 加载的字体不会补充字形）
+Vector2 MeasureTextCached(Font *font, const char *text, float fontSize, float spacing);
+void DrawTextCached(Font *font, const char *text, Vector2 position, float fontSize, float spacing, Color tint);
+
+#endif // FONT_CACHE_H
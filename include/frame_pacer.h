@@ -0,0 +1,37 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include "raylib.h"
+
+#define FRAME_PACER_POLL_INTERVAL (1.0/30.0)   // 等待定时唤醒期间轮询输入的间隔
+
+#define FRAME_TIME_BUCKETS 8
+
+// 帧统计
+typedef struct {
+    unsigned long framesRendered;
+    unsigned long framesSkipped;
+    unsigned long idleWaits;       // 阻塞等待输入事件的次数
+    // 连续动画帧的帧间隔分布，上界见 frame_pacer.c 中的 frameTimeBucketLimits（毫秒）
+    unsigned long frameTimeHistogram[FRAME_TIME_BUCKETS];
+} FramePacerStats;
+
+// 脏标记驱动的渲染循环：有输入、动画或定时重绘时才绘制，其余时间等待事件
+//
+//     BeginFramePacing();
+//     ...更新逻辑，按需调用 MarkFrameDirty / KeepFrameAnimating / ScheduleFrameAt...
+//     if (ShouldRenderFrame()) { BeginDrawing(); ... EndDrawing(); }
+//     else WaitForNextFrame();
+void InitFramePacer(void);
+void BeginFramePacing(void);           // 每次循环开始时调用，检测上一轮轮询到的输入
+float GetPacedFrameTime(void);         // 距上一轮 BeginFramePacing 的实际时间（含等待与跳过的帧），用于推进动画
+void MarkFrameDirty(void);             // 画面内容变化，本轮需要重绘
+void KeepFrameAnimating(void);         // 有动画进行中，本轮重绘并保持满帧率
+void KeepFrameAwake(void);             // 有后台工作需要主线程处理，不阻塞等待但不强制重绘
+void ScheduleFrameAt(double time);     // 在指定时间点唤醒并重绘（保留最早的一次）
+bool ShouldRenderFrame(void);
+void WaitForNextFrame(void);           // 跳过绘制：等待输入事件或下一次定时唤醒
+FramePacerStats GetFramePacerStats(void);
+void LogFramePacerStats(void);
+
+#endif // FRAME_PACER_H
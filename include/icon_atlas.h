@@ -0,0 +1,43 @@
+#ifndef ICON_ATLAS_H
+#define ICON_ATLAS_H
+
+#include "raylib.h"
+
+#define ICON_CELL_SIZE 100       // 图集中每个图标的尺寸（按钮绘制尺寸 50 的两倍）
+#define ICON_CELL_PADDING 4      // 图标间距，避免双线性过滤时相邻图标渗色
+
+// 界面图标
+typedef enum {
+    ICON_SUN,
+    ICON_MOON,
+    ICON_ACHIEVE_LIGHT,
+    ICON_ACHIEVE_DARK,
+    ICON_DATE_LIGHT,
+    ICON_DATE_DARK,
+    ICON_ACHIEVE,
+    ICON_COUNT
+} IconId;
+
+// 所有界面图标打包在一张纹理中，另含一块白色区域供形状绘制使用，
+// 使图标、矩形、圆形可以在同一批次中绘制
+typedef struct {
+    char files[ICON_COUNT][256]; // 输入：各图标文件路径
+    Texture2D texture;
+    Rectangle rects[ICON_COUNT]; // 各图标在图集中的区域
+    bool present[ICON_COUNT];    // 图标文件是否成功加载
+    Rectangle whiteRect;         // 纯白区域（SetShapesTexture 使用）
+    Image image;                 // PrepareIconAtlas 输出，上传后释放
+    bool shapesBound;            // 是否已替换形状纹理
+    Texture2D previousShapes;
+    Rectangle previousShapesRect;
+} IconAtlas;
+
+void SetIconSource(IconAtlas *atlas, IconId id, const char *fileName);
+bool PrepareIconAtlas(IconAtlas *atlas);   // CPU 工作：解码、缩放并拼入图集（可在工作线程执行）
+bool FinishIconAtlas(IconAtlas *atlas);    // 主线程：上传纹理并设为形状纹理
+void UnloadIconAtlas(IconAtlas *atlas);
+
+// 图标缺失时返回 false，由调用方绘制备用样式
+bool DrawIcon(const IconAtlas *atlas, IconId id, Rectangle dest, Color tint);
+
+#endif // ICON_ATLAS_H
@@ -0,0 +1,56 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdbool.h>
+#include "state_format.h"
+
+// 累计指标的唯一来源（不依赖 raylib）。事件只在这里修改计数，统计面板等派生视图
+// 通过监听器在值变化时增量更新，并各自带版本号，界面据此跳过没有变化的重绘
+typedef enum {
+    METRIC_TOTAL_POMODOROS,     // 完成的番茄钟
+    METRIC_CLEANED_TRASH,
+    METRIC_GENERATED_TRASH,
+    METRIC_INTERRUPTIONS,
+    METRIC_LONG_SESSIONS,       // 45 分钟番茄钟
+    METRIC_STREAK_DAYS,         // 当前连续天数
+    METRIC_POMODOROS_25,
+    METRIC_POMODOROS_45,
+    METRIC_POMODOROS_CUSTOM,
+    METRIC_CONSECUTIVE_POMODOROS, // 上次中断以来连续完成的番茄钟
+    METRIC_DAILY_POMODOROS,       // 今天完成的番茄钟
+    METRIC_BROKEN_STREAKS,        // 三天以上的连续天数被打断的次数
+    METRIC_TRASH_ALL_CLEANED,     // 1 表示所有类型的垃圾都清理过且没有剩余
+    METRIC_COUNT                // 存档按编号保存，新指标只能加在这里之前的末尾
+} MetricID;
+
+#define MAX_METRICS_LISTENERS 8
+
+typedef void (*MetricsListener)(MetricID id, int value, void *userData);
+
+typedef struct {
+    int values[METRIC_COUNT];
+    unsigned int version;          // 任一指标变化时递增
+    struct {
+        MetricsListener func;
+        void *userData;
+    } listeners[MAX_METRICS_LISTENERS];
+    int listenerCount;
+} MetricsStore;
+
+void InitMetricsStore(MetricsStore *metrics);
+void ResetMetrics(MetricsStore *metrics);           // 清零并通知，保留监听器
+bool AddMetricsListener(MetricsStore *metrics, MetricsListener func, void *userData);
+int GetMetric(const MetricsStore *metrics, MetricID id);
+void SetMetric(MetricsStore *metrics, MetricID id, int value);   // 值不变时不通知
+void AddMetric(MetricsStore *metrics, MetricID id, int delta);
+// 指标的文本名称，成就定义文件按名称引用指标；找不到时返回 METRIC_COUNT
+const char *GetMetricName(MetricID id);
+MetricID FindMetricByName(const char *name);
+
+// 存档为容器格式中的 "MTRC" 段: u32 指标数 | i32 值[指标数]，按 MetricID 顺序
+#define METRICS_SECTION_TAG STATE_TAG('M', 'T', 'R', 'C')
+#define METRICS_SECTION_VERSION 1
+void WriteMetricsSection(StateWriter *writer, const MetricsStore *metrics);
+bool ReadMetricsSection(const StateFile *file, MetricsStore *metrics);
+
+#endif // METRICS_H
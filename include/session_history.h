@@ -0,0 +1,85 @@
+#ifndef SESSION_HISTORY_H
+#define SESSION_HISTORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "state_format.h"
+
+// 每次计时的历史记录（不依赖 raylib）。记录按列存放，聚合查询不读记录本身，
+// 而是走按天的索引：每个有记录的日期一项，保存当天合计与截至当天的累计值，
+// 任意日期范围（周、月、年）的合计是两次二分查找加一次相减
+typedef enum {
+    SESSION_PRESET_25,
+    SESSION_PRESET_45,
+    SESSION_PRESET_CUSTOM,
+    SESSION_PRESET_NONE      // 清理垃圾的计时，时长由垃圾决定
+} SessionPreset;
+
+typedef enum {
+    SESSION_COMPLETED,
+    SESSION_INTERRUPTED,
+    SESSION_CLEANUP
+} SessionOutcome;
+
+typedef struct {
+    int64_t startTime;       // time_t
+    int32_t duration;        // 实际专注的秒数，中断时为中断前的时长
+    uint8_t preset;          // SessionPreset
+    uint8_t outcome;         // SessionOutcome
+    uint32_t trashId;        // 中断产生的垃圾，或清理的第一个垃圾；没有时为 0
+} SessionRecord;
+
+typedef struct {
+    int64_t focusSeconds;
+    int32_t sessions;
+    int32_t completed;
+    int32_t interrupted;
+    int32_t cleanups;
+} SessionTotals;
+
+typedef struct {
+    // 记录列
+    int count;
+    int capacity;
+    int64_t *startTimes;
+    int32_t *durations;
+    uint8_t *presets;
+    uint8_t *outcomes;
+    uint32_t *trashIds;
+
+    // 按天索引，days 升序（本地时区的日期序号，1970-01-01 为 0）
+    int dayCount;
+    int dayCapacity;
+    int32_t *days;
+    SessionTotals *dayTotals;
+    SessionTotals *dayPrefix;      // 从第一天到该天（含）的累计
+
+    unsigned int version;          // 每次修改递增，界面据此判断是否需要重绘
+} SessionHistory;
+
+void InitSessionHistory(SessionHistory *history);
+void FreeSessionHistory(SessionHistory *history);
+void ClearSessionHistory(SessionHistory *history);
+bool AppendSession(SessionHistory *history, const SessionRecord *record);
+SessionRecord GetSession(const SessionHistory *history, int index);
+
+// 日期换算（本地时区）
+int32_t GetSessionDay(int64_t time);
+int32_t GetSessionDayFromDate(int year, int month, int day);    // month 1-12
+void GetSessionDate(int32_t day, int *year, int *month, int *dayOfMonth);
+int GetSessionWeekday(int32_t day);                              // 0 为周一
+int32_t GetSessionWeekStart(int32_t day);                        // 所在周的周一
+int32_t GetSessionMonthStart(int32_t day);                       // 所在月的 1 日
+
+// 范围查询，firstDay 与 lastDay 都包含在内
+SessionTotals QuerySessionDays(const SessionHistory *history, int32_t firstDay, int32_t lastDay);
+void QuerySessionWeekdays(const SessionHistory *history, int32_t firstDay, int32_t lastDay, SessionTotals weekdays[7]);
+
+// 存档为容器格式中的 "HIST" 段: u32 记录数 | u32 保留 | i64 开始时间[n] | i32 时长[n] | u32 垃圾编号[n]
+//   | u8 预设[n] | u8 结果[n]，按列连续存放（宽的列在前，映射后各列自然对齐）；索引在加载时重建
+#define SESSION_SECTION_TAG STATE_TAG('H', 'I', 'S', 'T')
+#define SESSION_SECTION_VERSION 1
+void WriteSessionHistorySection(StateWriter *writer, const SessionHistory *history);
+bool ReadSessionHistorySection(const StateFile *file, SessionHistory *history);
+
+#endif // SESSION_HISTORY_H
@@ -0,0 +1,90 @@
+#ifndef STATE_FORMAT_H
+#define STATE_FORMAT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "file_map.h"
+
+// 存档容器格式（不依赖 raylib）。所有字段为定长小端，段数据 8 字节对齐，
+// 加载时把文件映射进内存，按段表偏移直接读取，不需要整体解析：
+//   文件头 32 字节: u32 魔数 "TMST" | u16 格式版本 | u16 可读取的最低版本 | u32 段数
+//                  | u32 段表校验和 | u64 文件长度 | u64 保留
+//   段表 段数 × 24 字节: u32 标签 | u32 段版本 | u64 偏移 | u32 长度 | u32 校验和
+//   段数据
+// 校验和为 FNV-1a。兼容规则：段内字段只在末尾追加，读取时忽略多出的字节，
+// 缺少的字段读出 0；不认识的段直接跳过。已有字段改变含义时提高段版本，
+// 只认识旧版本的代码会跳过该段，而不是读错
+#define STATE_FORMAT_MAGIC 0x54534D54u   // "TMST"
+#define STATE_FORMAT_VERSION 1
+#define STATE_MAX_SECTIONS 16
+
+#define STATE_TAG(a, b, c, d) ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+typedef struct {
+    uint32_t tag;
+    uint32_t version;
+    uint64_t offset;    // 相对段数据起点，写文件时换算为文件偏移
+    uint32_t size;
+} StateSectionInfo;
+
+// 在内存中组装段数据，SaveStateFile 一次原子写出
+typedef struct {
+    unsigned char *data;
+    size_t size;
+    size_t capacity;
+    StateSectionInfo sections[STATE_MAX_SECTIONS];
+    int sectionCount;
+    bool open;      // 正在写一个段
+    bool failed;    // 内存不足或段数超限，保存时放弃
+} StateWriter;
+
+void InitStateWriter(StateWriter *writer);
+void FreeStateWriter(StateWriter *writer);
+void BeginStateSection(StateWriter *writer, uint32_t tag, uint32_t version);
+void EndStateSection(StateWriter *writer);
+void WriteStateU8(StateWriter *writer, uint8_t value);
+void WriteStateU32(StateWriter *writer, uint32_t value);
+void WriteStateI32(StateWriter *writer, int32_t value);
+void WriteStateU64(StateWriter *writer, uint64_t value);
+void WriteStateI64(StateWriter *writer, int64_t value);
+void WriteStateF32(StateWriter *writer, float value);
+void WriteStateBytes(StateWriter *writer, const void *data, size_t size);
+bool SaveStateFile(StateWriter *writer, const char *path);   // 先写临时文件再改名
+
+typedef enum {
+    STATE_FILE_OK,
+    STATE_FILE_MISSING,
+    STATE_FILE_LEGACY,    // 不是容器格式，可能是旧版本直接写出的结构体
+    STATE_FILE_CORRUPT    // 头或段表损坏，或由更新的格式版本写出
+} StateFileResult;
+
+typedef struct {
+    MappedFile map;
+    uint32_t sectionCount;
+} StateFile;
+
+// 段数据的只读游标，指向映射内存；超出末尾的读取返回 0
+typedef struct {
+    const unsigned char *data;
+    uint32_t size;
+    uint32_t offset;
+    uint32_t version;
+} StateReader;
+
+StateFileResult OpenStateFile(StateFile *file, const char *path);
+void CloseStateFile(StateFile *file);
+// 按标签查找段，段版本不在 [minVersion, maxVersion] 或校验和不符时返回 false
+bool FindStateSection(const StateFile *file, uint32_t tag, uint32_t minVersion, uint32_t maxVersion, StateReader *reader);
+
+void InitStateReader(StateReader *reader, const void *data, uint32_t size);   // 读取容器之外的一段字节，如日志记录的负载
+uint8_t ReadStateU8(StateReader *reader);
+uint32_t ReadStateU32(StateReader *reader);
+int32_t ReadStateI32(StateReader *reader);
+uint64_t ReadStateU64(StateReader *reader);
+int64_t ReadStateI64(StateReader *reader);
+float ReadStateF32(StateReader *reader);
+const void *ReadStateBytes(StateReader *reader, uint32_t size);   // 原地返回，不足 size 时返回 NULL
+uint32_t GetStateReaderRemaining(const StateReader *reader);
+
+#endif // STATE_FORMAT_H
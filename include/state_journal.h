@@ -0,0 +1,48 @@
+#ifndef STATE_JOURNAL_H
+#define STATE_JOURNAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define JOURNAL_MAX_PAYLOAD 1024   // 单条记录负载上限，超过的记录视为损坏
+
+// 只追加的事件日志（不依赖 raylib）：主线程追加记录后立即返回，后台线程把积攒的记录
+// 一次写入并 fsync（多条记录共用一次落盘）。每条记录带序号与校验和，
+// 打开时回放快照之后的记录，写了一半的尾部被截掉。快照同样交给后台线程写出，
+// 写成后清空日志，主线程只负责把状态序列化到内存
+typedef struct {
+    uint64_t sequence;     // 从 1 开始单调递增，清空日志后继续递增
+    int64_t time;          // 事件发生时的 time_t，回放时按原时间计算
+    uint32_t type;         // 由调用方定义
+    uint32_t size;         // 负载字节数
+} JournalRecord;
+
+typedef struct {
+    unsigned long records;    // 本次运行追加的记录数
+    unsigned long batches;    // 写入并 fsync 的次数
+    unsigned long bytes;
+    unsigned long checkpoints;  // 写成快照并清空日志的次数
+    unsigned long replayed;   // 打开时回放的记录数
+    bool truncated;           // 打开时发现并截掉了损坏的尾部
+    bool failed;              // 写入或落盘失败过
+} JournalStats;
+
+typedef void (*JournalReplayFunc)(const JournalRecord *record, const void *payload, void *userData);
+// 在写线程中写出快照并释放 userData，返回快照是否已落盘
+typedef bool (*JournalCheckpointFunc)(void *userData);
+
+// 回放序号大于 afterSequence 的记录，然后打开日志准备追加（文件不存在时创建）
+bool OpenStateJournal(const char *path, uint64_t afterSequence, JournalReplayFunc replay, void *userData);
+void CloseStateJournal(void);           // 等待已追加的记录落盘后关闭
+uint64_t AppendJournalRecord(uint32_t type, int64_t time, const void *payload, uint32_t size);  // 返回序号，失败返回 0
+void FlushStateJournal(void);           // 阻塞直到已追加的记录全部落盘、进行中的快照写完
+// 提交快照：save 覆盖到当前序号为止的全部记录，由写线程在处理之后的记录之前执行，
+// 成功后清空日志（序号继续递增）。已有快照在进行时返回 false，userData 仍归调用方；
+// 日志未打开时在当前线程直接执行 save
+bool SubmitJournalCheckpoint(JournalCheckpointFunc save, void *userData);
+bool IsJournalCheckpointPending(void);  // 已提交的快照尚未写完；为真时提交会被拒绝，无需序列化状态
+uint64_t GetJournalSequence(void);      // 最近一条记录（含回放）的序号
+int GetJournalRecordCount(void);        // 日志中的记录数（上次清空以来）
+JournalStats GetStateJournalStats(void);
+
+#endif // STATE_JOURNAL_H
@@ -0,0 +1,40 @@
+#ifndef TEXT_CACHE_H
+#define TEXT_CACHE_H
+
+#include "raylib.h"
+
+// 预解码的单个字形
+typedef struct {
+    int index;           // font->glyphs 中的下标
+    bool visible;        // 空格、制表符只推进不绘制
+} TextGlyph;
+
+// 字符串的测量结果与可选的字形下标序列
+typedef struct {
+    float advance;       // 单行总推进宽度（字体原始单位，不含字间距）
+    int codepointCount;  // 字符数，用于计算字间距
+    bool multiline;      // 含换行的文本交给 raylib 处理
+    TextGlyph *glyphs;   // 首次绘制时才生成，仅测量的字符串不占用
+} TextRun;
+
+// 文本缓存统计
+typedef struct {
+    unsigned long hits;          // 命中次数
+    unsigned long misses;        // 未命中（需要解码字符串）的次数
+    unsigned long flushes;       // 整表清空次数（容量满或字体图集变化）
+    int entries;                 // 当前缓存的字符串数
+    int runs;                    // 已生成字形序列的字符串数
+} TextCacheStats;
+
+// 字体以 glyphs 数组地址和数量标识，图集追加字形后旧条目不再匹配
+int GetGlyphIndexCached(const Font *font, int codepoint);      // 哈希查找，未命中时与 raylib 一样回退到 '?'
+TextRun *FindTextRun(const Font *font, const char *text);       // 按字体与字符串内容查找，未缓存返回 NULL
+TextRun *CacheTextRun(const Font *font, const char *text);      // 解码并缓存，调用前应确保字形已在图集中
+Vector2 MeasureTextRun(const Font *font, const TextRun *run, const char *text, float fontSize, float spacing);
+void DrawTextRun(const Font *font, TextRun *run, const char *text, Vector2 position, float fontSize, float spacing, Color tint);
+void InvalidateTextCache(const Font *font);    // 字体的字形数组即将变化或释放时调用
+void ClearTextCache(void);
+TextCacheStats GetTextCacheStats(void);
+void LogTextCacheStats(void);
+
+#endif // TEXT_CACHE_H
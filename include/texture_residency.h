@@ -0,0 +1,29 @@
+#ifndef TEXTURE_RESIDENCY_H
+#define TEXTURE_RESIDENCY_H
+
+#include "raylib.h"
+
+#define DEFAULT_TEXTURE_IDLE_SECONDS 120.0
+
+// 纹理驻留统计
+typedef struct {
+    int registered;          // 已登记的纹理数
+    int resident;            // 当前驻留显存的纹理数
+    int residentBytes;       // 驻留纹理占用显存（字节）
+    int loads;               // 累计加载次数
+    int evictions;           // 累计因闲置被卸载的次数
+} TextureResidencyStats;
+
+// 按需驻留的纹理：首次请求时在工作线程解码并缩放到绘制尺寸，主线程上传，闲置超时后卸载
+void InitTextureResidency(double idleSeconds);
+int RegisterResidentTexture(const char *fileName, float drawScale);  // 返回槽位，失败返回 -1
+void RequestResidentTexture(int slot);              // 开始后台加载（预取），已驻留时只刷新使用时间
+void SetResidentTexturePinned(int slot, bool pinned);  // 固定的纹理不因闲置卸载，用于等待显示的预取
+bool AcquireResidentTexture(int slot, Texture2D *texture);  // 已驻留时返回按 drawScale 缩放后的纹理
+int UpdateTextureResidency(double budgetSeconds);   // 每帧调用：上传已解码图片并卸载闲置纹理，返回上传数量
+bool IsTextureResidencyBusy(void);                  // 是否有图片正在解码或等待上传
+double GetTextureEvictionTime(void);                // 最早一次闲置卸载的时间，没有驻留纹理时返回 -1
+TextureResidencyStats GetTextureResidencyStats(void);
+void ShutdownTextureResidency(void);
+
+#endif // TEXTURE_RESIDENCY_H
@@ -2,47 +2,37 @@
 #define TRASH_H
 
 #include "raylib.h"
+#include "trash_world.h"
 
-#define MAX_TRASH 20
-
-typedef struct {
-    Vector2 position;
-    Vector2 velocity;
-    Vector2 acceleration;
-    float scale;
-    float radius;       // 添加半径属性
-    bool active;
-    bool cleaning;
-    float cleanProgress;
-    int trashType;
-    int pomodoroDuration;
-    float bounceFactor;
-    float friction;
-} Trash;
-
-// 碰撞信息结构体
-typedef struct CollisionInfo {
-    bool collided;
-    Vector2 normal; // 碰撞法线（从a指向b）
-    float depth;    // 穿透深度
-} CollisionInfo;
-
-// 函数声明
-bool CheckCollisionTrash(Trash a, Trash b);
-CollisionInfo GetCollisionInfo(Trash a, Trash b);
-void ResolveCollision(Trash *a, Trash *b, CollisionInfo info);
+// 函数声明：以下函数都作用于进程内的默认垃圾世界
 void InitTrashSystem(void);
-void GenerateTrash(int duration);
-void UpdateTrash();
+TrashHandle GenerateTrash(int duration);   // 垃圾池按块扩容，没有数量上限
+void UpdateTrash(float deltaTime);         // deltaTime 取帧调度器测得的时间，跳过绘制的轮次也要计入
+void StepTrash(TrashStepInput input);      // UpdateTrash 的核心，不读取任何窗口状态
+void SetTrashBounds(int width, int height);  // 边界变化时唤醒所有垃圾；GenerateTrash 在边界内生成
 void DrawTrash(void);
-void CleanTrash(int index);
+void CleanTrash(TrashHandle handle);       // 播放清理进度条，结束后回收
+bool IsTrashHandleValid(TrashHandle handle);
+const Trash *GetTrash(TrashHandle handle); // 句柄失效时返回 NULL
+bool GetTrashDrawRect(TrashHandle handle, Rectangle *rect);  // 当前帧绘制的位置与大小
+int GetTrashCount(void);                   // 存活（含清理中）的垃圾数量
+TrashHandle FindTrashAt(Vector2 point);    // 命中的最上层未清理垃圾，没有时返回 TRASH_HANDLE_NONE
+int FindTrashInRect(Rectangle rect, TrashHandle *handles, int maxCount);  // 框选，返回命中总数
 void ResetTrashSystem(void);
+void FreeTrashSystem(void);                // 释放垃圾池内存
 void SaveTrashSystem(const char* filename);  // 新增：保存垃圾系统状态
 void LoadTrashSystem(const char* filename);  // 新增：加载垃圾系统状态
 void UpdateWindowAcceleration(Vector2 currentPos);
+bool IsTrashAnimating(void);  // 是否有垃圾仍在运动（或窗口正在移动），用于决定是否需要持续重绘
 bool IsAllTrashTypeCleaned(void);
-
-extern Trash trashes[MAX_TRASH];
-extern int trashCount;
+void SetTrashParallelPhysics(bool enabled);  // 垃圾数量较多时把物理步进分给工作线程
+bool IsTrashParallelPhysicsEnabled(void);
+void SetTrashPhysicsRate(int hz);          // 物理步频，速度衰减按步长换算，步频改变时手感不变
+void SetTrashInterpolation(bool enabled);  // 绘制时在最近两个物理步之间插值，低步频下画面仍然平滑
+bool IsTrashInterpolationEnabled(void);
+TrashStepStats GetTrashStepStats(void);
+void LogTrashStepStats(void);
+void ResetTrashStepStats(void);
+TrashWorld *GetTrashWorld(void);           // 默认世界，首次调用时创建
 
 #endif // TRASH_H
\ No newline at end of file
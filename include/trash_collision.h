@@ -0,0 +1,90 @@
+#ifndef TRASH_COLLISION_H
+#define TRASH_COLLISION_H
+
+#include "raylib.h"
+#include "trash_physics.h"
+
+// 碰撞信息结构体
+typedef struct CollisionInfo {
+    bool collided;
+    Vector2 normal; // 碰撞法线（从a指向b）
+    float depth;    // 穿透深度
+} CollisionInfo;
+
+// 候选碰撞对（下标 a < b）
+typedef struct {
+    int a;
+    int b;
+} TrashPair;
+
+typedef struct {
+    TrashPair *pairs;
+    int count;
+    int capacity;
+    unsigned long allocations;  // 扩容次数
+} TrashPairList;
+
+#define TRASH_PAIR_COLORS 64   // 图着色的颜色数（每个垃圾用一个 64 位掩码记录）
+
+// 均匀网格宽阶段：格子边长取最大直径，每个垃圾只与周围 3x3 格子内的垃圾配对
+// 格子坐标散列到按垃圾数量扩容的桶表，用计数排序把垃圾下标按桶连续存放
+typedef struct {
+    float cellSize;
+    int bucketCount;        // 2 的幂
+    int *bucketStart;       // [bucketCount + 1]，每个桶在 entries 中的起始位置
+    int *entries;           // 按桶排好的垃圾下标
+    int *bodyBucket;        // 每个垃圾所在的桶，-1 表示不参与碰撞
+    int *cellX;
+    int *cellY;
+    int bodyCapacity;
+    int gridBodies;                     // 建网格时的垃圾数，0 表示当前没有网格（垃圾太少时逐个检测）
+    TrashPairList pairList;             // 本次的候选对
+    // 并行路径
+    TrashPairList *chunkPairs;          // 每批垃圾各自的候选对
+    int chunkCapacity;
+    unsigned long long *bodyColors;     // 每个垃圾已占用的颜色
+    int colorBodyCapacity;
+    TrashPair *coloredPairs;            // 按颜色排好的候选对
+    unsigned char *pairColors;          // 每个候选对的颜色（排序前）
+    int coloredCapacity;
+    int colorStart[TRASH_PAIR_COLORS + 2];
+    // 睡眠
+    float sleepSpeed;                   // 低于该速度开始累计静止时间，0 表示不启用睡眠
+    float sleepDelay;                   // 整个接触岛静止这么久后一起入睡
+    int lastIsland;                     // 最近分配的岛编号
+    int *islandParent;                  // 并查集
+    int *islandLabel;
+    unsigned long allocations;          // 上面各缓冲区的扩容次数（不含候选对列表）
+} TrashBroadPhase;
+
+void InitTrashBroadPhase(TrashBroadPhase *broadPhase);
+void FreeTrashBroadPhase(TrashBroadPhase *broadPhase);
+void SetTrashSleepParams(TrashBroadPhase *broadPhase, float sleepSpeed, float sleepDelay);
+// 收集包围盒相交的候选对，顺序只取决于输入，返回数量
+int BuildTrashPairs(TrashBroadPhase *broadPhase, const TrashBodies *bodies);
+// 宽阶段 + 窄阶段，返回实际发生碰撞的对数
+int ResolveTrashCollisions(TrashBroadPhase *broadPhase, TrashBodies *bodies);
+// 多线程版本：候选对分批并行查询后按批次顺序合并，再按颜色分组并行解算；
+// 结果与线程数无关，但解算顺序与串行版本不同
+int ResolveTrashCollisionsParallel(TrashBroadPhase *broadPhase, TrashBodies *bodies);
+// 解算之后调用：按本步的接触关系划分岛，静止够久的岛整体入睡（mobility 置 0、速度清零），返回仍醒着的数量。
+// 睡眠的垃圾被速度超过 sleepSpeed 的醒着垃圾撞到时，解算前会整岛唤醒
+int UpdateTrashSleep(TrashBroadPhase *broadPhase, TrashBodies *bodies, float timeStep);
+
+// 用当前位置重建网格，供两次步进之间的查询使用；步进时会再次重建
+void BuildTrashGrid(TrashBroadPhase *broadPhase, const TrashBodies *bodies);
+// 网格查询：只返回参与碰撞的垃圾（清理中的不算），网格必须与 bodies 同步
+// 点查询返回圆内包含该点、下标最大（最后绘制、在最上层）的垃圾，没有时返回 -1
+int QueryTrashGridPoint(const TrashBroadPhase *broadPhase, const TrashBodies *bodies, Vector2 point);
+// 矩形查询按下标升序写入与矩形相交的垃圾，超过 maxCount 个时保留下标最小的 maxCount 个，
+// 返回命中总数（可能大于 maxCount）
+int QueryTrashGridRect(const TrashBroadPhase *broadPhase, const TrashBodies *bodies, Rectangle rect, int *indices, int maxCount);
+
+// 宽阶段所有缓冲区（含候选对列表）的扩容次数，稳定运行后应不再增长
+unsigned long GetTrashBroadPhaseAllocations(const TrashBroadPhase *broadPhase);
+
+// 窄阶段：按下标读写结构数组
+CollisionInfo GetTrashCollisionInfo(const TrashBodies *bodies, int a, int b);
+void ResolveTrashCollision(TrashBodies *bodies, int a, int b, CollisionInfo info);
+
+#endif // TRASH_COLLISION_H
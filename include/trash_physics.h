@@ -0,0 +1,52 @@
+#ifndef TRASH_PHYSICS_H
+#define TRASH_PHYSICS_H
+
+#include <stdbool.h>
+
+// 垃圾物理状态（结构数组）：积分、边界与碰撞每个子步都要遍历，只把热字段放在连续数组里，
+// 类型、时长、缩放、清理进度等冷字段留在 Trash 记录中。下标与垃圾池的紧密下标一致
+typedef struct {
+    float *positionX;
+    float *positionY;
+    float *previousX;        // 上一步开始时的位置，绘制时与当前位置插值
+    float *previousY;
+    float *velocityX;
+    float *velocityY;
+    float *radius;
+    float *inverseMass;      // 质量与半径成正比
+    float *bounceFactor;
+    float *friction;
+    float *mobility;         // 1 参与模拟，0 冻结（清理中或睡眠），积分核心用乘法代替分支
+    float *restTime;         // 速度持续低于睡眠阈值的时间
+    int *island;             // 0 醒着，>0 所在睡眠岛的编号
+    int count;
+    int capacity;
+} TrashBodies;
+
+// 积分参数：加速度已合并重力与窗口加速度
+typedef struct {
+    float accelerationX;
+    float accelerationY;
+    float damping;
+    float timeStep;
+} TrashIntegrator;
+
+bool ReserveTrashBodies(TrashBodies *bodies, int capacity);
+void FreeTrashBodies(TrashBodies *bodies);
+int PushTrashBody(TrashBodies *bodies, float x, float y, float vx, float vy, float radius, float bounceFactor, float friction);
+void RemoveTrashBody(TrashBodies *bodies, int index);   // 末尾元素移入空位，与垃圾池的交换删除保持一致
+
+// 速度与位置积分：SSE 可用时每次处理 4 个垃圾，否则走标量版本
+void IntegrateTrashBodies(TrashBodies *bodies, TrashIntegrator integrator);
+void IntegrateTrashBodiesScalar(TrashBodies *bodies, TrashIntegrator integrator);
+bool IsTrashSimdEnabled(void);
+// 窗口边界反弹与地面摩擦
+void ConstrainTrashBodies(TrashBodies *bodies, float width, float height, float timeStep);
+// 记录当前位置作为插值起点，每个物理步开始前调用
+void StoreTrashBodyPositions(TrashBodies *bodies);
+// 唤醒编号为 island 的睡眠岛，island <= 0 时唤醒全部；返回唤醒的数量
+int WakeTrashBodies(TrashBodies *bodies, int island);
+// 积分 + 边界，按批分给工作线程；每个垃圾只被一个线程读写，结果与串行版本逐位一致
+void StepTrashBodiesParallel(TrashBodies *bodies, TrashIntegrator integrator, float width, float height);
+
+#endif // TRASH_PHYSICS_H
@@ -0,0 +1,151 @@
+#ifndef TRASH_WORLD_H
+#define TRASH_WORLD_H
+
+#include "raylib.h"
+#include "digit_atlas.h"
+#include "trash_collision.h"
+#include "trash_physics.h"
+#include "state_format.h"
+
+#define TRASH_CHUNK_SIZE 64   // 垃圾池每次扩容的数量
+#define TRASH_MAX_SUBSTEPS 4  // 每帧最多追赶的物理步数，超出的时间直接丢弃
+
+typedef struct {
+    Vector2 position;
+    Vector2 velocity;
+    Vector2 acceleration;
+    float scale;
+    float radius;       // 添加半径属性
+    bool active;
+    bool cleaning;
+    float cleanProgress;
+    int trashType;
+    int pomodoroDuration;
+    float bounceFactor;
+    float friction;
+} Trash;
+
+// 垃圾句柄：槽位 + 代数，垃圾被回收后旧句柄失效，不会误指向复用槽位的新垃圾
+typedef struct {
+    int slot;
+    int generation;
+} TrashHandle;
+
+#define TRASH_HANDLE_NONE ((TrashHandle){ -1, 0 })
+
+// 物理步进统计
+typedef struct {
+    unsigned long substepFrames[TRASH_MAX_SUBSTEPS + 1];  // 按本帧执行的物理步数统计帧数
+    unsigned long clampedFrames;   // 积累时间超过上限被截断的帧数
+    double droppedTime;            // 截断丢弃的时间（秒）
+    unsigned long steps;           // 执行的物理步数
+    unsigned long bodySteps;       // 每步垃圾数之和
+    unsigned long pairsTested;     // 进入窄阶段的候选对
+    unsigned long contacts;
+    unsigned long allocations;     // 垃圾池与碰撞缓冲区的扩容次数
+} TrashStepStats;
+
+// 一次步进的外部输入：UpdateTrash 从窗口读取，无窗口的基准测试直接注入
+typedef struct {
+    float deltaTime;
+    int width;
+    int height;
+    Vector2 windowAcceleration;
+} TrashStepInput;
+
+typedef struct {
+    int dense;          // 在 items 中的位置，-1 表示空闲
+    int generation;     // 每次释放加一，使旧句柄失效
+    int nextFree;
+} TrashSlot;
+
+// 垃圾世界：一次模拟的全部状态，可以同时存在多个（例如预览面板、并行测试、基准程序）
+//
+// 存活的垃圾紧密存放在 items（冷字段）与 bodies（物理热字段）中，每帧只遍历这一段；
+// 句柄经槽位表间接寻址，删除时与末尾元素交换，槽位放回空闲链表复用。
+// 结构体公开，热循环可以直接遍历 bodies；增删垃圾必须通过下面的函数
+typedef struct {
+    Trash *items;                  // position/velocity 只在 GetWorldTrash、保存时从 bodies 同步
+    int *itemSlots;                // items[i] 所在的槽位
+    DigitLabel *labels;            // 时长标签，创建时拆好数字并算好宽度（不写入存档）
+    unsigned int *ids;             // 持久编号，跨存档不变，事件日志用它指代垃圾
+    unsigned int nextId;
+    TrashSlot *slots;
+    int capacity;
+    int count;
+    int freeSlot;
+    TrashBodies bodies;
+    TrashBroadPhase broadPhase;    // 碰撞宽阶段，缓冲区跨帧复用
+    bool gridStale;                // 网格建立后垃圾移动或增删过，查询前重建（全部入睡时一直可用）
+    int *queryIndices;             // 矩形查询的下标缓冲区
+    int queryCapacity;
+    unsigned int cleanedTypes;     // 清理过的垃圾类型位掩码（垃圾本身已回收）
+    int cleaningCount;
+
+    // 步进
+    int width;                     // 上次步进时的边界，变化时唤醒
+    int height;
+    Vector2 windowAcceleration;    // 上次步进的窗口加速度
+    float elapsedTime;
+    float timeStep;
+    bool interpolation;
+    float renderAlpha;             // 绘制位置 = 上一步位置 + (当前位置 - 上一步位置) * renderAlpha
+    bool parallel;
+    bool settled;                  // 全部入睡（或清理中）后跳过整个物理步进
+
+    TrashStepStats stats;
+    unsigned long broadPhaseAllocationBase;   // 重置统计时宽阶段已有的扩容次数
+} TrashWorld;
+
+TrashWorld *CreateTrashWorld(void);
+void DestroyTrashWorld(TrashWorld *world);
+void ClearTrashWorld(TrashWorld *world);       // 回收所有垃圾，保留缓冲区与已清理类型
+
+// 步进：时间、边界与窗口加速度全部由调用方注入，不读取任何窗口状态
+void SetTrashWorldBounds(TrashWorld *world, int width, int height);  // 边界变化时唤醒所有垃圾
+void StepTrashWorld(TrashWorld *world, TrashStepInput input);
+void DrawTrashWorld(TrashWorld *world, Vector2 offset);
+bool IsTrashWorldAnimating(const TrashWorld *world);
+
+// 增删与查询
+TrashHandle AddWorldTrash(TrashWorld *world, const Trash *trash);
+TrashHandle RestoreWorldTrash(TrashWorld *world, const Trash *trash, unsigned int id);  // 回放日志时沿用原编号
+void RemoveWorldTrash(TrashWorld *world, TrashHandle handle);    // 立即回收并计入已清理类型，不播放进度条
+TrashHandle GenerateWorldTrash(TrashWorld *world, int duration);  // 在当前边界内随机生成（GetRandomValue）
+void CleanWorldTrash(TrashWorld *world, TrashHandle handle);      // 播放清理进度条，结束后回收
+bool IsWorldTrashHandleValid(const TrashWorld *world, TrashHandle handle);
+const Trash *GetWorldTrash(TrashWorld *world, TrashHandle handle);  // 句柄失效时返回 NULL
+// 与 DrawTrashWorld 一致的方块（插值后的位置），用于给垃圾加高亮边框；句柄失效时返回 false
+bool GetWorldTrashDrawRect(const TrashWorld *world, TrashHandle handle, Rectangle *rect);
+unsigned int GetWorldTrashId(const TrashWorld *world, TrashHandle handle);  // 句柄失效时返回 0
+TrashHandle FindWorldTrashById(const TrashWorld *world, unsigned int id);
+// 空间查询复用碰撞网格：全部入睡时不需重建，运动中每帧最多重建一次；清理中的垃圾不会命中
+TrashHandle FindWorldTrashAt(TrashWorld *world, Vector2 point);   // 最上层（最后绘制）的垃圾
+int FindWorldTrashInRect(TrashWorld *world, Rectangle rect, TrashHandle *handles, int maxCount);  // 返回命中总数
+bool IsAllWorldTrashTypeCleaned(const TrashWorld *world);
+
+// 设置与统计
+void SetTrashWorldPhysicsRate(TrashWorld *world, int hz);
+void SetTrashWorldInterpolation(TrashWorld *world, bool enabled);
+void SetTrashWorldParallel(TrashWorld *world, bool enabled);
+TrashStepStats GetTrashWorldStats(const TrashWorld *world);
+void ResetTrashWorldStats(TrashWorld *world);
+
+// 存档为容器格式中的 "TRSH" 段: u32 已清理类型掩码 | u32 下一个编号 | u32 每条记录字节数 | u32 数量
+//   | 记录[数量]，每条: u32 编号 | f32 位置/速度/加速度 xy | f32 缩放、半径 | i32 类型、时长 | f32 弹性、摩擦
+// Load 也能读取旧版本直接写出 Trash 结构体的存档
+#define TRASH_SECTION_TAG STATE_TAG('T', 'R', 'S', 'H')
+#define TRASH_SECTION_VERSION 1
+#define TRASH_RECORD_SIZE 52
+// 单条记录（含编号）按上面的格式读写，事件日志记录新生成的垃圾时也用它
+void WriteTrashRecord(StateWriter *writer, unsigned int id, const Trash *trash);
+bool ReadTrashRecord(StateReader *reader, unsigned int *id, Trash *trash);   // 不足一条记录时返回 false
+void WriteTrashWorldSection(TrashWorld *world, StateWriter *writer);
+bool ReadTrashWorldSection(TrashWorld *world, const StateFile *file);
+bool SaveTrashWorld(TrashWorld *world, const char *filename);
+bool LoadTrashWorld(TrashWorld *world, const char *filename);
+
+// 数字图集在所有世界间共享，CloseWindow 之前释放
+void UnloadTrashWorldResources(void);
+
+#endif // TRASH_WORLD_H
@@ -0,0 +1,30 @@
+#ifndef UI_LAYER_H
+#define UI_LAYER_H
+
+#include "raylib.h"
+#include <stddef.h>
+
+#define UI_LAYER_HASH_SEED 14695981039346656037ULL
+
+// 静态界面层：界面中不随帧变化的部分（背景、面板、标题、数据文字）只在内容变化时
+// 绘制到 RenderTexture，其余帧直接贴图，再叠加悬停、垃圾、计时数字等动态内容
+typedef struct {
+    RenderTexture2D target;
+    int width;
+    int height;
+    unsigned long long key;    // 内容签名：主题、数据等，变化时重绘
+    bool valid;
+    unsigned long rebuilds;    // 重绘次数
+} UILayer;
+
+// 尺寸或签名变化时进入纹理模式并返回 true，调用方绘制静态内容后调用 EndUILayer
+bool BeginUILayer(UILayer *layer, int width, int height, unsigned long long key);
+void EndUILayer(UILayer *layer);
+void DrawUILayer(const UILayer *layer);
+void InvalidateUILayer(UILayer *layer);
+void UnloadUILayer(UILayer *layer);
+
+// FNV-1a，用于把界面依赖的数据合成签名
+unsigned long long HashUILayerData(unsigned long long hash, const void *data, size_t size);
+
+#endif // UI_LAYER_H
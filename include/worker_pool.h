@@ -0,0 +1,22 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <stdbool.h>
+
+// 后台任务函数
+typedef void (*WorkerJobFunc)(void *userData);
+// 并行循环的区间函数，处理 [begin, end)
+typedef void (*WorkerRangeFunc)(int begin, int end, void *userData);
+
+// 全局工作线程池（不依赖 raylib，任务中不能调用任何 GL 相关函数）
+bool InitWorkerPool(int threadCount);   // threadCount <= 0 时按 CPU 核数自动选择
+void ShutdownWorkerPool(void);          // 等待已提交的任务完成后退出线程
+bool SubmitWorkerJob(WorkerJobFunc func, void *userData);  // 线程池未启动时在当前线程直接执行并返回 false
+void WaitWorkerJobs(void);              // 阻塞直到所有已提交的任务完成
+int GetWorkerThreadCount(void);
+// 把 [0, count) 按 batchSize 分批交给工作线程与当前线程执行，全部完成后返回；
+// 只等待本次的批次，不受队列中其他后台任务影响
+void ParallelFor(int count, int batchSize, WorkerRangeFunc func, void *userData);
+int GetCpuCoreCount(void);
+
+#endif // WORKER_POOL_H
@@ -1,143 +1,420 @@
 #include "achievement.h"
+#include "session_history.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
-void InitAchievementManager(AchievementManager *manager) {
-    // 初始化统计变量
-    manager->totalPomodoros = 0;
-    manager->cleanedTrashCount = 0;
-    manager->generatedTrashCount = 0;
-    manager->interruptionsCount = 0;
-    
-    // 初始化正面成就列表
-    const char *positiveNames[ACH_COUNT] = {
-        "初尝专注", "小有所成", "渐入佳境", "专注大师",
-        "垃圾清理工", "环境卫士", "清洁专家",
-        "持久专注", "专注马拉松", "七日坚持",
-        "无懈可击", "自定义挑战", "清洁大师",
-        "完美一天", "晨型人", "夜猫子"
-    };
-    
-    const char *positiveDescriptions[ACH_COUNT] = {
-        "完成你的第一个番茄钟", "完成5个番茄钟", "完成10个番茄钟", "完成20个番茄钟",
-        "清理第一个垃圾", "清理5个垃圾", "清理10个垃圾",
-        "完成一个45分钟的番茄钟", "连续完成3个番茄钟", "连续7天每天完成至少一个番茄钟",
-        "完成一个番茄钟没有任何中断", "完成一个自定义时长的番茄钟", "清理所有类型的垃圾",
-        "一天内完成5个番茄钟", "在早上6-8点完成一个番茄钟", "在晚上10-12点完成一个番茄钟"
-    };
-    
-    for (int i = 0; i < ACH_COUNT; i++) {
-        manager->achievements[i].id = i;
-        strncpy(manager->achievements[i].name, positiveNames[i], sizeof(manager->achievements[i].name));
-        strncpy(manager->achievements[i].description, positiveDescriptions[i], sizeof(manager->achievements[i].description));
-        manager->achievements[i].unlocked = false;
-        manager->achievements[i].unlockTime = 0;
+// ===== 成就定义 =====
+
+// 内置定义，顺序与 AchievementID、NegativeAchievementID 一致
+static const AchievementDef builtinDefs[] = {
+    {"初尝专注", "完成你的第一个番茄钟", false, METRIC_TOTAL_POMODOROS, RULE_AT_LEAST, 1, 0, 0},
+    {"小有所成", "完成5个番茄钟", false, METRIC_TOTAL_POMODOROS, RULE_AT_LEAST, 5, 0, 0},
+    {"渐入佳境", "完成10个番茄钟", false, METRIC_TOTAL_POMODOROS, RULE_AT_LEAST, 10, 0, 0},
+    {"专注大师", "完成20个番茄钟", false, METRIC_TOTAL_POMODOROS, RULE_AT_LEAST, 20, 0, 0},
+    {"垃圾清理工", "清理第一个垃圾", false, METRIC_CLEANED_TRASH, RULE_AT_LEAST, 1, 0, 0},
+    {"环境卫士", "清理5个垃圾", false, METRIC_CLEANED_TRASH, RULE_AT_LEAST, 5, 0, 0},
+    {"清洁专家", "清理10个垃圾", false, METRIC_CLEANED_TRASH, RULE_AT_LEAST, 10, 0, 0},
+    {"持久专注", "完成一个45分钟的番茄钟", false, METRIC_LONG_SESSIONS, RULE_AT_LEAST, 1, 0, 0},
+    {"专注马拉松", "连续完成3个番茄钟", false, METRIC_CONSECUTIVE_POMODOROS, RULE_AT_LEAST, 3, 0, 0},
+    {"七日坚持", "连续7天每天完成至少一个番茄钟", false, METRIC_STREAK_DAYS, RULE_AT_LEAST, 7, 0, 0},
+    {"无懈可击", "完成一个番茄钟没有任何中断", false, METRIC_COUNT, RULE_AT_LEAST, 0, 0, 0},
+    {"自定义挑战", "完成一个自定义时长的番茄钟", false, METRIC_POMODOROS_CUSTOM, RULE_AT_LEAST, 1, 0, 0},
+    {"清洁大师", "清理所有类型的垃圾", false, METRIC_TRASH_ALL_CLEANED, RULE_EQUAL, 1, 0, 0},
+    {"完美一天", "一天内完成5个番茄钟", false, METRIC_DAILY_POMODOROS, RULE_AT_LEAST, 5, 0, 0},
+    {"晨型人", "在早上6-8点完成一个番茄钟", false, METRIC_TOTAL_POMODOROS, RULE_AT_LEAST, 1, 6, 8},
+    {"夜猫子", "在晚上10-12点完成一个番茄钟", false, METRIC_TOTAL_POMODOROS, RULE_AT_LEAST, 1, 22, 1},
+
+    {"首次分心", "中断专注1次", true, METRIC_INTERRUPTIONS, RULE_AT_LEAST, 1, 0, 0},
+    {"频频分心", "中断专注5次", true, METRIC_INTERRUPTIONS, RULE_AT_LEAST, 5, 0, 0},
+    {"分心成瘾", "中断专注10次", true, METRIC_INTERRUPTIONS, RULE_AT_LEAST, 10, 0, 0},
+    {"垃圾制造者", "产生1个垃圾", true, METRIC_GENERATED_TRASH, RULE_AT_LEAST, 1, 0, 0},
+    {"环境破坏者", "产生5个垃圾", true, METRIC_GENERATED_TRASH, RULE_AT_LEAST, 5, 0, 0},
+    {"垃圾大王", "产生10个垃圾", true, METRIC_GENERATED_TRASH, RULE_AT_LEAST, 10, 0, 0},
+    {"中断连胜", "中断连续专注天数", true, METRIC_BROKEN_STREAKS, RULE_AT_LEAST, 1, 0, 0}
+};
+
+static AchievementDef loadedDefs[MAX_ACHIEVEMENT_DEFS];
+static char *loadedText = NULL;    // 定义文件的内容，解析后作为名称与描述的字符串表保留
+static const AchievementDef *definitions = builtinDefs;
+static int definitionCount = (int)(sizeof(builtinDefs) / sizeof(builtinDefs[0]));
+
+// 定义编号与列表位置互查，初始化管理器时填写
+static unsigned short definitionSlots[MAX_ACHIEVEMENT_DEFS];
+static unsigned short positiveDefs[MAX_ACHIEVEMENT_DEFS];
+static unsigned short negativeDefs[MAX_ACHIEVEMENT_DEFS];
+
+int GetAchievementDefCount(void) {
+    return definitionCount;
+}
+
+const AchievementDef *GetAchievementDef(int index) {
+    if (index < 0 || index >= definitionCount) return NULL;
+    return &definitions[index];
+}
+
+int GetAchievementDefIndex(bool negative, int slot) {
+    return negative ? negativeDefs[slot] : positiveDefs[slot];
+}
+
+// 去掉首尾空白，原地修改
+static char *TrimField(char *text) {
+    while (*text == ' ' || *text == '\t') text++;
+    size_t length = strlen(text);
+    while (length > 0 && (text[length - 1] == ' ' || text[length - 1] == '\t' ||
+                          text[length - 1] == '\r' || text[length - 1] == '\n')) {
+        text[--length] = '\0';
     }
-    
-    // 初始化负面成就列表
-    const char *negativeNames[NEG_COUNT] = {
-        "首次分心", "频频分心", "分心成瘾",
-        "垃圾制造者", "环境破坏者", "垃圾大王",
-        "中断连胜"
-    };
-    
-    const char *negativeDescriptions[NEG_COUNT] = {
-        "中断专注1次", "中断专注5次", "中断专注10次",
-        "产生1个垃圾", "产生5个垃圾", "产生10个垃圾",
-        "中断连续专注天数"
-    };
-    
-    for (int i = 0; i < NEG_COUNT; i++) {
-        manager->negativeAchievements[i].id = i;
-        strncpy(manager->negativeAchievements[i].name, negativeNames[i], sizeof(manager->negativeAchievements[i].name));
-        strncpy(manager->negativeAchievements[i].description, negativeDescriptions[i], sizeof(manager->negativeAchievements[i].description));
-        manager->negativeAchievements[i].unlocked = false;
-        manager->negativeAchievements[i].unlockTime = 0;
+    return text;
+}
+
+static bool ParseAchievementDef(char *line, AchievementDef *def) {
+    char *fields[7] = {0};
+    int fieldCount = 0;
+    for (char *cursor = line; cursor != NULL && fieldCount < 7; fieldCount++) {
+        fields[fieldCount] = cursor;
+        cursor = strchr(cursor, '|');
+        if (cursor != NULL) *cursor++ = '\0';
+    }
+    if (fieldCount < 6) return false;
+    for (int i = 0; i < fieldCount; i++) fields[i] = TrimField(fields[i]);
+
+    memset(def, 0, sizeof(AchievementDef));
+    if (strcmp(fields[0], "+") == 0) {
+        def->negative = false;
+    } else if (strcmp(fields[0], "-") == 0) {
+        def->negative = true;
+    } else {
+        return false;
+    }
+    if (fields[1][0] == '\0') return false;
+    def->name = fields[1];
+    def->description = fields[2];
+
+    if (strcmp(fields[3], "none") == 0) {
+        def->metric = METRIC_COUNT;
+    } else {
+        def->metric = FindMetricByName(fields[3]);
+        if (def->metric == METRIC_COUNT) return false;
+    }
+
+    if (strcmp(fields[4], ">=") == 0) {
+        def->comparator = RULE_AT_LEAST;
+    } else if (strcmp(fields[4], "<=") == 0) {
+        def->comparator = RULE_AT_MOST;
+    } else if (strcmp(fields[4], "==") == 0) {
+        def->comparator = RULE_EQUAL;
+    } else {
+        return false;
+    }
+
+    char *end;
+    def->threshold = (int)strtol(fields[5], &end, 10);
+    if (end == fields[5] || *end != '\0') return false;
+
+    if (fieldCount > 6 && fields[6][0] != '\0') {
+        if (sscanf(fields[6], "%d-%d", &def->hourStart, &def->hourEnd) != 2) return false;
+        if (def->hourStart < 0 || def->hourStart > 23 || def->hourEnd < 0 || def->hourEnd > 24) return false;
+    }
+    return true;
+}
+
+// 整个文件读入内存后原地切分，名称与描述直接指向其中；
+// 任意一行无法解析或数量超限时整个文件不生效，避免存档中的位置错开
+bool LoadAchievementDefinitions(const char *filename) {
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL) return false;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *text = (size >= 0) ? (char*)malloc((size_t)size + 1) : NULL;
+    bool valid = text != NULL && fread(text, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+    if (!valid) {
+        free(text);
+        return false;
+    }
+    text[size] = '\0';
+
+    static AchievementDef parsed[MAX_ACHIEVEMENT_DEFS];
+    int count = 0;
+    for (char *line = text; valid && line != NULL;) {
+        char *next = strchr(line, '\n');
+        if (next != NULL) *next++ = '\0';
+
+        char *content = TrimField(line);
+        if (content[0] != '\0' && content[0] != '#') {
+            valid = count < MAX_ACHIEVEMENT_DEFS && ParseAchievementDef(content, &parsed[count]);
+            count++;
+        }
+        line = next;
     }
+    if (!valid || count == 0) {
+        free(text);
+        return false;
+    }
+
+    memcpy(loadedDefs, parsed, (size_t)count * sizeof(AchievementDef));
+    free(loadedText);
+    loadedText = text;
+    definitions = loadedDefs;
+    definitionCount = count;
+    return true;
+}
+
+// ===== 成就管理器 =====
+
+void InitAchievementManager(AchievementManager *manager) {
+    manager->achievementCount = 0;
+    manager->negativeCount = 0;
+    for (int i = 0; i < definitionCount; i++) {
+        if (definitions[i].negative) {
+            negativeDefs[manager->negativeCount] = (unsigned short)i;
+            definitionSlots[i] = (unsigned short)manager->negativeCount++;
+        } else {
+            positiveDefs[manager->achievementCount] = (unsigned short)i;
+            definitionSlots[i] = (unsigned short)manager->achievementCount++;
+        }
+    }
+
+    memset(manager->unlocked, 0, sizeof(manager->unlocked));
+    manager->unlockedCount = 0;
+    manager->unlockTimeCount = 0;
     
-    // 初始化统计信息
-    manager->totalPomodoros = 0;
-    manager->cleanedTrashCount = 0;
-    manager->generatedTrashCount = 0;
-    manager->interruptionsCount = 0;
-    manager->longSessionCount = 0;
+    // 初始化成就判断状态（累计计数在 MetricsStore 中）
     manager->currentStreak = 0;
     manager->lastPomodoroDate = 0;
-    manager->streakDays = 0;
     manager->consecutivePomodoros = 0;
     manager->dailyPomodoros = 0;
     manager->lastPomodoroDay = 0;
 
     // 初始化中断标记
     manager->interruptionOccurred = false;
+    manager->indexValid = false;
+    manager->version++;
 }
 
-void UnlockAchievement(AchievementManager *manager, AchievementID id) {
-    if (id < 0 || id >= ACH_COUNT) return;
-    
-    if (!manager->achievements[id].unlocked) {
-        manager->achievements[id].unlocked = true;
-        manager->achievements[id].unlockTime = time(NULL);
-        // 这里可以添加成就解锁时的特殊效果
+void FreeAchievementManager(AchievementManager *manager) {
+    free(manager->unlockTimes);
+    free(manager->ruleOrder);
+    manager->unlockTimes = NULL;
+    manager->unlockTimeCount = 0;
+    manager->unlockTimeCapacity = 0;
+    manager->ruleOrder = NULL;
+    manager->ruleCapacity = 0;
+    manager->indexValid = false;
+}
+
+bool IsAchievementUnlocked(const AchievementManager *manager, int def) {
+    if (def < 0 || def >= definitionCount) return false;
+    return (manager->unlocked[def / 64] >> (def % 64)) & 1u;
+}
+
+// 解锁时间表中第一个编号不小于 def 的位置
+static int FindUnlockTime(const AchievementManager *manager, int def) {
+    int low = 0;
+    int high = manager->unlockTimeCount;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (manager->unlockTimes[mid].def < def) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
     }
+    return low;
 }
 
-void UnlockNegativeAchievement(AchievementManager *manager, NegativeAchievementID id) {
-    if (id < 0 || id >= NEG_COUNT) return;
-    
-    if (!manager->negativeAchievements[id].unlocked) {
-        manager->negativeAchievements[id].unlocked = true;
-        manager->negativeAchievements[id].unlockTime = time(NULL);
-        // 这里可以添加负面成就解锁时的特殊效果
+time_t GetAchievementUnlockTime(const AchievementManager *manager, int def) {
+    int index = FindUnlockTime(manager, def);
+    if (index < manager->unlockTimeCount && manager->unlockTimes[index].def == def) {
+        return manager->unlockTimes[index].time;
     }
+    return 0;
 }
 
-void CheckAchievements(AchievementManager *manager, bool pomodoroCompleted, bool trashCleaned, int duration) {
-    // 将 nowTm 的声明移到函数开头
-    time_t now = time(NULL);
-    struct tm *nowTm = localtime(&now);
-    
-    // 修复连续天数统计
+// 置位并按编号插入解锁时间；解锁时间表扩容失败时只丢失时间，解锁状态仍然保留
+static void SetAchievementUnlocked(AchievementManager *manager, int def, time_t when) {
+    if (def < 0 || def >= definitionCount || IsAchievementUnlocked(manager, def)) return;
+
+    manager->unlocked[def / 64] |= 1ull << (def % 64);
+    manager->unlockedCount++;
+    manager->version++;
+
+    if (manager->unlockTimeCount == manager->unlockTimeCapacity) {
+        int capacity = (manager->unlockTimeCapacity > 0) ? manager->unlockTimeCapacity * 2 : 32;
+        AchievementUnlock *grown = (AchievementUnlock*)realloc(manager->unlockTimes, (size_t)capacity * sizeof(AchievementUnlock));
+        if (grown == NULL) return;
+        manager->unlockTimes = grown;
+        manager->unlockTimeCapacity = capacity;
+    }
+    int index = FindUnlockTime(manager, def);
+    memmove(&manager->unlockTimes[index + 1], &manager->unlockTimes[index],
+            (size_t)(manager->unlockTimeCount - index) * sizeof(AchievementUnlock));
+    manager->unlockTimes[index] = (AchievementUnlock){def, when};
+    manager->unlockTimeCount++;
+}
+
+static void MarkAchievementMetric(MetricID id, int value, void *userData) {
+    (void)value;
+    AchievementManager *manager = (AchievementManager*)userData;
+    manager->dirtyMetrics |= 1u << id;
+}
+
+void BindAchievementMetrics(AchievementManager *manager, MetricsStore *metrics) {
+    AddMetricsListener(metrics, MarkAchievementMetric, manager);
+}
+
+// 按指标分组排列尚未解锁的规则；内存不足时返回 false，下次判断时重试
+static bool BuildAchievementIndex(AchievementManager *manager) {
+    if (manager->ruleCapacity < definitionCount) {
+        unsigned short *grown = (unsigned short*)realloc(manager->ruleOrder, (size_t)definitionCount * sizeof(unsigned short));
+        if (grown == NULL) return false;
+        manager->ruleOrder = grown;
+        manager->ruleCapacity = definitionCount;
+    }
+
+    int counts[METRIC_COUNT] = {0};
+    for (int i = 0; i < definitionCount; i++) {
+        if (definitions[i].metric < METRIC_COUNT && !IsAchievementUnlocked(manager, i)) {
+            counts[definitions[i].metric]++;
+        }
+    }
+
+    int start = 0;
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        manager->metricStart[m] = (unsigned short)start;
+        manager->metricPending[m] = 0;
+        start += counts[m];
+    }
+    manager->metricStart[METRIC_COUNT] = (unsigned short)start;
+
+    for (int i = 0; i < definitionCount; i++) {
+        MetricID metric = definitions[i].metric;
+        if (metric >= METRIC_COUNT || IsAchievementUnlocked(manager, i)) continue;
+        manager->ruleOrder[manager->metricStart[metric] + manager->metricPending[metric]++] = (unsigned short)i;
+    }
+
+    manager->indexValid = true;
+    return true;
+}
+
+static bool MatchAchievementRule(const AchievementDef *def, int value) {
+    switch (def->comparator) {
+        case RULE_AT_LEAST: return value >= def->threshold;
+        case RULE_AT_MOST: return value <= def->threshold;
+        case RULE_EQUAL: return value == def->threshold;
+    }
+    return false;
+}
+
+static bool InHourWindow(const AchievementDef *def, int hour) {
+    if (def->hourStart == def->hourEnd) return true;
+    if (def->hourStart < def->hourEnd) return hour >= def->hourStart && hour < def->hourEnd;
+    return hour >= def->hourStart || hour < def->hourEnd;   // 跨午夜
+}
+
+// 只判断变化过的指标下尚未解锁的规则；解锁（或已被代码解锁）的规则与组内最后一项交换后移出。
+// 重建索引后补判所有指标，但带时间窗口的规则仍要求指标刚刚变化（例如在窗口内完成了番茄钟）
+static void EvaluateAchievementRules(AchievementManager *manager, const MetricsStore *metrics, time_t now) {
+    unsigned int changed = manager->dirtyMetrics;
+    unsigned int dirty = changed;
+    if (!manager->indexValid) {
+        if (!BuildAchievementIndex(manager)) return;
+        dirty = (1u << METRIC_COUNT) - 1;
+    }
+    manager->dirtyMetrics = 0;
+    int hour = -1;   // 只有带时间窗口的规则需要本地时间
+
+    for (int m = 0; dirty != 0; m++, dirty >>= 1) {
+        if (!(dirty & 1u) || m >= METRIC_COUNT) continue;
+
+        int value = GetMetric(metrics, (MetricID)m);
+        unsigned short *rules = &manager->ruleOrder[manager->metricStart[m]];
+        int pending = manager->metricPending[m];
+        for (int k = 0; k < pending;) {
+            const AchievementDef *def = &definitions[rules[k]];
+            bool unlocked = IsAchievementUnlocked(manager, rules[k]);
+            bool unlock = !unlocked && MatchAchievementRule(def, value);
+            if (unlock && def->hourStart != def->hourEnd) {
+                if (!(changed & (1u << m))) {
+                    unlock = false;
+                } else if (hour < 0) {
+                    struct tm *local = localtime(&now);
+                    hour = (local != NULL) ? local->tm_hour : 0;
+                }
+                if (unlock) unlock = InHourWindow(def, hour);
+            }
+            if (unlock) {
+                // 这里可以添加成就解锁时的特殊效果
+                SetAchievementUnlocked(manager, rules[k], now);
+                unlocked = true;
+            }
+
+            if (unlocked) {
+                unsigned short removed = rules[k];
+                rules[k] = rules[--pending];
+                rules[pending] = removed;
+            } else {
+                k++;
+            }
+        }
+        manager->metricPending[m] = (unsigned short)pending;
+    }
+}
+
+static void UnlockAchievementAt(AchievementManager *manager, AchievementID id, time_t when) {
+    if ((int)id < 0 || (int)id >= manager->achievementCount) return;
+    SetAchievementUnlocked(manager, positiveDefs[id], when);
+}
+
+static void UnlockNegativeAchievementAt(AchievementManager *manager, NegativeAchievementID id, time_t when) {
+    if ((int)id < 0 || (int)id >= manager->negativeCount) return;
+    SetAchievementUnlocked(manager, negativeDefs[id], when);
+}
+
+void UnlockAchievement(AchievementManager *manager, AchievementID id) {
+    UnlockAchievementAt(manager, id, time(NULL));
+}
+
+void UnlockNegativeAchievement(AchievementManager *manager, NegativeAchievementID id) {
+    UnlockNegativeAchievementAt(manager, id, time(NULL));
+}
+
+void CheckAchievements(AchievementManager *manager, MetricsStore *metrics, bool pomodoroCompleted) {
+    CheckAchievementsAt(manager, metrics, pomodoroCompleted, time(NULL));
+}
+
+// 先更新连续天数等按时间计算的状态（写入对应指标），再判断受影响的规则
+void CheckAchievementsAt(AchievementManager *manager, MetricsStore *metrics, bool pomodoroCompleted, time_t now) {
     if (pomodoroCompleted && !manager->interruptionOccurred) {
-        // 创建今天的0点时间
-        struct tm today_tm = *nowTm;
-        today_tm.tm_hour = 0;
-        today_tm.tm_min = 0;
-        today_tm.tm_sec = 0;
-        time_t today = mktime(&today_tm);
+        // 按本地日期序号比较，日期只保存当天任意时刻
+        int32_t today = GetSessionDay((int64_t)now);
         
         if (manager->lastPomodoroDate == 0) {
             manager->currentStreak = 1;
         } else {
-            // 将上次完成日期也转换为0点
-            struct tm *lastTm = localtime(&manager->lastPomodoroDate);
-            struct tm lastMidnight_tm = *lastTm;
-            lastMidnight_tm.tm_hour = 0;
-            lastMidnight_tm.tm_min = 0;
-            lastMidnight_tm.tm_sec = 0;
-            time_t lastMidnight = mktime(&lastMidnight_tm);
-            
-            double diff = difftime(today, lastMidnight) / (60 * 60 * 24);
-            
+            int32_t diff = today - GetSessionDay((int64_t)manager->lastPomodoroDate);
             if (diff == 1) { // 连续天
                 manager->currentStreak++;
             } else if (diff > 1) { // 中断
-                // 先检查是否需要解锁负面成就
+                // 先记录被打断的连续天数，对应负面成就
                 if (manager->currentStreak >= 3) {
-                    UnlockNegativeAchievement(manager, NEG_BROKEN_STREAK);
+                    AddMetric(metrics, METRIC_BROKEN_STREAKS, 1);
                 }
                 manager->currentStreak = 1; // 重置为1
             }
         }
-        manager->lastPomodoroDate = today;
-        manager->streakDays = manager->currentStreak;
+        manager->lastPomodoroDate = now;
+        SetMetric(metrics, METRIC_STREAK_DAYS, manager->currentStreak);
         
         // 更新每日番茄钟计数
-        if (manager->lastPomodoroDay != today) {
+        if (manager->lastPomodoroDay == 0 || GetSessionDay((int64_t)manager->lastPomodoroDay) != today) {
             manager->dailyPomodoros = 0;
-            manager->lastPomodoroDay = today;
         }
+        manager->lastPomodoroDay = now;
         manager->dailyPomodoros++;
         
         // 更新连续番茄钟计数
@@ -147,115 +424,189 @@ void CheckAchievements(AchievementManager *manager, bool pomodoroCompleted, bool
         manager->consecutivePomodoros = 0;
         manager->interruptionOccurred = false; // 重置中断标志
     }
+    SetMetric(metrics, METRIC_DAILY_POMODOROS, manager->dailyPomodoros);
+    SetMetric(metrics, METRIC_CONSECUTIVE_POMODOROS, manager->consecutivePomodoros);
 
-    // 检查时间相关成就（仅当完成番茄钟时）
-    if (pomodoroCompleted) {
-        if (nowTm->tm_hour >= 6 && nowTm->tm_hour < 8) {
-            UnlockAchievement(manager, ACH_EARLY_BIRD);
-        } else if (nowTm->tm_hour >= 22 || nowTm->tm_hour < 1) {
-            UnlockAchievement(manager, ACH_NIGHT_OWL);
+    EvaluateAchievementRules(manager, metrics, now);
+}
+
+#define NEGATIVE_SLOT_FLAG 0x80000000u   // 解锁时间表中负面成就位置的标记位
+
+static void WriteAchievementBits(StateWriter *writer, const AchievementManager *manager, bool negative, int count) {
+    for (int word = 0; word < (count + 63) / 64; word++) {
+        uint64_t bits = 0;
+        for (int bit = 0; bit < 64 && word * 64 + bit < count; bit++) {
+            if (IsAchievementUnlocked(manager, GetAchievementDefIndex(negative, word * 64 + bit))) bits |= 1ull << bit;
         }
+        WriteStateU64(writer, bits);
     }
+}
 
-    // ================ 检查正面成就解锁条件 ================
-    if (manager->totalPomodoros >= 1 && !manager->achievements[ACH_FIRST_POMODORO].unlocked) {
-        UnlockAchievement(manager, ACH_FIRST_POMODORO);
-    }
-    if (manager->totalPomodoros >= 5 && !manager->achievements[ACH_5_POMODOROS].unlocked) {
-        UnlockAchievement(manager, ACH_5_POMODOROS);
-    }
-    if (manager->totalPomodoros >= 10 && !manager->achievements[ACH_10_POMODOROS].unlocked) {
-        UnlockAchievement(manager, ACH_10_POMODOROS);
-    }
-    if (manager->totalPomodoros >= 20 && !manager->achievements[ACH_20_POMODOROS].unlocked) {
-        UnlockAchievement(manager, ACH_20_POMODOROS);
-    }
-    
-    if (manager->cleanedTrashCount >= 1 && !manager->achievements[ACH_CLEAN_1_TRASH].unlocked) {
-        UnlockAchievement(manager, ACH_CLEAN_1_TRASH);
-    }
-    if (manager->cleanedTrashCount >= 5 && !manager->achievements[ACH_CLEAN_5_TRASHES].unlocked) {
-        UnlockAchievement(manager, ACH_CLEAN_5_TRASHES);
-    }
-    if (manager->cleanedTrashCount >= 10 && !manager->achievements[ACH_CLEAN_10_TRASHES].unlocked) {
-        UnlockAchievement(manager, ACH_CLEAN_10_TRASHES);
-    }
-    
-    if (manager->longSessionCount >= 1 && !manager->achievements[ACH_LONG_SESSION].unlocked) {
-        UnlockAchievement(manager, ACH_LONG_SESSION);
-    }
-    
-    // 修复马拉松成就：使用连续完成的番茄钟数（consecutivePomodoros）
-    if (manager->consecutivePomodoros >= 3 && !manager->achievements[ACH_MARATHON].unlocked) {
-        UnlockAchievement(manager, ACH_MARATHON);
-    }
-    
-    if (manager->streakDays >= 7 && !manager->achievements[ACH_7_DAY_STREAK].unlocked) {
-        UnlockAchievement(manager, ACH_7_DAY_STREAK);
-    }
-    
-    // 添加完美一天成就（一天内完成5个番茄钟）
-    if (manager->dailyPomodoros >= 5 && !manager->achievements[ACH_PERFECT_DAY].unlocked) {
-        UnlockAchievement(manager, ACH_PERFECT_DAY);
-    }
-    
-    // 添加清洁大师成就（清理所有类型的垃圾）
-    // 注意：需要实现 IsAllTrashTypeCleaned 函数
-    if (IsAllTrashTypeCleaned() && !manager->achievements[ACH_CLEAN_MASTER].unlocked) {
-        UnlockAchievement(manager, ACH_CLEAN_MASTER);
+// 按位置读取，新版本追加的成就被忽略，旧版本缺少的成就保持未解锁；时间稍后由解锁时间表补上
+static void ReadAchievementBits(StateReader *reader, AchievementManager *manager, bool negative, uint32_t savedCount) {
+    int count = negative ? manager->negativeCount : manager->achievementCount;
+    for (uint32_t word = 0; word < (savedCount + 63) / 64; word++) {
+        uint64_t bits = ReadStateU64(reader);
+        for (int bit = 0; bit < 64; bit++) {
+            int slot = (int)(word * 64) + bit;
+            if (((bits >> bit) & 1u) && slot < count && (uint32_t)slot < savedCount) {
+                SetAchievementUnlocked(manager, GetAchievementDefIndex(negative, slot), 0);
+            }
+        }
     }
-    
-    // ================ 检查负面成就解锁条件 ================
-    if (manager->interruptionsCount >= 1 && !manager->negativeAchievements[NEG_1_INTERRUPTION].unlocked) {
-        UnlockNegativeAchievement(manager, NEG_1_INTERRUPTION);
+}
+
+void WriteAchievementSection(StateWriter *writer, const AchievementManager *manager) {
+    BeginStateSection(writer, ACHIEVEMENT_SECTION_TAG, ACHIEVEMENT_SECTION_VERSION);
+    WriteStateU32(writer, (uint32_t)manager->achievementCount);
+    WriteStateU32(writer, (uint32_t)manager->negativeCount);
+    WriteAchievementBits(writer, manager, false, manager->achievementCount);
+    WriteAchievementBits(writer, manager, true, manager->negativeCount);
+    WriteStateU32(writer, (uint32_t)manager->unlockTimeCount);
+    for (int i = 0; i < manager->unlockTimeCount; i++) {
+        int def = manager->unlockTimes[i].def;
+        uint32_t slot = definitionSlots[def];
+        WriteStateU32(writer, definitions[def].negative ? (slot | NEGATIVE_SLOT_FLAG) : slot);
+        WriteStateI64(writer, (int64_t)manager->unlockTimes[i].time);
     }
-    if (manager->interruptionsCount >= 5 && !manager->negativeAchievements[NEG_5_INTERRUPTIONS].unlocked) {
-        UnlockNegativeAchievement(manager, NEG_5_INTERRUPTIONS);
+    WriteStateI32(writer, manager->currentStreak);
+    WriteStateI64(writer, (int64_t)manager->lastPomodoroDate);
+    WriteStateU8(writer, manager->interruptionOccurred ? 1 : 0);
+    WriteStateI32(writer, manager->consecutivePomodoros);
+    WriteStateI32(writer, manager->dailyPomodoros);
+    WriteStateI64(writer, (int64_t)manager->lastPomodoroDay);
+    EndStateSection(writer);
+}
+
+// 名称与描述不存档，由 InitAchievementManager 提供
+bool ReadAchievementSection(const StateFile *file, AchievementManager *manager) {
+    StateReader reader;
+    if (!FindStateSection(file, ACHIEVEMENT_SECTION_TAG, ACHIEVEMENT_SECTION_VERSION, ACHIEVEMENT_SECTION_VERSION, &reader)) return false;
+
+    InitAchievementManager(manager);
+    uint32_t positiveCount = ReadStateU32(&reader);
+    uint32_t negativeCount = ReadStateU32(&reader);
+    ReadAchievementBits(&reader, manager, false, positiveCount);
+    ReadAchievementBits(&reader, manager, true, negativeCount);
+
+    // 读到的时间写回已置位的成就；位置超出当前列表的项被忽略
+    uint32_t timeCount = ReadStateU32(&reader);
+    for (uint32_t i = 0; i < timeCount; i++) {
+        uint32_t key = ReadStateU32(&reader);
+        time_t when = (time_t)ReadStateI64(&reader);
+        bool negative = (key & NEGATIVE_SLOT_FLAG) != 0;
+        int slot = (int)(key & ~NEGATIVE_SLOT_FLAG);
+        if (slot >= (negative ? manager->negativeCount : manager->achievementCount)) continue;
+
+        int def = GetAchievementDefIndex(negative, slot);
+        int index = FindUnlockTime(manager, def);
+        if (index < manager->unlockTimeCount && manager->unlockTimes[index].def == def) {
+            manager->unlockTimes[index].time = when;
+        }
     }
-    if (manager->interruptionsCount >= 10 && !manager->negativeAchievements[NEG_10_INTERRUPTIONS].unlocked) {
-        UnlockNegativeAchievement(manager, NEG_10_INTERRUPTIONS);
+
+    manager->currentStreak = ReadStateI32(&reader);
+    manager->lastPomodoroDate = (time_t)ReadStateI64(&reader);
+    manager->interruptionOccurred = ReadStateU8(&reader) != 0;
+    manager->consecutivePomodoros = ReadStateI32(&reader);
+    manager->dailyPomodoros = ReadStateI32(&reader);
+    manager->lastPomodoroDay = (time_t)ReadStateI64(&reader);
+    return true;
+}
+
+void SaveAchievements(const AchievementManager *manager, const char *filename) {
+    StateWriter writer;
+    InitStateWriter(&writer);
+    WriteAchievementSection(&writer, manager);
+    SaveStateFile(&writer, filename);
+    FreeStateWriter(&writer);
+}
+
+// 容器格式之前直接写出的 AchievementManager 结构体，每个成就带名称与描述，计数器还在成就管理器中
+typedef struct {
+    int id;
+    char name[50];
+    char description[100];
+    bool unlocked;
+    time_t unlockTime;
+} LegacyAchievement;
+
+typedef struct {
+    LegacyAchievement achievements[ACH_COUNT];
+    LegacyAchievement negativeAchievements[NEG_COUNT];
+    int totalPomodoros;
+    int cleanedTrashCount;
+    int generatedTrashCount;
+    int interruptionsCount;
+    int longSessionCount;
+    int currentStreak;
+    time_t lastPomodoroDate;
+    int streakDays;
+    bool interruptionOccurred;
+    int consecutivePomodoros;
+    int dailyPomodoros;
+    time_t lastPomodoroDay;
+} LegacyAchievementManager;
+
+// 长度一致且每个成就的编号等于下标才读取，名称与描述仍取当前版本的
+bool ReadLegacyAchievements(AchievementManager *manager, MetricsStore *metrics, const void *data, size_t size) {
+    if (size != sizeof(LegacyAchievementManager)) return false;
+    LegacyAchievementManager legacy;
+    memcpy(&legacy, data, sizeof(legacy));
+    for (int i = 0; i < ACH_COUNT; i++) {
+        if (legacy.achievements[i].id != i) return false;
     }
-    
-    if (manager->generatedTrashCount >= 1 && !manager->negativeAchievements[NEG_1_TRASH].unlocked) {
-        UnlockNegativeAchievement(manager, NEG_1_TRASH);
+    for (int i = 0; i < NEG_COUNT; i++) {
+        if (legacy.negativeAchievements[i].id != i) return false;
     }
-    if (manager->generatedTrashCount >= 5 && !manager->negativeAchievements[NEG_5_TRASHES].unlocked) {
-        UnlockNegativeAchievement(manager, NEG_5_TRASHES);
+
+    InitAchievementManager(manager);
+    for (int i = 0; i < ACH_COUNT && i < manager->achievementCount; i++) {
+        if (legacy.achievements[i].unlocked) {
+            SetAchievementUnlocked(manager, positiveDefs[i], legacy.achievements[i].unlockTime);
+        }
     }
-    if (manager->generatedTrashCount >= 10 && !manager->negativeAchievements[NEG_10_TRASHES].unlocked) {
-        UnlockNegativeAchievement(manager, NEG_10_TRASHES);
+    for (int i = 0; i < NEG_COUNT && i < manager->negativeCount; i++) {
+        if (legacy.negativeAchievements[i].unlocked) {
+            SetAchievementUnlocked(manager, negativeDefs[i], legacy.negativeAchievements[i].unlockTime);
+        }
     }
+    manager->currentStreak = legacy.currentStreak;
+    manager->lastPomodoroDate = legacy.lastPomodoroDate;
+    manager->interruptionOccurred = legacy.interruptionOccurred;
+    manager->consecutivePomodoros = legacy.consecutivePomodoros;
+    manager->dailyPomodoros = legacy.dailyPomodoros;
+    manager->lastPomodoroDay = legacy.lastPomodoroDay;
 
-    // 修复自定义成就检查：使用秒数比较
-    if (pomodoroCompleted && 
-        duration != 25*60 && 
-        duration != 45*60 && 
-        duration > 0 && 
-        !manager->achievements[ACH_CUSTOM_SESSION].unlocked) {
-        UnlockAchievement(manager, ACH_CUSTOM_SESSION);
-    }
+    SetMetric(metrics, METRIC_TOTAL_POMODOROS, legacy.totalPomodoros);
+    SetMetric(metrics, METRIC_CLEANED_TRASH, legacy.cleanedTrashCount);
+    SetMetric(metrics, METRIC_GENERATED_TRASH, legacy.generatedTrashCount);
+    SetMetric(metrics, METRIC_INTERRUPTIONS, legacy.interruptionsCount);
+    SetMetric(metrics, METRIC_LONG_SESSIONS, legacy.longSessionCount);
+    SetMetric(metrics, METRIC_STREAK_DAYS, legacy.streakDays);
+    return true;
 }
 
-void SaveAchievements(const AchievementManager *manager, const char *filename) {
-    FILE *file = fopen(filename, "wb");
-    if (file) {
-        fwrite(manager, sizeof(AchievementManager), 1, file);
-        fclose(file);
-    }
+static bool LoadLegacyAchievements(AchievementManager *manager, MetricsStore *metrics, const char *filename) {
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL) return false;
+
+    LegacyAchievementManager legacy;
+    bool loaded = fread(&legacy, sizeof(legacy), 1, file) == 1 && fgetc(file) == EOF;
+    fclose(file);
+    return loaded && ReadLegacyAchievements(manager, metrics, &legacy, sizeof(legacy));
 }
 
-void LoadAchievements(AchievementManager *manager, const char *filename) {
-    FILE *file = fopen(filename, "rb");
-    if (file) {
-        fread(manager, sizeof(AchievementManager), 1, file);
-        // 兼容性检查 - 如果加载的数据结构不匹配，重新初始化
-        if (manager->achievements[0].id != 0 || manager->negativeAchievements[0].id != 0) {
-            // 检查版本兼容性，这里可以添加版本检查逻辑
-            InitAchievementManager(manager);
-        }
-        fclose(file);
-    } else {
-        InitAchievementManager(manager);
+void LoadAchievements(AchievementManager *manager, MetricsStore *metrics, const char *filename) {
+    InitAchievementManager(manager);
+
+    StateFile file;
+    StateFileResult result = OpenStateFile(&file, filename);
+    if (result == STATE_FILE_OK) {
+        ReadAchievementSection(&file, manager);
+        CloseStateFile(&file);
+    } else if (result == STATE_FILE_LEGACY) {
+        LoadLegacyAchievements(manager, metrics, filename);
     }
 }
 
@@ -0,0 +1,219 @@
+#include "asset_loader.h"
+#include "worker_pool.h"
+#include <stdatomic.h>
+#include <string.h>
+
+#define MAX_ASSET_REQUESTS 32
+#define FONT_PROGRESS_WEIGHT 4.0f   // 字体光栅化远慢于图片解码，进度条中按更高权重计
+
+typedef enum {
+    ASSET_TEXTURE,
+    ASSET_FONT,
+    ASSET_ICON_ATLAS
+} AssetType;
+
+typedef enum {
+    ASSET_QUEUED,      // 等待提交
+    ASSET_DECODING,    // 工作线程处理中
+    ASSET_DECODED,     // CPU 数据就绪，等待上传
+    ASSET_READY,       // 已上传
+    ASSET_FAILED
+} AssetStatus;
+
+typedef struct {
+    AssetType type;
+    char fileName[256];
+    bool essential;
+    bool bilinear;
+    atomic_int status;
+
+    Texture2D *texture;    // ASSET_TEXTURE
+    Image image;
+
+    Font *font;            // ASSET_FONT
+    FontLoadJob fontJob;
+
+    IconAtlas *iconAtlas;  // ASSET_ICON_ATLAS
+} AssetRequest;
+
+static AssetRequest assetRequests[MAX_ASSET_REQUESTS];
+static int assetRequestCount = 0;
+
+// 工作线程：只做文件读取、解码与光栅化
+static void DecodeAssetJob(void *userData) {
+    AssetRequest *request = (AssetRequest *)userData;
+    bool success = false;
+
+    if (request->type == ASSET_TEXTURE) {
+        request->image = LoadImage(request->fileName);
+        success = request->image.data != NULL;
+    } else if (request->type == ASSET_FONT) {
+        success = PrepareFontLoad(&request->fontJob);
+    } else {
+        success = PrepareIconAtlas(request->iconAtlas);
+    }
+
+    atomic_store(&request->status, success ? ASSET_DECODED : ASSET_FAILED);
+}
+
+static float GetAssetWeight(const AssetRequest *request) {
+    return (request->type == ASSET_FONT) ? FONT_PROGRESS_WEIGHT : 1.0f;
+}
+
+void InitAssetLoader(void) {
+    memset(assetRequests, 0, sizeof(assetRequests));
+    assetRequestCount = 0;
+    InitWorkerPool(0);
+}
+
+void QueueTextureAsset(Texture2D *target, const char *fileName, bool essential, bool bilinear) {
+    if (assetRequestCount >= MAX_ASSET_REQUESTS) return;
+
+    AssetRequest *request = &assetRequests[assetRequestCount++];
+    request->type = ASSET_TEXTURE;
+    strncpy(request->fileName, fileName, sizeof(request->fileName) - 1);
+    request->essential = essential;
+    request->bilinear = bilinear;
+    request->texture = target;
+
+    if (FileExists(fileName)) {
+        atomic_store(&request->status, ASSET_QUEUED);
+    } else {
+        TraceLog(LOG_WARNING, "图片文件未找到: %s", fileName);
+        atomic_store(&request->status, ASSET_FAILED);
+    }
+}
+
+void QueueFontAsset(Font *target, FontLoadJob job, bool essential) {
+    if (assetRequestCount >= MAX_ASSET_REQUESTS) return;
+
+    AssetRequest *request = &assetRequests[assetRequestCount++];
+    request->type = ASSET_FONT;
+    strncpy(request->fileName, job.bakedFile != NULL ? job.bakedFile : (job.fontFile != NULL ? job.fontFile : ""),
+            sizeof(request->fileName) - 1);
+    request->essential = essential;
+    request->font = target;
+    request->fontJob = job;
+    atomic_store(&request->status, ASSET_QUEUED);
+}
+
+void QueueIconAtlasAsset(IconAtlas *target, bool essential) {
+    if (assetRequestCount >= MAX_ASSET_REQUESTS) return;
+
+    AssetRequest *request = &assetRequests[assetRequestCount++];
+    request->type = ASSET_ICON_ATLAS;
+    strncpy(request->fileName, "icon atlas", sizeof(request->fileName) - 1);
+    request->essential = essential;
+    request->iconAtlas = target;
+    atomic_store(&request->status, ASSET_QUEUED);
+}
+
+void StartAssetLoading(void) {
+    // 主界面资源优先提交
+    for (int pass = 0; pass < 2; pass++) {
+        bool essential = (pass == 0);
+        for (int i = 0; i < assetRequestCount; i++) {
+            AssetRequest *request = &assetRequests[i];
+            if (request->essential != essential || atomic_load(&request->status) != ASSET_QUEUED) continue;
+
+            atomic_store(&request->status, ASSET_DECODING);
+            SubmitWorkerJob(DecodeAssetJob, request);
+        }
+    }
+}
+
+int PumpAssetLoader(double budgetSeconds) {
+    double startTime = GetTime();
+    int uploaded = 0;
+
+    for (int pass = 0; pass < 2; pass++) {
+        bool essential = (pass == 0);
+        for (int i = 0; i < assetRequestCount; i++) {
+            if (uploaded > 0 && GetTime() - startTime >= budgetSeconds) return uploaded;
+
+            AssetRequest *request = &assetRequests[i];
+            if (request->essential != essential || atomic_load(&request->status) != ASSET_DECODED) continue;
+
+            bool success = false;
+            if (request->type == ASSET_TEXTURE) {
+                *request->texture = LoadTextureFromImage(request->image);
+                UnloadImage(request->image);
+                request->image = (Image){0};
+                success = request->texture->id != 0;
+                if (success && request->bilinear) {
+                    SetTextureFilter(*request->texture, TEXTURE_FILTER_BILINEAR);
+                }
+            } else if (request->type == ASSET_FONT) {
+                success = FinishFontLoad(request->font, &request->fontJob);
+            } else {
+                success = FinishIconAtlas(request->iconAtlas);
+            }
+
+            if (!success) {
+                TraceLog(LOG_WARNING, "资源加载失败: %s", request->fileName);
+            }
+            atomic_store(&request->status, success ? ASSET_READY : ASSET_FAILED);
+            uploaded++;
+        }
+    }
+
+    return uploaded;
+}
+
+float GetAssetLoadProgress(bool essentialOnly) {
+    float total = 0.0f;
+    float done = 0.0f;
+
+    for (int i = 0; i < assetRequestCount; i++) {
+        const AssetRequest *request = &assetRequests[i];
+        if (essentialOnly && !request->essential) continue;
+
+        float weight = GetAssetWeight(request);
+        int status = atomic_load(&request->status);
+        total += weight;
+        if (status == ASSET_READY || status == ASSET_FAILED) {
+            done += weight;
+        } else if (status == ASSET_DECODED) {
+            done += weight * 0.9f;  // 只差上传
+        }
+    }
+
+    return (total > 0.0f) ? done / total : 1.0f;
+}
+
+static bool AreAssetsSettled(bool essentialOnly) {
+    for (int i = 0; i < assetRequestCount; i++) {
+        if (essentialOnly && !assetRequests[i].essential) continue;
+
+        int status = atomic_load(&assetRequests[i].status);
+        if (status != ASSET_READY && status != ASSET_FAILED) return false;
+    }
+    return true;
+}
+
+bool AreEssentialAssetsReady(void) {
+    return AreAssetsSettled(true);
+}
+
+bool IsAssetLoadingComplete(void) {
+    return AreAssetsSettled(false);
+}
+
+void ShutdownAssetLoader(void) {
+    WaitWorkerJobs();
+
+    for (int i = 0; i < assetRequestCount; i++) {
+        AssetRequest *request = &assetRequests[i];
+        if (atomic_load(&request->status) != ASSET_DECODED) continue;
+
+        if (request->type == ASSET_TEXTURE) {
+            UnloadImage(request->image);
+        } else if (request->type == ASSET_FONT) {
+            ReleaseFontLoad(&request->fontJob);
+        } else {
+            UnloadIconAtlas(request->iconAtlas);
+        }
+        atomic_store(&request->status, ASSET_FAILED);
+    }
+    assetRequestCount = 0;
+}
@@ -0,0 +1,100 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE 200809L   // fileno、fsync、ftruncate 在严格 C11 下需要
+#endif
+
+#include "atomic_file.h"
+#include <string.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+bool SyncFile(FILE *file) {
+    if (fflush(file) != 0) return false;
+#if defined(_WIN32)
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool TruncateFile(FILE *file, long length) {
+    if (fflush(file) != 0) return false;
+#if defined(_WIN32)
+    return _chsize_s(_fileno(file), length) == 0;
+#else
+    return ftruncate(fileno(file), (off_t)length) == 0;
+#endif
+}
+
+#if !defined(_WIN32)
+// 改名只有在目录项落盘后才算持久，否则断电后可能回到旧文件
+static void SyncParentDirectory(const char *path) {
+    char directory[ATOMIC_FILE_PATH_MAX];
+    const char *slash = strrchr(path, '/');
+    if (slash == NULL) {
+        strcpy(directory, ".");
+    } else {
+        size_t length = (size_t)(slash - path);
+        if (length == 0) length = 1;   // 根目录
+        memcpy(directory, path, length);
+        directory[length] = '\0';
+    }
+
+    int fd = open(directory, O_RDONLY);
+    if (fd < 0) return;
+    fsync(fd);
+    close(fd);
+}
+#endif
+
+bool BeginAtomicFile(AtomicFile *atomic, const char *path) {
+    memset(atomic, 0, sizeof(AtomicFile));
+    size_t length = strlen(path);
+    if (length == 0 || length >= ATOMIC_FILE_PATH_MAX) return false;
+
+    memcpy(atomic->path, path, length + 1);
+    memcpy(atomic->tempPath, path, length);
+    memcpy(atomic->tempPath + length, ".tmp", 5);
+
+    atomic->file = fopen(atomic->tempPath, "wb");
+    return atomic->file != NULL;
+}
+
+bool CommitAtomicFile(AtomicFile *atomic) {
+    if (atomic->file == NULL) return false;
+
+    bool written = !ferror(atomic->file) && SyncFile(atomic->file);
+    written = (fclose(atomic->file) == 0) && written;
+    atomic->file = NULL;
+    if (!written) {
+        remove(atomic->tempPath);
+        return false;
+    }
+
+#if defined(_WIN32)
+    if (!MoveFileExA(atomic->tempPath, atomic->path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        remove(atomic->tempPath);
+        return false;
+    }
+#else
+    if (rename(atomic->tempPath, atomic->path) != 0) {
+        remove(atomic->tempPath);
+        return false;
+    }
+    SyncParentDirectory(atomic->path);
+#endif
+    return true;
+}
+
+void AbortAtomicFile(AtomicFile *atomic) {
+    if (atomic->file == NULL) return;
+    fclose(atomic->file);
+    atomic->file = NULL;
+    remove(atomic->tempPath);
+}
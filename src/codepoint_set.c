@@ -0,0 +1,143 @@
+#include "codepoint_set.h"
+#include <string.h>
+
+const CodepointRange CODEPOINT_RANGES_ASCII[] = {
+    { 0x0020, 0x007E }
+};
+const int CODEPOINT_RANGES_ASCII_COUNT = sizeof(CODEPOINT_RANGES_ASCII) / sizeof(CODEPOINT_RANGES_ASCII[0]);
+
+const CodepointRange CODEPOINT_RANGES_CJK[] = {
+    { 0x0020, 0x007E },   // 基本 Latin 字符（ASCII）
+    { 0x00A0, 0x00FF },   // 拉丁补充
+    { 0x3000, 0x303F },   // CJK 符号和标点
+    { 0x4E00, 0x9FFF }    // CJK 统一表意文字块
+};
+const int CODEPOINT_RANGES_CJK_COUNT = sizeof(CODEPOINT_RANGES_CJK) / sizeof(CODEPOINT_RANGES_CJK[0]);
+
+static int CountBits(unsigned int word) {
+    int count = 0;
+    while (word != 0) {
+        word &= word - 1;
+        count++;
+    }
+    return count;
+}
+
+static int LowestBit(unsigned int word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(word);
+#else
+    int index = 0;
+    while ((word & 1u) == 0) {
+        word >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+// 解码一个 UTF-8 字符，非法序列按单字节跳过并返回 -1
+static int DecodeUtf8(const unsigned char *text, int length, int *size) {
+    unsigned char c = text[0];
+    *size = 1;
+    if (c < 0x80) return c;
+
+    int extra = (c >= 0xF0) ? 3 : (c >= 0xE0) ? 2 : (c >= 0xC0) ? 1 : -1;
+    if (extra < 0 || extra >= length) return -1;
+
+    int codepoint = c & (0x3F >> extra);
+    for (int i = 1; i <= extra; i++) {
+        if ((text[i] & 0xC0) != 0x80) return -1;
+        codepoint = (codepoint << 6) | (text[i] & 0x3F);
+    }
+    *size = extra + 1;
+    return codepoint;
+}
+
+void ClearCodepointSet(CodepointSet *set) {
+    memset(set, 0, sizeof(CodepointSet));
+}
+
+bool AddCodepoint(CodepointSet *set, int codepoint) {
+    if (codepoint < 0 || codepoint >= CODEPOINT_SET_LIMIT) return false;
+
+    unsigned int mask = 1u << (codepoint & 31);
+    unsigned int *word = &set->bits[codepoint >> 5];
+    if (*word & mask) return false;
+
+    *word |= mask;
+    set->count++;
+    return true;
+}
+
+void AddCodepointRange(CodepointSet *set, int first, int last) {
+    if (first < 0) first = 0;
+    if (last >= CODEPOINT_SET_LIMIT) last = CODEPOINT_SET_LIMIT - 1;
+    if (first > last) return;
+
+    // 首尾不完整的字逐位处理，中间整字直接填满
+    while (first <= last && (first & 31) != 0) AddCodepoint(set, first++);
+    while (first + 31 <= last) {
+        unsigned int *word = &set->bits[first >> 5];
+        set->count += 32 - CountBits(*word);
+        *word = 0xFFFFFFFFu;
+        first += 32;
+    }
+    while (first <= last) AddCodepoint(set, first++);
+}
+
+void AddCodepointRanges(CodepointSet *set, const CodepointRange *ranges, int rangeCount) {
+    for (int i = 0; i < rangeCount; i++) {
+        AddCodepointRange(set, ranges[i].first, ranges[i].last);
+    }
+}
+
+int AddCodepointsFromText(CodepointSet *set, const char *text, int length) {
+    const unsigned char *bytes = (const unsigned char *)text;
+    int added = 0;
+    int offset = 0;
+
+    while (offset < length) {
+        int size = 1;
+        int codepoint = DecodeUtf8(&bytes[offset], length - offset, &size);
+        if (codepoint >= 0x20 && AddCodepoint(set, codepoint)) added++;
+        offset += size;
+    }
+
+    return added;
+}
+
+bool HasCodepoint(const CodepointSet *set, int codepoint) {
+    if (codepoint < 0 || codepoint >= CODEPOINT_SET_LIMIT) return false;
+    return (set->bits[codepoint >> 5] & (1u << (codepoint & 31))) != 0;
+}
+
+int NextCodepoint(const CodepointSet *set, int from) {
+    if (from < 0) from = 0;
+    if (from >= CODEPOINT_SET_LIMIT) return -1;
+
+    int index = from >> 5;
+    unsigned int word = set->bits[index] & (0xFFFFFFFFu << (from & 31));
+    while (word == 0) {
+        if (++index >= CODEPOINT_SET_LIMIT / 32) return -1;
+        word = set->bits[index];
+    }
+    return (index << 5) + LowestBit(word);
+}
+
+int CodepointSetToArray(const CodepointSet *set, int *out, int maxCount) {
+    int count = 0;
+    for (int index = 0; index < CODEPOINT_SET_LIMIT / 32 && count < maxCount; index++) {
+        unsigned int word = set->bits[index];
+        if (word == 0xFFFFFFFFu && count + 32 <= maxCount) {
+            // 整字连续区段（范围表的主要情况）直接展开
+            for (int bit = 0; bit < 32; bit++) out[count++] = (index << 5) + bit;
+            continue;
+        }
+        while (word != 0 && count < maxCount) {
+            out[count++] = (index << 5) + LowestBit(word);
+            word &= word - 1;
+        }
+    }
+    return count;
+}
@@ -1,5 +1,16 @@
 #include "data.h"
+#include "font_cache.h"
+#include "ui_layer.h"
+#include <math.h>
 #include <stdio.h>
+#include <time.h>
+
+static UILayer statisticsLayer = {0};   // 统计界面静态层
+
+#define HISTORY_DAYS 14     // 按天图表显示的天数
+#define HISTORY_WEEKS 12
+#define HISTORY_MONTHS 12
+#define HISTORY_MAX_BARS 14
 
 void InitStatistics(Statistics *stats) {
     stats->totalPomodoros = 0;
@@ -8,9 +19,93 @@ void InitStatistics(Statistics *stats) {
     stats->interruptions = 0;
     stats->streakDays = 0;
     stats->longSessions = 0;
+    stats->pomodoros25 = 0;
+    stats->pomodoros45 = 0;
+    stats->pomodorosCustom = 0;
+    stats->version++;
+}
+
+// 专注分钟数条形图，标签过密时隔几个画一个
+static void DrawHistoryChart(Font *font, const char *title, const float *minutes, char labels[][8], int count,
+                             Rectangle area, bool isDarkTheme) {
+    Color textColor = isDarkTheme ? LIGHTGRAY : DARKGRAY;
+    DrawTextCached(font, title, (Vector2){area.x, area.y}, 24, 1, textColor);
+
+    Rectangle chart = { area.x, area.y + 32.0f, area.width, area.height - 32.0f - 26.0f };
+    DrawRectangleRec(chart, isDarkTheme ? (Color){50, 50, 60, 255} : (Color){220, 220, 220, 255});
+
+    float maxMinutes = 0.0f;
+    for (int i = 0; i < count; i++) {
+        if (minutes[i] > maxMinutes) maxMinutes = minutes[i];
+    }
+    char maxText[24];
+    sprintf(maxText, "%d分钟", (int)(maxMinutes + 0.5f));
+    Vector2 maxSize = MeasureTextCached(font, maxText, 18, 1);
+    DrawTextCached(font, maxText, (Vector2){area.x + area.width - maxSize.x, area.y + 4.0f}, 18, 1, textColor);
+    if (maxMinutes <= 0.0f) maxMinutes = 1.0f;
+
+    float slot = chart.width / (float)count;
+    float barWidth = slot * 0.7f;
+    int labelStep = (count > 7) ? 2 : 1;
+    for (int i = 0; i < count; i++) {
+        float barHeight = minutes[i] / maxMinutes * chart.height;
+        float x = chart.x + slot * (float)i + (slot - barWidth) / 2.0f;
+        DrawRectangleRec((Rectangle){ x, chart.y + chart.height - barHeight, barWidth, barHeight },
+                         isDarkTheme ? GOLD : SKYBLUE);
+
+        if ((count - 1 - i) % labelStep != 0) continue;
+        Vector2 labelSize = MeasureTextCached(font, labels[i], 16, 1);
+        DrawTextCached(font, labels[i],
+                 (Vector2){ x + barWidth / 2.0f - labelSize.x / 2.0f, chart.y + chart.height + 4.0f }, 16, 1, textColor);
+    }
+}
+
+// 最近若干天、周、月的专注时间，每根柱子是一次按天索引的范围查询
+static void DrawHistoryCharts(const SessionHistory *history, Font *font, bool isDarkTheme, Rectangle area) {
+    float minutes[HISTORY_MAX_BARS];
+    char labels[HISTORY_MAX_BARS][8];
+    float chartHeight = area.height / 3.0f;
+    int32_t today = GetSessionDay((int64_t)time(NULL));
+    int year, month, day;
+
+    for (int i = 0; i < HISTORY_DAYS; i++) {
+        int32_t date = today - (HISTORY_DAYS - 1 - i);
+        minutes[i] = (float)QuerySessionDays(history, date, date).focusSeconds / 60.0f;
+        GetSessionDate(date, &year, &month, &day);
+        sprintf(labels[i], "%d", day);
+    }
+    DrawHistoryChart(font, "近14天专注", minutes, labels, HISTORY_DAYS,
+                     (Rectangle){ area.x, area.y, area.width, chartHeight - 10.0f }, isDarkTheme);
+
+    int32_t thisWeek = GetSessionWeekStart(today);
+    for (int i = 0; i < HISTORY_WEEKS; i++) {
+        int32_t weekStart = thisWeek - 7 * (HISTORY_WEEKS - 1 - i);
+        minutes[i] = (float)QuerySessionDays(history, weekStart, weekStart + 6).focusSeconds / 60.0f;
+        GetSessionDate(weekStart, &year, &month, &day);
+        sprintf(labels[i], "%d/%d", month, day);
+    }
+    DrawHistoryChart(font, "近12周专注", minutes, labels, HISTORY_WEEKS,
+                     (Rectangle){ area.x, area.y + chartHeight, area.width, chartHeight - 10.0f }, isDarkTheme);
+
+    GetSessionDate(today, &year, &month, &day);
+    for (int i = 0; i < HISTORY_MONTHS; i++) {
+        int m = month - (HISTORY_MONTHS - 1 - i);
+        int y = year;
+        while (m <= 0) {
+            m += 12;
+            y--;
+        }
+        int32_t monthStart = GetSessionDayFromDate(y, m, 1);
+        int32_t nextMonth = (m == 12) ? GetSessionDayFromDate(y + 1, 1, 1) : GetSessionDayFromDate(y, m + 1, 1);
+        minutes[i] = (float)QuerySessionDays(history, monthStart, nextMonth - 1).focusSeconds / 60.0f;
+        sprintf(labels[i], "%d月", m);
+    }
+    DrawHistoryChart(font, "近12个月专注", minutes, labels, HISTORY_MONTHS,
+                     (Rectangle){ area.x, area.y + 2.0f * chartHeight, area.width, chartHeight - 10.0f }, isDarkTheme);
 }
 
-void DrawStatisticsScreen(Statistics *stats, Font font, bool isDarkTheme, float screenWidth, float screenHeight) {
+// 统计界面静态内容：除返回按钮外的全部内容
+static void DrawStatisticsLayer(const Statistics *stats, const SessionHistory *history, Font *font, bool isDarkTheme, float screenWidth, float screenHeight) {
     // 设置背景色
     if (isDarkTheme) {
         ClearBackground((Color){30, 30, 40, 255});
@@ -26,20 +121,24 @@ void DrawStatisticsScreen(Statistics *stats, Font font, bool isDarkTheme, float
     
     // 标题
     const char* title = "数据统计";
-    Vector2 titleSize = MeasureTextEx(font, title, 60, 2);
-    DrawTextEx(font, title, 
+    Vector2 titleSize = MeasureTextCached(font, title, 60, 2);
+    DrawTextCached(font, title, 
              (Vector2){screenWidth/2.0f - titleSize.x/2.0f, 40.0f}, 
              60, 2, titleColor);
     
-    // 统计面板
+    // 统计面板：左侧为累计数据，右侧为历史图表
+    float panelWidth = fminf(1140.0f, screenWidth - 40.0f);
     Rectangle panel = {
-        screenWidth/2.0f - 300.0f,
+        screenWidth/2.0f - panelWidth/2.0f,
         120.0f,
-        600.0f,
+        panelWidth,
         screenHeight - 240.0f
     };
     DrawRectangleRec(panel, panelBg);
     DrawRectangleLinesEx(panel, 2, panelBorder);
+    Rectangle historyArea = { panel.x + 620.0f, panel.y + 30.0f, panel.width - 660.0f, panel.height - 50.0f };
+    if (historyArea.width >= 300.0f) DrawHistoryCharts(history, font, isDarkTheme, historyArea);
+    panel.width = 600.0f;   // 左侧沿用原来 600 宽的布局
     
     // 统计数据
     int yPos = panel.y + 40;
@@ -63,10 +162,10 @@ void DrawStatisticsScreen(Statistics *stats, Font font, bool isDarkTheme, float
     sprintf(statsValues[5], "%d", stats->longSessions);
     
     for (int i = 0; i < 6; i++) {
-        DrawTextEx(font, statsLabels[i], 
+        DrawTextCached(font, statsLabels[i], 
                  (Vector2){panel.x + 50, (float)yPos}, 
                  36, 1, textColor);
-        DrawTextEx(font, statsValues[i], 
+        DrawTextCached(font, statsValues[i], 
                  (Vector2){panel.x + panel.width - 150, (float)yPos}, 
                  36, 1, titleColor);
         yPos += lineHeight;
@@ -79,7 +178,7 @@ void DrawStatisticsScreen(Statistics *stats, Font font, bool isDarkTheme, float
     int chartY = yPos + 40;
     
     // 图表标题
-    DrawTextEx(font, "番茄钟分布统计", 
+    DrawTextCached(font, "番茄钟分布统计", 
              (Vector2){(float)chartX, (float)(chartY - 30)}, 
              28, 1, textColor);
     
@@ -102,7 +201,7 @@ void DrawStatisticsScreen(Statistics *stats, Font font, bool isDarkTheme, float
     int barHeight25 = (int)((float)stats->pomodoros25 / maxValue * chartHeight);
     DrawRectangle(startX, chartY + chartHeight - barHeight25, barWidth, barHeight25, 
                 isDarkTheme ? GOLD : SKYBLUE);
-    DrawTextEx(font, "25分钟", 
+    DrawTextCached(font, "25分钟", 
              (Vector2){(float)(startX + 10), (float)(chartY + chartHeight + 10)}, 
              20, 1, textColor);
     
@@ -110,7 +209,7 @@ void DrawStatisticsScreen(Statistics *stats, Font font, bool isDarkTheme, float
     int barHeight45 = (int)((float)stats->pomodoros45 / maxValue * chartHeight);
     DrawRectangle(startX + barWidth + barSpacing, chartY + chartHeight - barHeight45, barWidth, barHeight45, 
                 isDarkTheme ? GOLD : SKYBLUE);
-    DrawTextEx(font, "45分钟", 
+    DrawTextCached(font, "45分钟", 
              (Vector2){(float)(startX + barWidth + barSpacing + 10), (float)(chartY + chartHeight + 10)}, 
              20, 1, textColor);
     
@@ -118,9 +217,25 @@ void DrawStatisticsScreen(Statistics *stats, Font font, bool isDarkTheme, float
     int barHeightCustom = (int)((float)stats->pomodorosCustom / maxValue * chartHeight);
     DrawRectangle(startX + 2 * (barWidth + barSpacing), chartY + chartHeight - barHeightCustom, barWidth, barHeightCustom, 
                 isDarkTheme ? GOLD : SKYBLUE);
-    DrawTextEx(font, "自定义", 
+    DrawTextCached(font, "自定义", 
              (Vector2){(float)(startX + 2 * (barWidth + barSpacing) + 10), (float)(chartY + chartHeight + 10)}, 
              20, 1, textColor);
+}
+
+void DrawStatisticsScreen(const Statistics *stats, const SessionHistory *history, Font *font, bool isDarkTheme, float screenWidth, float screenHeight) {
+    Color textColor = isDarkTheme ? LIGHTGRAY : DARKGRAY;
+
+    // 静态层：主题、统计数据、历史记录或日期变化时重绘，数据只比较版本号
+    int32_t today = GetSessionDay((int64_t)time(NULL));
+    unsigned long long layerKey = HashUILayerData(UI_LAYER_HASH_SEED, &stats->version, sizeof(stats->version));
+    layerKey = HashUILayerData(layerKey, &isDarkTheme, sizeof(isDarkTheme));
+    layerKey = HashUILayerData(layerKey, &history->version, sizeof(history->version));
+    layerKey = HashUILayerData(layerKey, &today, sizeof(today));
+    if (BeginUILayer(&statisticsLayer, (int)screenWidth, (int)screenHeight, layerKey)) {
+        DrawStatisticsLayer(stats, history, font, isDarkTheme, screenWidth, screenHeight);
+        EndUILayer(&statisticsLayer);
+    }
+    DrawUILayer(&statisticsLayer);
     
     // 返回按钮
     Rectangle backButton = {
@@ -136,27 +251,67 @@ void DrawStatisticsScreen(Statistics *stats, Font font, bool isDarkTheme, float
     DrawRectangleLinesEx(backButton, 1, isDarkTheme ? (Color){100, 100, 100, 255} : (Color){200, 200, 200, 255});
     
     const char* backText = "返回";
-    Vector2 backTextSize = MeasureTextEx(font, backText, 24, 1);
-    DrawTextEx(font, backText, 
+    Vector2 backTextSize = MeasureTextCached(font, backText, 24, 1);
+    DrawTextCached(font, backText, 
              (Vector2){backButton.x + backButton.width/2 - backTextSize.x/2, 
                       backButton.y + backButton.height/2 - backTextSize.y/2},
              24, 1, textColor);
 }
 
-void SaveStatistics(const Statistics *stats, const char *filename) {
-    FILE *file = fopen(filename, "wb");
-    if (file) {
-        fwrite(stats, sizeof(Statistics), 1, file);
-        fclose(file);
+void UnloadStatisticsScreen(void) {
+    UnloadUILayer(&statisticsLayer);
+}
+
+// 统计面板只在指标变化时更新对应字段
+static void UpdateStatisticsView(MetricID id, int value, void *userData) {
+    Statistics *stats = (Statistics*)userData;
+    switch (id) {
+        case METRIC_TOTAL_POMODOROS: stats->totalPomodoros = value; break;
+        case METRIC_CLEANED_TRASH: stats->cleanedTrash = value; break;
+        case METRIC_GENERATED_TRASH: stats->generatedTrash = value; break;
+        case METRIC_INTERRUPTIONS: stats->interruptions = value; break;
+        case METRIC_STREAK_DAYS: stats->streakDays = value; break;
+        case METRIC_LONG_SESSIONS: stats->longSessions = value; break;
+        case METRIC_POMODOROS_25: stats->pomodoros25 = value; break;
+        case METRIC_POMODOROS_45: stats->pomodoros45 = value; break;
+        case METRIC_POMODOROS_CUSTOM: stats->pomodorosCustom = value; break;
+        default: return;
+    }
+    stats->version++;
+}
+
+void BindStatisticsView(Statistics *stats, MetricsStore *metrics) {
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        UpdateStatisticsView((MetricID)i, GetMetric(metrics, (MetricID)i), stats);
     }
+    AddMetricsListener(metrics, UpdateStatisticsView, stats);
 }
 
-void LoadStatistics(Statistics *stats, const char *filename) {
+// 旧 Statistics 结构体的字段顺序
+static const MetricID legacyStatisticsMetrics[] = {
+    METRIC_TOTAL_POMODOROS, METRIC_CLEANED_TRASH, METRIC_GENERATED_TRASH, METRIC_INTERRUPTIONS,
+    METRIC_STREAK_DAYS, METRIC_LONG_SESSIONS, METRIC_POMODOROS_25, METRIC_POMODOROS_45, METRIC_POMODOROS_CUSTOM
+};
+#define LEGACY_STATISTICS_COUNT ((int)(sizeof(legacyStatisticsMetrics) / sizeof(legacyStatisticsMetrics[0])))
+
+// 旧版本直接写出 Statistics 结构体（全部为 int），长度一致才读取
+static bool LoadLegacyStatistics(MetricsStore *metrics, const char *filename) {
     FILE *file = fopen(filename, "rb");
-    if (file) {
-        fread(stats, sizeof(Statistics), 1, file);
-        fclose(file);
-    } else {
-        InitStatistics(stats);
+    if (file == NULL) return false;
+
+    int legacy[LEGACY_STATISTICS_COUNT];
+    bool loaded = fread(legacy, sizeof(legacy), 1, file) == 1 && fgetc(file) == EOF;
+    fclose(file);
+    if (!loaded) return false;
+
+    for (int i = 0; i < LEGACY_STATISTICS_COUNT; i++) {
+        SetMetric(metrics, legacyStatisticsMetrics[i], legacy[i]);
     }
-}
\ No newline at end of file
+    return true;
+}
+
+void LoadStatistics(MetricsStore *metrics, const char *filename) {
+    if (LoadLegacyStatistics(metrics, filename)) {
+        TraceLog(LOG_INFO, "已读取旧格式统计数据: %s", filename);
+    }
+}
@@ -0,0 +1,133 @@
+#include "digit_atlas.h"
+#include "rlgl.h"
+#include <string.h>
+
+#define DIGIT_CELL_PADDING 2     // 数字间距，避免双线性过滤时相邻数字渗色
+#define DIGIT_WHITE_SIZE 8       // 白色区域大小，只取中心部分
+
+bool LoadDigitAtlas(DigitAtlas *atlas, Font font, float fontSize, float spacing) {
+    memset(atlas, 0, sizeof(DigitAtlas));
+    atlas->fontSize = fontSize;
+    atlas->spacing = spacing;
+
+    // 先渲染各数字得到尺寸，再按总宽度拼图
+    Image glyphs[10];
+    int width = DIGIT_CELL_PADDING;
+    int height = DIGIT_WHITE_SIZE;
+    for (int d = 0; d < 10; d++) {
+        char text[2] = { (char)('0' + d), '\0' };
+        glyphs[d] = ImageTextEx(font, text, fontSize, spacing, WHITE);
+        width += glyphs[d].width + DIGIT_CELL_PADDING;
+        if (glyphs[d].height > height) height = glyphs[d].height;
+    }
+    width += DIGIT_WHITE_SIZE + DIGIT_CELL_PADDING;
+    height += 2*DIGIT_CELL_PADDING;
+
+    // 宽高取 2 的幂，兼容不支持 NPOT 纹理的设备
+    int atlasWidth = 1;
+    int atlasHeight = 1;
+    while (atlasWidth < width) atlasWidth *= 2;
+    while (atlasHeight < height) atlasHeight *= 2;
+
+    Image image = GenImageColor(atlasWidth, atlasHeight, BLANK);
+    int x = DIGIT_CELL_PADDING;
+    for (int d = 0; d < 10; d++) {
+        atlas->digits[d] = (Rectangle){ (float)x, DIGIT_CELL_PADDING, (float)glyphs[d].width, (float)glyphs[d].height };
+        ImageDraw(&image, glyphs[d], (Rectangle){ 0, 0, (float)glyphs[d].width, (float)glyphs[d].height },
+                  atlas->digits[d], WHITE);
+        x += glyphs[d].width + DIGIT_CELL_PADDING;
+        UnloadImage(glyphs[d]);
+    }
+
+    ImageDrawRectangle(&image, x, DIGIT_CELL_PADDING, DIGIT_WHITE_SIZE, DIGIT_WHITE_SIZE, WHITE);
+    atlas->whiteRect = (Rectangle){ x + DIGIT_WHITE_SIZE/2 - 1.0f, DIGIT_CELL_PADDING + DIGIT_WHITE_SIZE/2 - 1.0f, 2.0f, 2.0f };
+
+    atlas->texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+    if (atlas->texture.id == 0) {
+        TraceLog(LOG_WARNING, "数字图集上传失败");
+        return false;
+    }
+    SetTextureFilter(atlas->texture, TEXTURE_FILTER_BILINEAR);
+    atlas->ready = true;
+    return true;
+}
+
+void UnloadDigitAtlas(DigitAtlas *atlas) {
+    if (atlas->ready) UnloadTexture(atlas->texture);
+    memset(atlas, 0, sizeof(DigitAtlas));
+}
+
+DigitLabel MakeDigitLabel(const DigitAtlas *atlas, int value) {
+    DigitLabel label = { .digitCount = 0, .width = -1.0f };
+    unsigned int number = (value < 0) ? 0u - (unsigned int)value : (unsigned int)value;
+
+    // 从低位拆到高位，再翻转
+    do {
+        label.digits[label.digitCount++] = (unsigned char)(number % 10);
+        number /= 10;
+    } while (number > 0 && label.digitCount < DIGIT_LABEL_MAX);
+    for (int i = 0; i < label.digitCount / 2; i++) {
+        unsigned char digit = label.digits[i];
+        label.digits[i] = label.digits[label.digitCount - 1 - i];
+        label.digits[label.digitCount - 1 - i] = digit;
+    }
+
+    if (atlas->ready) {
+        label.width = 0.0f;
+        for (int i = 0; i < label.digitCount; i++) {
+            label.width += atlas->digits[label.digits[i]].width;
+        }
+        label.width += atlas->spacing * (label.digitCount - 1);
+    }
+    return label;
+}
+
+static void PushAtlasQuad(const DigitAtlas *atlas, Rectangle source, Rectangle dest, Color color) {
+    // 批次写满时 rlgl 会先提交，再以相同的纹理与模式继续
+    rlCheckRenderBatchLimit(4);
+
+    float u0 = source.x / atlas->texture.width;
+    float v0 = source.y / atlas->texture.height;
+    float u1 = (source.x + source.width) / atlas->texture.width;
+    float v1 = (source.y + source.height) / atlas->texture.height;
+
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlTexCoord2f(u0, v0);
+    rlVertex2f(dest.x, dest.y);
+    rlTexCoord2f(u0, v1);
+    rlVertex2f(dest.x, dest.y + dest.height);
+    rlTexCoord2f(u1, v1);
+    rlVertex2f(dest.x + dest.width, dest.y + dest.height);
+    rlTexCoord2f(u1, v0);
+    rlVertex2f(dest.x + dest.width, dest.y);
+}
+
+void BeginDigitBatch(const DigitAtlas *atlas) {
+    rlSetTexture(atlas->texture.id);
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+}
+
+void PushDigitRect(const DigitAtlas *atlas, Rectangle dest, Color color) {
+    PushAtlasQuad(atlas, atlas->whiteRect, dest, color);
+}
+
+void PushDigitLabel(const DigitAtlas *atlas, const DigitLabel *label, Vector2 center, float fontSize, Color color) {
+    float scale = fontSize / atlas->fontSize;
+    float height = atlas->digits[0].height * scale;
+    float x = center.x - label->width * scale / 2.0f;
+    float y = center.y - height / 2.0f;
+
+    for (int i = 0; i < label->digitCount; i++) {
+        Rectangle source = atlas->digits[label->digits[i]];
+        float width = source.width * scale;
+        PushAtlasQuad(atlas, source, (Rectangle){ x, y, width, height }, color);
+        x += width + atlas->spacing * scale;
+    }
+}
+
+void EndDigitBatch(void) {
+    rlEnd();
+    rlSetTexture(0);
+}
@@ -0,0 +1,78 @@
+#include "file_map.h"
+#include <string.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+bool MapFile(MappedFile *map, const char *fileName) {
+    memset(map, 0, sizeof(MappedFile));
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == NULL) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    map->data = (const unsigned char *)view;
+    map->size = (size_t)fileSize.QuadPart;
+    map->fileHandle = file;
+    map->mappingHandle = mapping;
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    void *view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // 映射建立后即可关闭文件描述符
+    if (view == MAP_FAILED) return false;
+
+    map->data = (const unsigned char *)view;
+    map->size = (size_t)info.st_size;
+#endif
+
+    return true;
+}
+
+void UnmapFile(MappedFile *map) {
+    if (map->data == NULL) return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile((LPCVOID)map->data);
+    CloseHandle((HANDLE)map->mappingHandle);
+    CloseHandle((HANDLE)map->fileHandle);
+#else
+    munmap((void *)map->data, map->size);
+#endif
+
+    memset(map, 0, sizeof(MappedFile));
+}
@@ -0,0 +1,517 @@
+#include "font_cache.h"
+#include "file_map.h"
+#include "codepoint_set.h"
+#include "text_cache.h"
+#include "rlgl.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_FONT_CACHES 4
+#define FONT_CACHE_PADDING 4           // 与 LoadFontEx 默认字形间距一致
+#define MAX_PENDING_GLYPHS 256         // 单次扩容最多光栅化的字符数
+#define MAX_FONT_ATLAS_SIZE 4096       // 图集扩容的上限（宽、高）
+
+// 单个字体的缓存条目
+typedef struct {
+    Font *font;                                  // 绑定的字体（图集扩容后原地更新）
+    unsigned char *fileData;                     // 字体文件数据，扩容时复用
+    int fileSize;
+    char fallbackFile[256];                      // 预烘焙字体的原始字体文件，首次未命中时才读取
+    MappedFile baked;                            // 预烘焙图集的内存映射
+    int fontSize;
+    CodepointSet present;                        // BMP 范围内已光栅化的字符
+    int shelfX;                                  // 图集空闲区域按行放置新字形：当前行的下一个空位
+    int shelfY;                                  // 当前行的顶部
+    int shelfHeight;                             // 当前行的高度（含间距）
+    FontCacheStats stats;
+} FontCacheEntry;
+
+static FontCacheEntry fontCaches[MAX_FONT_CACHES] = {0};
+
+static FontCacheEntry *FindFontCache(const Font *font) {
+    for (int i = 0; i < MAX_FONT_CACHES; i++) {
+        if (fontCaches[i].font == font) return &fontCaches[i];
+    }
+    return NULL;
+}
+
+static bool IsGlyphPresent(const FontCacheEntry *entry, int codepoint) {
+    if (codepoint < CODEPOINT_SET_LIMIT) {
+        return HasCodepoint(&entry->present, codepoint);
+    }
+    // BMP 之外的字符极少出现，直接线性查找
+    for (int i = 0; i < entry->font->glyphCount; i++) {
+        if (entry->font->glyphs[i].value == codepoint) return true;
+    }
+    return false;
+}
+
+// 从 *offset 起收集 text 中尚未光栅化的字符（最多 maxPending 个），offset 前进到停下的位置，返回数量
+static int CollectMissingCodepoints(FontCacheEntry *entry, const char *text, int length, int *offset, int *pending, int maxPending) {
+    int count = 0;
+
+    while (*offset < length && count < maxPending) {
+        int codepointSize = 0;
+        int codepoint = GetCodepointNext(&text[*offset], &codepointSize);
+        *offset += codepointSize;
+
+        if (codepoint < 0x20) continue;  // 控制字符（换行等）不需要字形
+        entry->stats.lookups++;
+        if (IsGlyphPresent(entry, codepoint)) continue;
+
+        // 立即标记，同一字符在本次收集中只出现一次
+        AddCodepoint(&entry->present, codepoint);
+        pending[count++] = codepoint;
+    }
+
+    return count;
+}
+
+// 已用区域之下开始新的一行：GenImageFontAtlas 与预烘焙图集都是从上到下逐行排列的
+static void ResetAtlasShelf(FontCacheEntry *entry) {
+    const Font *font = entry->font;
+    int bottom = 0;
+    for (int i = 0; i < font->glyphCount; i++) {
+        int glyphBottom = (int)(font->recs[i].y + font->recs[i].height) + FONT_CACHE_PADDING;
+        if (glyphBottom > bottom) bottom = glyphBottom;
+    }
+    entry->shelfX = 0;
+    entry->shelfY = bottom;
+    entry->shelfHeight = 0;
+}
+
+// 在当前行放置字形（四周留间距），行内放不下时换行，图集剩余高度不够时返回 false
+static bool PlaceGlyphOnShelf(FontCacheEntry *entry, const Image *image, int atlasWidth, int atlasHeight, Rectangle *rec) {
+    int cellWidth = image->width + 2 * FONT_CACHE_PADDING;
+    int cellHeight = image->height + 2 * FONT_CACHE_PADDING;
+    if (cellWidth > atlasWidth) return false;
+
+    if (entry->shelfX + cellWidth > atlasWidth) {
+        entry->shelfY += entry->shelfHeight;
+        entry->shelfX = 0;
+        entry->shelfHeight = 0;
+    }
+    if (entry->shelfY + cellHeight > atlasHeight) return false;
+
+    *rec = (Rectangle){
+        (float)(entry->shelfX + FONT_CACHE_PADDING),
+        (float)(entry->shelfY + FONT_CACHE_PADDING),
+        (float)image->width,
+        (float)image->height
+    };
+    entry->shelfX += cellWidth;
+    if (cellHeight > entry->shelfHeight) entry->shelfHeight = cellHeight;
+    return true;
+}
+
+// 字形位图（LoadFontData 输出的灰度图）写入 GRAY_ALPHA 像素：与 GenImageFontAtlas 一致，
+// 灰度固定为 255，覆盖率写入 alpha；stride 为目标每行的像素数
+static void CopyGlyphPixels(const Image *image, unsigned char *out, int stride) {
+    const unsigned char *in = (const unsigned char *)image->data;
+    if (in == NULL) return;
+
+    for (int y = 0; y < image->height; y++) {
+        for (int x = 0; x < image->width; x++) {
+            out[(y * stride + x) * 2 + 1] = in[y * image->width + x];
+        }
+    }
+}
+
+// 只上传新字形所在的子区域，图集其余部分保持不变
+static void UploadGlyphRect(Font *font, int index) {
+    const Image *image = &font->glyphs[index].image;
+    if (image->width <= 0 || image->height <= 0 || image->data == NULL) return;
+
+    unsigned char *pixels = (unsigned char *)MemAlloc((unsigned int)(image->width * image->height * 2));
+    if (pixels == NULL) return;
+    memset(pixels, 255, (size_t)image->width * image->height * 2);
+    CopyGlyphPixels(image, pixels, image->width);
+    UpdateTextureRec(font->texture, font->recs[index], pixels);
+    MemFree(pixels);
+}
+
+// 预烘焙字形没有单独的位图，重新打包前从映射的图集中取出（灰度值即 alpha 通道）
+static void ExtractBakedGlyphImages(FontCacheEntry *entry) {
+    if (entry->baked.data == NULL) return;
+
+    const BakedFontHeader *header = (const BakedFontHeader *)entry->baked.data;
+    const unsigned char *pixels = entry->baked.data + sizeof(BakedFontHeader) + header->glyphCount * sizeof(BakedGlyph);
+    Font *font = entry->font;
+
+    for (int i = 0; i < header->glyphCount && i < font->glyphCount; i++) {
+        GlyphInfo *glyph = &font->glyphs[i];
+        if (glyph->image.data != NULL) continue;
+
+        Rectangle rec = font->recs[i];
+        int width = (int)rec.width;
+        int height = (int)rec.height;
+        unsigned char *data = (unsigned char *)MemAlloc((unsigned int)((width > 0 ? width : 1) * (height > 0 ? height : 1)));
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                int index = ((int)rec.y + y) * header->atlasWidth + ((int)rec.x + x);
+                data[y * width + x] = pixels[index * 2 + 1];
+            }
+        }
+        glyph->image = (Image){ data, width, height, 1, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE };
+    }
+
+    UnmapFile(&entry->baked);
+}
+
+// 图集放不下时整体重新打包到更大的图集（交替加高、加宽），返回是否成功
+static bool GrowFontAtlas(FontCacheEntry *entry) {
+    Font *font = entry->font;
+    ExtractBakedGlyphImages(entry);
+
+    Rectangle *recs = (Rectangle *)MemAlloc((unsigned int)(font->glyphCount * sizeof(Rectangle)));
+    if (recs == NULL) return false;
+
+    int width = (entry->stats.atlasWidth > 0) ? entry->stats.atlasWidth : 256;
+    int height = (entry->stats.atlasHeight > 0) ? entry->stats.atlasHeight : 256;
+    bool fits = false;
+    while (!fits) {
+        if (height <= width) height *= 2;
+        else width *= 2;
+        if (width > MAX_FONT_ATLAS_SIZE || height > MAX_FONT_ATLAS_SIZE) break;
+
+        entry->shelfX = 0;
+        entry->shelfY = 0;
+        entry->shelfHeight = 0;
+        fits = true;
+        for (int i = 0; i < font->glyphCount && fits; i++) {
+            fits = PlaceGlyphOnShelf(entry, &font->glyphs[i].image, width, height, &recs[i]);
+        }
+    }
+    unsigned char *pixels = fits ? (unsigned char *)MemAlloc((unsigned int)(width * height * 2)) : NULL;
+    if (pixels == NULL) {
+        MemFree(recs);
+        ResetAtlasShelf(entry);
+        return false;
+    }
+
+    for (int i = 0; i < width * height; i++) {
+        pixels[i * 2] = 255;
+        pixels[i * 2 + 1] = 0;
+    }
+    for (int i = 0; i < font->glyphCount; i++) {
+        CopyGlyphPixels(&font->glyphs[i].image, pixels + ((int)recs[i].y * width + (int)recs[i].x) * 2, width);
+    }
+
+    Image atlas = { pixels, width, height, 1, PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA };
+    // 本帧已排队的字形四边形按旧图集的 UV 生成，先提交再替换纹理，
+    // 否则提交时会绑定已删除（或被复用为新布局）的纹理；放进空闲区域时旧 UV 不变，无需提交
+    rlDrawRenderBatchActive();
+    if (font->texture.id != 0) UnloadTexture(font->texture);
+    if (font->recs != NULL) MemFree(font->recs);
+    font->recs = recs;
+    font->texture = LoadTextureFromImage(atlas);
+    SetTextureFilter(font->texture, TEXTURE_FILTER_BILINEAR);
+
+    entry->stats.atlasWidth = width;
+    entry->stats.atlasHeight = height;
+    entry->stats.atlasBytes = GetPixelDataSize(width, height, atlas.format);
+    entry->stats.rebuildCount++;
+
+    UnloadImage(atlas);
+    return true;
+}
+
+// 光栅化新字符并追加到字体中：新字形放进图集的空闲区域，只上传各自的子区域；
+// 空闲区域不够时才整体重新打包到更大的图集
+static void AppendGlyphs(FontCacheEntry *entry, int *codepoints, int count) {
+    Font *font = entry->font;
+
+    // 预烘焙字体首次遇到烘焙集合之外的字符时才读取原始字体文件
+    if (entry->fileData == NULL && entry->fallbackFile[0] != '\0') {
+        entry->fileData = LoadFileData(entry->fallbackFile, &entry->fileSize);
+        entry->fallbackFile[0] = '\0';
+    }
+    if (entry->fileData == NULL) return;
+
+    GlyphInfo *fresh = LoadFontData(entry->fileData, entry->fileSize, entry->fontSize, codepoints, count, FONT_DEFAULT);
+
+    // 失败时字符仍保持已标记状态，避免每帧重复光栅化
+    if (fresh == NULL) return;
+
+    // 字形数组即将重新分配，缓存的字形下标与测量结果随之失效
+    InvalidateTextCache(font);
+    GlyphInfo *glyphs = (GlyphInfo *)MemRealloc(font->glyphs, (unsigned int)((font->glyphCount + count) * sizeof(GlyphInfo)));
+    if (glyphs != NULL) font->glyphs = glyphs;
+    Rectangle *recs = (Rectangle *)MemRealloc(font->recs, (unsigned int)((font->glyphCount + count) * sizeof(Rectangle)));
+    if (recs != NULL) font->recs = recs;
+    if (glyphs == NULL || recs == NULL) {
+        UnloadFontData(fresh, count);
+        return;
+    }
+    memcpy(&glyphs[font->glyphCount], fresh, count * sizeof(GlyphInfo));
+    MemFree(fresh);  // 字形图像的所有权已转移到 glyphs
+
+    int first = font->glyphCount;
+    font->glyphCount += count;
+    entry->stats.glyphCount = font->glyphCount;
+    memset(&recs[first], 0, count * sizeof(Rectangle));
+
+    bool placed = font->texture.format == PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA;
+    for (int i = first; i < font->glyphCount && placed; i++) {
+        placed = PlaceGlyphOnShelf(entry, &glyphs[i].image, entry->stats.atlasWidth, entry->stats.atlasHeight, &recs[i]);
+    }
+    if (placed) {
+        for (int i = first; i < font->glyphCount; i++) UploadGlyphRect(font, i);
+    } else if (!GrowFontAtlas(entry)) {
+        // 图集已达上限：新字符不显示，仍保持已标记状态
+        TraceLog(LOG_WARNING, "字体图集已满，%d 个字符无法显示", count);
+        for (int i = first; i < font->glyphCount; i++) font->recs[i] = (Rectangle){0};
+    }
+}
+
+// 映射并校验预烘焙图集，成功时填写 job 的字形与图集视图
+static bool PrepareBakedFont(FontLoadJob *job) {
+    if (!MapFile(&job->baked, job->bakedFile)) return false;
+
+    const BakedFontHeader *header = (const BakedFontHeader *)job->baked.data;
+    size_t glyphBytes = 0;
+    size_t pixelBytes = 0;
+    bool valid = job->baked.size >= sizeof(BakedFontHeader) &&
+                 memcmp(header->magic, BAKED_FONT_MAGIC, 4) == 0 &&
+                 header->version == BAKED_FONT_VERSION &&
+                 header->glyphCount > 0 &&
+                 header->atlasFormat == PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA;
+    if (valid) {
+        glyphBytes = header->glyphCount * sizeof(BakedGlyph);
+        pixelBytes = (size_t)GetPixelDataSize(header->atlasWidth, header->atlasHeight, header->atlasFormat);
+        valid = job->baked.size >= sizeof(BakedFontHeader) + glyphBytes + pixelBytes;
+    }
+    if (!valid) {
+        TraceLog(LOG_WARNING, "预烘焙字体格式无效: %s", job->bakedFile);
+        UnmapFile(&job->baked);
+        return false;
+    }
+
+    const BakedGlyph *bakedGlyphs = (const BakedGlyph *)(job->baked.data + sizeof(BakedFontHeader));
+    const unsigned char *pixels = job->baked.data + sizeof(BakedFontHeader) + glyphBytes;
+
+    job->baseSize = header->baseSize;
+    job->glyphPadding = header->glyphPadding;
+    job->glyphCount = header->glyphCount;
+    job->glyphs = (GlyphInfo *)MemAlloc((unsigned int)(header->glyphCount * sizeof(GlyphInfo)));
+    job->recs = (Rectangle *)MemAlloc((unsigned int)(header->glyphCount * sizeof(Rectangle)));
+
+    for (int i = 0; i < header->glyphCount; i++) {
+        job->glyphs[i] = (GlyphInfo){
+            .value = bakedGlyphs[i].value,
+            .offsetX = bakedGlyphs[i].offsetX,
+            .offsetY = bakedGlyphs[i].offsetY,
+            .advanceX = bakedGlyphs[i].advanceX
+        };
+        job->recs[i] = bakedGlyphs[i].rec;
+    }
+
+    // 像素数据直接指向映射区，上传时无需任何字体解析
+    job->atlas = (Image){ (void *)pixels, header->atlasWidth, header->atlasHeight, 1, header->atlasFormat };
+    job->fromBaked = true;
+    return true;
+}
+
+// 光栅化可打印 ASCII 与种子文本中出现的字符
+static bool PrepareRasterFont(FontLoadJob *job) {
+    job->fileData = LoadFileData(job->fontFile, &job->fileSize);
+    if (job->fileData == NULL) return false;
+
+    // 集合较大（8KB），工作线程中放在堆上
+    CodepointSet *seed = (CodepointSet *)calloc(1, sizeof(CodepointSet));
+    if (seed == NULL) {
+        UnloadFileData(job->fileData);
+        job->fileData = NULL;
+        return false;
+    }
+    AddCodepointRanges(seed, CODEPOINT_RANGES_ASCII, CODEPOINT_RANGES_ASCII_COUNT);
+    if (job->seedText != NULL) {
+        AddCodepointsFromText(seed, job->seedText, (int)strlen(job->seedText));
+    }
+    int *codepoints = (int *)malloc(seed->count * sizeof(int));
+    if (codepoints == NULL) {
+        free(seed);
+        UnloadFileData(job->fileData);
+        job->fileData = NULL;
+        return false;
+    }
+    int count = CodepointSetToArray(seed, codepoints, seed->count);
+    free(seed);
+
+    job->glyphs = LoadFontData(job->fileData, job->fileSize, job->fontSize, codepoints, count, FONT_DEFAULT);
+    free(codepoints);
+
+    if (job->glyphs == NULL) {
+        UnloadFileData(job->fileData);
+        job->fileData = NULL;
+        return false;
+    }
+
+    job->baseSize = job->fontSize;
+    job->glyphPadding = FONT_CACHE_PADDING;
+    job->glyphCount = count;
+    job->atlas = GenImageFontAtlas(job->glyphs, &job->recs, count, job->fontSize, FONT_CACHE_PADDING, 0);
+    return true;
+}
+
+bool PrepareFontLoad(FontLoadJob *job) {
+    double startTime = GetTime();
+
+    job->prepared = false;
+    if (job->bakedFile != NULL) {
+        job->prepared = PrepareBakedFont(job);
+    }
+    if (!job->prepared && job->fontFile != NULL && job->fontSize > 0) {
+        job->prepared = PrepareRasterFont(job);
+    }
+
+    job->cpuTime = GetTime() - startTime;
+    return job->prepared;
+}
+
+void ReleaseFontLoad(FontLoadJob *job) {
+    if (job->glyphs != NULL) UnloadFontData(job->glyphs, job->glyphCount);
+    if (job->recs != NULL) MemFree(job->recs);
+    if (!job->fromBaked && job->atlas.data != NULL) UnloadImage(job->atlas);
+    UnloadFileData(job->fileData);
+    UnmapFile(&job->baked);
+
+    job->glyphs = NULL;
+    job->recs = NULL;
+    job->atlas = (Image){0};
+    job->fileData = NULL;
+    job->prepared = false;
+}
+
+bool FinishFontLoad(Font *font, FontLoadJob *job) {
+    UnloadFontCached(font);
+
+    FontCacheEntry *entry = FindFontCache(NULL);
+    if (!job->prepared || entry == NULL) {
+        ReleaseFontLoad(job);
+        return false;
+    }
+
+    double startTime = GetTime();
+
+    memset(entry, 0, sizeof(FontCacheEntry));
+    entry->font = font;
+    entry->fontSize = job->baseSize;
+    entry->fileData = job->fileData;
+    entry->fileSize = job->fileSize;
+    if (job->fromBaked) {
+        // 预烘焙字形的位图在扩容前才从映射区取出，原始字体文件延迟到首次未命中时读取
+        entry->baked = job->baked;
+        if (job->fontFile != NULL) {
+            strncpy(entry->fallbackFile, job->fontFile, sizeof(entry->fallbackFile) - 1);
+        }
+    }
+
+    *font = (Font){0};
+    font->baseSize = job->baseSize;
+    font->glyphPadding = job->glyphPadding;
+    font->glyphCount = job->glyphCount;
+    font->glyphs = job->glyphs;
+    font->recs = job->recs;
+    for (int i = 0; i < job->glyphCount; i++) {
+        AddCodepoint(&entry->present, job->glyphs[i].value);
+    }
+
+    font->texture = LoadTextureFromImage(job->atlas);
+    SetTextureFilter(font->texture, TEXTURE_FILTER_BILINEAR);
+    ResetAtlasShelf(entry);
+
+    entry->stats.glyphCount = job->glyphCount;
+    entry->stats.atlasWidth = job->atlas.width;
+    entry->stats.atlasHeight = job->atlas.height;
+    entry->stats.atlasBytes = GetPixelDataSize(job->atlas.width, job->atlas.height, job->atlas.format);
+    entry->stats.loadTime = job->cpuTime + (GetTime() - startTime);
+
+    // 所有权已转移到字体与缓存条目
+    if (!job->fromBaked) UnloadImage(job->atlas);
+    job->glyphs = NULL;
+    job->recs = NULL;
+    job->atlas = (Image){0};
+    job->fileData = NULL;
+    job->baked = (MappedFile){0};
+    job->prepared = false;
+
+    return font->texture.id != 0;
+}
+
+bool LoadFontCached(Font *font, const char *fileName, int fontSize, const char *seedText) {
+    FontLoadJob job = { .fontFile = fileName, .fontSize = fontSize, .seedText = seedText };
+    PrepareFontLoad(&job);
+    return FinishFontLoad(font, &job);
+}
+
+bool LoadFontBaked(Font *font, const char *bakedFile, const char *fallbackFile) {
+    // 字号为 0：只接受预烘焙图集，fallbackFile 仅用于运行时补充字符
+    FontLoadJob job = { .bakedFile = bakedFile, .fontFile = fallbackFile };
+    PrepareFontLoad(&job);
+    return FinishFontLoad(font, &job);
+}
+
+void RequireFontGlyphs(Font *font, const char *text) {
+    if (text == NULL) return;
+    FontCacheEntry *entry = FindFontCache(font);
+    if (entry == NULL) return;
+
+    // 每次最多光栅化 MAX_PENDING_GLYPHS 个字符，从上次停下的位置继续，直到整段文本都有字形；
+    // 否则超出部分会一直以回退字形留在缓存的文本中
+    int pending[MAX_PENDING_GLYPHS];
+    int length = (int)strlen(text);
+    int offset = 0;
+    int count;
+    while ((count = CollectMissingCodepoints(entry, text, length, &offset, pending, MAX_PENDING_GLYPHS)) > 0) {
+        entry->stats.misses += count;
+        AppendGlyphs(entry, pending, count);
+    }
+}
+
+void UnloadFontCached(Font *font) {
+    FontCacheEntry *entry = FindFontCache(font);
+    if (entry == NULL) return;
+
+    InvalidateTextCache(font);
+    UnloadFont(*font);
+    UnloadFileData(entry->fileData);
+    UnmapFile(&entry->baked);
+    memset(entry, 0, sizeof(FontCacheEntry));
+    *font = (Font){0};
+}
+
+FontCacheStats GetFontCacheStats(const Font *font) {
+    FontCacheEntry *entry = FindFontCache(font);
+    return (entry != NULL) ? entry->stats : (FontCacheStats){0};
+}
+
+void LogFontCacheStats(const Font *font, const char *name) {
+    FontCacheEntry *entry = FindFontCache(font);
+    if (entry == NULL) return;
+
+    const FontCacheStats *stats = &entry->stats;
+    float hitRate = (stats->lookups > 0) ?
+        100.0f * (float)(stats->lookups - stats->misses) / (float)stats->lookups : 100.0f;
+    TraceLog(LOG_INFO, "字形缓存[%s]: 加载 %.1f ms, 字形 %d, 图集 %dx%d (%d KB), 扩容 %d 次, 命中率 %.2f%% (%lu/%lu)",
+             name, stats->loadTime * 1000.0, stats->glyphCount, stats->atlasWidth, stats->atlasHeight,
+             stats->atlasBytes / 1024, stats->rebuildCount, hitRate,
+             stats->lookups - stats->misses, stats->lookups);
+}
+
+// 已缓存的字符串直接返回；首次出现时先补齐字形再解码，之后跳过 UTF-8 解码与字形查找
+static TextRun *PrepareTextRun(Font *font, const char *text) {
+    TextRun *run = FindTextRun(font, text);
+    if (run != NULL) return run;
+
+    RequireFontGlyphs(font, text);
+    return CacheTextRun(font, text);
+}
+
+Vector2 MeasureTextCached(Font *font, const char *text, float fontSize, float spacing) {
+    return MeasureTextRun(font, PrepareTextRun(font, text), text, fontSize, spacing);
+}
+
+void DrawTextCached(Font *font, const char *text, Vector2 position, float fontSize, float spacing, Color tint) {
+    DrawTextRun(font, PrepareTextRun(font, text), text, position, fontSize, spacing, tint);
+}
@@ -0,0 +1,162 @@
+#include "frame_pacer.h"
+#include <stdio.h>
+
+static bool frameDirty = true;
+static bool frameAnimating = false;
+static bool frameAwake = false;
+static double scheduledFrameTime = -1.0;   // 小于 0 表示没有定时重绘
+static bool lastFocused = true;
+static Vector2 lastWindowPos = {0};
+static FramePacerStats pacerStats = {0};
+static bool lastFrameAnimated = false;     // 上一轮是否绘制了动画帧，只有连续动画帧的间隔才计入直方图
+static double lastPacingTime = 0.0;
+static float pacedFrameDelta = 0.0f;
+
+// 最后一档没有上界
+static const float frameTimeBucketLimits[FRAME_TIME_BUCKETS - 1] = { 7.0f, 10.0f, 14.0f, 18.0f, 25.0f, 34.0f, 50.0f };
+
+static void RecordFrameTime(float seconds) {
+    float ms = seconds * 1000.0f;
+    int bucket = 0;
+    while (bucket < FRAME_TIME_BUCKETS - 1 && ms >= frameTimeBucketLimits[bucket]) bucket++;
+    pacerStats.frameTimeHistogram[bucket]++;
+}
+
+// 上一轮 PollInputEvents 是否收到了任何输入（不消耗 raylib 的按键/字符队列）
+static bool HasPendingInput(void) {
+    Vector2 mouseDelta = GetMouseDelta();
+    if (mouseDelta.x != 0.0f || mouseDelta.y != 0.0f) return true;
+    if (GetMouseWheelMove() != 0.0f) return true;
+
+    for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_BACK; button++) {
+        if (IsMouseButtonPressed(button) || IsMouseButtonReleased(button) || IsMouseButtonDown(button)) return true;
+    }
+    for (int key = KEY_SPACE; key <= KEY_KP_EQUAL; key++) {
+        if (IsKeyPressed(key) || IsKeyReleased(key) || IsKeyDown(key)) return true;
+    }
+
+    return false;
+}
+
+void InitFramePacer(void) {
+    frameDirty = true;
+    frameAnimating = false;
+    frameAwake = false;
+    scheduledFrameTime = -1.0;
+    lastFocused = IsWindowFocused();
+    lastWindowPos = GetWindowPosition();
+    pacerStats = (FramePacerStats){0};
+    lastFrameAnimated = false;
+    lastPacingTime = GetTime();
+    pacedFrameDelta = 0.0f;
+}
+
+void BeginFramePacing(void) {
+    frameAnimating = false;
+    frameAwake = false;
+
+    // 跳过绘制的轮次不经过 EndDrawing，GetFrameTime 停留在上一次绘制的帧时间，这里按实际经过的时间计算
+    double now = GetTime();
+    pacedFrameDelta = (float)(now - lastPacingTime);
+    lastPacingTime = now;
+
+    if (scheduledFrameTime >= 0.0 && GetTime() >= scheduledFrameTime) {
+        scheduledFrameTime = -1.0;
+        frameDirty = true;
+    }
+
+    // 窗口尺寸、位置、焦点变化都会影响画面
+    bool focused = IsWindowFocused();
+    Vector2 windowPos = GetWindowPosition();
+    if (IsWindowResized() || focused != lastFocused ||
+        windowPos.x != lastWindowPos.x || windowPos.y != lastWindowPos.y) {
+        frameDirty = true;
+    }
+    lastFocused = focused;
+    lastWindowPos = windowPos;
+
+    if (HasPendingInput()) {
+        frameDirty = true;
+    }
+}
+
+float GetPacedFrameTime(void) {
+    return pacedFrameDelta;
+}
+
+void MarkFrameDirty(void) {
+    frameDirty = true;
+}
+
+void KeepFrameAnimating(void) {
+    frameAnimating = true;
+}
+
+void KeepFrameAwake(void) {
+    frameAwake = true;
+}
+
+void ScheduleFrameAt(double time) {
+    if (scheduledFrameTime < 0.0 || time < scheduledFrameTime) {
+        scheduledFrameTime = time;
+    }
+}
+
+bool ShouldRenderFrame(void) {
+    if (frameDirty || frameAnimating) {
+        if (frameAnimating && lastFrameAnimated) RecordFrameTime(GetFrameTime());
+        lastFrameAnimated = frameAnimating;
+        frameDirty = false;
+        pacerStats.framesRendered++;
+        return true;
+    }
+
+    lastFrameAnimated = false;
+    pacerStats.framesSkipped++;
+    return false;
+}
+
+void WaitForNextFrame(void) {
+    if (frameAwake || scheduledFrameTime >= 0.0) {
+        // 有定时重绘或后台工作：短暂休眠后继续轮询，保证输入仍能及时响应
+        double wait = FRAME_PACER_POLL_INTERVAL;
+        if (scheduledFrameTime >= 0.0) {
+            double untilScheduled = scheduledFrameTime - GetTime();
+            if (untilScheduled < wait) wait = untilScheduled;
+        }
+        if (wait > 0.0) WaitTime(wait);
+        PollInputEvents();
+        return;
+    }
+
+    // 完全空闲：阻塞直到有窗口或输入事件
+    pacerStats.idleWaits++;
+    EnableEventWaiting();
+    PollInputEvents();
+    DisableEventWaiting();
+}
+
+FramePacerStats GetFramePacerStats(void) {
+    return pacerStats;
+}
+
+void LogFramePacerStats(void) {
+    unsigned long total = pacerStats.framesRendered + pacerStats.framesSkipped;
+    TraceLog(LOG_INFO, "帧统计: 绘制 %lu 帧, 跳过 %lu 帧 (%.1f%%), 空闲等待 %lu 次",
+             pacerStats.framesRendered, pacerStats.framesSkipped,
+             total > 0 ? 100.0 * pacerStats.framesSkipped / total : 0.0,
+             pacerStats.idleWaits);
+
+    char line[256];
+    int length = 0;
+    for (int b = 0; b < FRAME_TIME_BUCKETS && length < (int)sizeof(line); b++) {
+        if (b < FRAME_TIME_BUCKETS - 1) {
+            length += snprintf(line + length, sizeof(line) - length, " <%.0fms:%lu",
+                               frameTimeBucketLimits[b], pacerStats.frameTimeHistogram[b]);
+        } else {
+            length += snprintf(line + length, sizeof(line) - length, " >=%.0fms:%lu",
+                               frameTimeBucketLimits[b - 1], pacerStats.frameTimeHistogram[b]);
+        }
+    }
+    TraceLog(LOG_INFO, "动画帧间隔分布:%s", line);
+}
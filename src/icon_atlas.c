@@ -0,0 +1,99 @@
+#include "icon_atlas.h"
+#include <string.h>
+
+#define ICON_ATLAS_COLUMNS 4
+#define ICON_WHITE_SIZE 8        // 白色区域大小，只取中心部分，过滤时不会采样到边缘
+
+void SetIconSource(IconAtlas *atlas, IconId id, const char *fileName) {
+    strncpy(atlas->files[id], fileName, sizeof(atlas->files[id]) - 1);
+}
+
+bool PrepareIconAtlas(IconAtlas *atlas) {
+    const int cellSize = ICON_CELL_SIZE + 2*ICON_CELL_PADDING;
+    const int cellCount = ICON_COUNT + 1;   // 最后一格放白色区域
+    const int rows = (cellCount + ICON_ATLAS_COLUMNS - 1) / ICON_ATLAS_COLUMNS;
+
+    // 宽高取 2 的幂，兼容不支持 NPOT 纹理的设备
+    int width = 1;
+    int height = 1;
+    while (width < ICON_ATLAS_COLUMNS * cellSize) width *= 2;
+    while (height < rows * cellSize) height *= 2;
+
+    atlas->image = GenImageColor(width, height, BLANK);
+
+    for (int i = 0; i < ICON_COUNT; i++) {
+        int x = (i % ICON_ATLAS_COLUMNS) * cellSize + ICON_CELL_PADDING;
+        int y = (i / ICON_ATLAS_COLUMNS) * cellSize + ICON_CELL_PADDING;
+        atlas->rects[i] = (Rectangle){ (float)x, (float)y, ICON_CELL_SIZE, ICON_CELL_SIZE };
+        atlas->present[i] = false;
+
+        if (atlas->files[i][0] == '\0') continue;
+        if (!FileExists(atlas->files[i])) {
+            TraceLog(LOG_WARNING, "图标文件未找到: %s", atlas->files[i]);
+            continue;
+        }
+
+        Image icon = LoadImage(atlas->files[i]);
+        if (icon.data == NULL) {
+            TraceLog(LOG_WARNING, "图标加载失败: %s", atlas->files[i]);
+            continue;
+        }
+
+        ImageFormat(&icon, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        ImageResize(&icon, ICON_CELL_SIZE, ICON_CELL_SIZE);
+        ImageDraw(&atlas->image, icon,
+                  (Rectangle){ 0, 0, (float)icon.width, (float)icon.height },
+                  atlas->rects[i], WHITE);
+        UnloadImage(icon);
+        atlas->present[i] = true;
+    }
+
+    int whiteX = (ICON_COUNT % ICON_ATLAS_COLUMNS) * cellSize + ICON_CELL_PADDING;
+    int whiteY = (ICON_COUNT / ICON_ATLAS_COLUMNS) * cellSize + ICON_CELL_PADDING;
+    ImageDrawRectangle(&atlas->image, whiteX, whiteY, ICON_WHITE_SIZE, ICON_WHITE_SIZE, WHITE);
+    atlas->whiteRect = (Rectangle){ whiteX + ICON_WHITE_SIZE/2 - 1.0f, whiteY + ICON_WHITE_SIZE/2 - 1.0f, 2.0f, 2.0f };
+
+    return atlas->image.data != NULL;
+}
+
+bool FinishIconAtlas(IconAtlas *atlas) {
+    if (atlas->image.data == NULL) return false;
+
+    atlas->texture = LoadTextureFromImage(atlas->image);
+    UnloadImage(atlas->image);
+    atlas->image = (Image){0};
+    if (atlas->texture.id == 0) return false;
+
+    SetTextureFilter(atlas->texture, TEXTURE_FILTER_BILINEAR);
+
+    // 形状也从图集的白色区域采样，图标与形状之间不再切换纹理
+    atlas->previousShapes = GetShapesTexture();
+    atlas->previousShapesRect = GetShapesTextureRectangle();
+    SetShapesTexture(atlas->texture, atlas->whiteRect);
+    atlas->shapesBound = true;
+
+    TraceLog(LOG_INFO, "图标图集: %dx%d, %d 个图标", atlas->texture.width, atlas->texture.height, ICON_COUNT);
+    return true;
+}
+
+void UnloadIconAtlas(IconAtlas *atlas) {
+    if (atlas->shapesBound) {
+        SetShapesTexture(atlas->previousShapes, atlas->previousShapesRect);
+        atlas->shapesBound = false;
+    }
+    if (atlas->texture.id != 0) {
+        UnloadTexture(atlas->texture);
+        atlas->texture = (Texture2D){0};
+    }
+    if (atlas->image.data != NULL) {
+        UnloadImage(atlas->image);
+        atlas->image = (Image){0};
+    }
+}
+
+bool DrawIcon(const IconAtlas *atlas, IconId id, Rectangle dest, Color tint) {
+    if (atlas->texture.id == 0 || !atlas->present[id]) return false;
+
+    DrawTexturePro(atlas->texture, atlas->rects[id], dest, (Vector2){0, 0}, 0.0f, tint);
+    return true;
+}
@@ -1,4 +1,5 @@
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -8,11 +9,25 @@
 #include "../include/trash.h"
 #include "../include/data.h"
 #include "../include/achievement.h"
+#include "../include/font_cache.h"
+#include "../include/asset_loader.h"
+#include "../include/worker_pool.h"
+#include "../include/texture_residency.h"
+#include "../include/icon_atlas.h"
+#include "../include/frame_pacer.h"
+#include "../include/ui_layer.h"
+#include "../include/text_cache.h"
+#include "../include/atomic_file.h"
+#include "../include/state_journal.h"
+#include "../include/session_history.h"
 
 // 初始屏幕尺寸
 #define INIT_WIDTH 800
 #define INIT_HEIGHT 600
 #define STUDY_IMAGE_COUNT 8
+#define STUDY_IMAGE_SCALE 0.35f   // 学习图片的绘制缩放，加载时直接缩放到该尺寸
+#define MAX_CLEANUP_TRASH 16      // 一次框选最多清理的垃圾数
+#define TRASH_DRAG_THRESHOLD 6.0f // 按下后移动超过该距离才算框选，否则按单击处理
 
 typedef struct {
     float intensity;
@@ -61,8 +76,10 @@ typedef struct {
     // 资源
     Font textFont;
     Font titleFont;
-    Texture2D achieveIcon;
-    Texture2D studyImages[STUDY_IMAGE_COUNT];
+    IconAtlas icons;      // 所有界面图标（含主题、成就、统计图标）
+    UILayer mainLayer;         // 主界面静态层
+    UILayer achievementLayer;  // 成就界面静态层
+    int studyImageSlots[STUDY_IMAGE_COUNT];  // 学习图片的纹理驻留槽位
     
     // 成就系统
     AchievementManager achievementManager;
@@ -83,35 +100,34 @@ typedef struct {
     double lastUpdateTime;
     
     // 垃圾系统
-    int currentTrashIndex;
+    TrashHandle cleanupTrash[MAX_CLEANUP_TRASH];  // 正在清理的垃圾（单击一个或框选多个）
+    int cleanupTrashCount;
     int cleanupDuration;
+    bool selectingTrash;           // 鼠标按下后尚未松开，松开时按单击或框选处理
+    Vector2 selectStart;
     
     // 学习图片
     int currentStudyImage;
+    int nextStudyImage;    // 预取的下一张
 
     WindowShake windowShake;
 
     // 新增皮肤主题变量
     bool isDarkTheme;
-    Texture2D themeIcon;  // 皮肤主题图标
-    Texture2D sunTexture;  // 太阳图标
-    Texture2D moonTexture; // 月亮图标
-    // 成就图标（根据不同主题）
-    Texture2D achieveIconLight;
-    Texture2D achieveIconDark;
-
-    // 数据统计
+
+    // 数据统计：计数只存在 metrics 中，statistics 是它的派生视图
+    MetricsStore metrics;
     Statistics statistics;
     const char *statisticsFile;
-    Texture2D dateIconLight;  // 亮色主题统计图标
-    Texture2D dateIconDark;   // 暗色主题统计图标
+    SessionHistory history;    // 每次计时的记录，统计界面的图表由它的按天索引计算
     Texture2D themeIconDark;
     Texture2D themeIconLight;
+
+    double lastSnapshotTime;   // 上次写状态快照的时间
 } AppState;
 
 // 函数声明
 static const char* GetResourcePath(const char* relativePath);
-static int* GenerateCJKCodepoints(int *codepointCount);
 void DrawAchievements(AppState *state, float screenWidth, float screenHeight);
 void DrawMainScreen(AppState *state, float screenWidth, float screenHeight);
 void DrawTimerScreen(AppState *state, float screenWidth, float screenHeight);
@@ -122,7 +138,6 @@ void HandleMainScreenInput(AppState *state, float screenWidth, float screenHeigh
 bool LoadResources(AppState *state);
 void UnloadResources(AppState *state);
 void TriggerWindowShake(AppState *state, float intensity, float duration);
-int* GenerateEssentialCodepoints(int* count);
 
     
 #if defined(_WIN32)
@@ -139,6 +154,40 @@ static const char* GetResourcePath(const char* relativePath) {
     return fullPath;
 }
 
+// 开始新的计时时切换学习图片：使用预取好的图片，并在后台预取下一张；
+// 预取的图片要等到下一次计时才显示，期间固定在显存中，不因闲置超时被卸载
+static void PickStudyImage(AppState *state) {
+    SetResidentTexturePinned(state->studyImageSlots[state->nextStudyImage], false);
+    state->currentStudyImage = state->nextStudyImage;
+    state->nextStudyImage = GetRandomValue(0, STUDY_IMAGE_COUNT - 1);
+    RequestResidentTexture(state->studyImageSlots[state->currentStudyImage]);
+    RequestResidentTexture(state->studyImageSlots[state->nextStudyImage]);
+    SetResidentTexturePinned(state->studyImageSlots[state->nextStudyImage], true);
+}
+
+// 清理列表中仍然存在的垃圾数，为 0 时计时界面按普通番茄钟处理
+static int CountCleanupTrash(const AppState *state) {
+    int count = 0;
+    for (int i = 0; i < state->cleanupTrashCount; i++) {
+        if (IsTrashHandleValid(state->cleanupTrash[i])) count++;
+    }
+    return count;
+}
+
+// 框选矩形，允许向任意方向拖动
+static Rectangle GetTrashSelectRect(Vector2 start, Vector2 end) {
+    return (Rectangle){
+        fminf(start.x, end.x),
+        fminf(start.y, end.y),
+        fabsf(end.x - start.x),
+        fabsf(end.y - start.y)
+    };
+}
+
+static bool IsTrashDragSelecting(const AppState *state) {
+    return state->selectingTrash && Vector2Distance(state->selectStart, GetMousePosition()) >= TRASH_DRAG_THRESHOLD;
+}
+
 void TriggerWindowShake(AppState *state, float intensity, float duration) {
     if (intensity > state->windowShake.intensity) {
         state->windowShake.intensity = intensity;
@@ -147,49 +196,57 @@ void TriggerWindowShake(AppState *state, float intensity, float duration) {
     }
 }
 
-// 辅助函数：生成完整的 CJK 字符集
-static int* GenerateCJKCodepoints(int *codepointCount) {
-    int *codepoints = NULL;
-    int count = 0;
-    
-    // 基本 Latin 字符（ASCII）
-    for (int c = 0x0020; c <= 0x007E; c++) {
-        codepoints = (int*)realloc(codepoints, (count + 1) * sizeof(int));
-        codepoints[count++] = c;
-    }
-    
-    // 拉丁补充
-    for (int c = 0x00A0; c <= 0x00FF; c++) {
-        codepoints = (int*)realloc(codepoints, (count + 1) * sizeof(int));
-        codepoints[count++] = c;
-    }
-    
-    // CJK 符号和标点
-    for (int c = 0x3000; c <= 0x303F; c++) {
-        codepoints = (int*)realloc(codepoints, (count + 1) * sizeof(int));
-        codepoints[count++] = c;
-    }
-    
-    // CJK 统一表意文字块
-    for (int c = 0x4E00; c <= 0x9FFF; c++) {
-        codepoints = (int*)realloc(codepoints, (count + 1) * sizeof(int));
-        codepoints[count++] = c;
+// 推进震动计时，返回震动是否仍在进行
+static bool UpdateWindowShake(AppState *state, float deltaTime) {
+    WindowShake *shake = &state->windowShake;
+    if (shake->intensity <= 0.0f) return false;
+
+    shake->timer += deltaTime;
+    shake->intensity *= shake->decay;
+    if (shake->timer >= shake->duration || shake->intensity < 0.1f) {
+        shake->intensity = 0.0f;
+        return false;
     }
-    
-    *codepointCount = count;
-    return codepoints;
+    return true;
 }
 
-// 保存主题状态到文件
-void SaveAppThemeState(bool isDarkTheme) {
-    FILE *file = fopen("theme_state.dat", "wb");
-    if (file) {
-        fwrite(&isDarkTheme, sizeof(bool), 1, file);
-        fclose(file);
-    }
+// 界面中出现的固定文本，用于初始化字形缓存（其余字符在首次绘制时按需光栅化）
+static const char *uiTextSeed[] = {
+    "番茄钟", "成就", "数据统计", "返回", "确定", "自定义", "分钟",
+    "输入分钟数", "点击输入分钟数 30-120", "请输入30-120之间的数字",
+    "清理垃圾: 专注工作: ", "注意: 切换窗口将中断计时并产生垃圾",
+    "空格键: 开始/暂停  R键: 重置",
+    "总番茄钟: | 清理垃圾: | 产生垃圾: | 中断次数: | 连续天数: ",
+    "成长徽章", "改进空间", "专注被打断!", "已产生垃圾!请返回主界面清理",
+    "清理失败!", "请完成整个番茄钟来清理垃圾", "未知屏幕状态",
+    "总番茄钟数:", "清理垃圾数:", "产生垃圾数:", "中断次数:", "最长连续天数:",
+    "长时间专注次数:", "番茄钟分布统计",
+    "近14天专注", "近12周专注", "近12个月专注", "月"
+};
+
+// 拼接界面文本与成就名称/描述，作为字形缓存的初始字符集
+static char* BuildGlyphSeedText(void) {
+    size_t length = 1;
+    for (size_t i = 0; i < sizeof(uiTextSeed)/sizeof(uiTextSeed[0]); i++) {
+        length += strlen(uiTextSeed[i]);
+    }
+    for (int i = 0; i < GetAchievementDefCount(); i++) {
+        length += strlen(GetAchievementDef(i)->name) + strlen(GetAchievementDef(i)->description);
+    }
+
+    char *seed = (char*)malloc(length);
+    seed[0] = '\0';
+    for (size_t i = 0; i < sizeof(uiTextSeed)/sizeof(uiTextSeed[0]); i++) {
+        strcat(seed, uiTextSeed[i]);
+    }
+    for (int i = 0; i < GetAchievementDefCount(); i++) {
+        strcat(seed, GetAchievementDef(i)->name);
+        strcat(seed, GetAchievementDef(i)->description);
+    }
+    return seed;
 }
 
-// 从文件加载主题状态
+// 从旧版本的主题文件加载主题状态
 bool LoadAppThemeState() {
     FILE *file = fopen("theme_state.dat", "rb");
     bool isDarkTheme = false;
@@ -200,6 +257,56 @@ bool LoadAppThemeState() {
     return isDarkTheme;
 }
 
+// 主界面静态内容
+static void DrawMainScreenLayer(AppState *state, float screenWidth, float screenHeight) {
+    // 设置背景色 - 根据主题变化
+    if (state->isDarkTheme) {
+        ClearBackground((Color){30, 30, 40, 255}); // 暗色背景
+    } else {
+        ClearBackground(RAYWHITE); // 亮色背景
+    }
+    
+    // 定义主题颜色
+    Color titleColor = state->isDarkTheme ? LIGHTGRAY : DARKGRAY;
+    Color textColor = state->isDarkTheme ? LIGHTGRAY : DARKGRAY;
+    Color borderColor = state->isDarkTheme ? LIGHTGRAY : DARKGRAY;
+    Color highlightColor = state->isDarkTheme ? GOLD : SKYBLUE;
+    
+    // 标题
+    const char* title = "番茄钟";
+    Vector2 titleSize = MeasureTextCached(&state->titleFont, title, state->titleFont.baseSize, 1);
+    DrawTextCached(&state->titleFont, title, 
+             (Vector2){screenWidth/2.0f - titleSize.x/2.0f, 80.0f}, 
+             state->titleFont.baseSize, 1, titleColor);
+    
+    // 预设选项 - 简约线条设计
+    const int presetCount = 3;
+    const float presetSpacing = 80.0f;
+    const float presetStartY = 180.0f;
+    
+    for (int i = 0; i < presetCount; i++) {
+        float rectY = presetStartY + i * presetSpacing;
+        Rectangle rect = {
+            screenWidth/2.0f - 150.0f,
+            rectY,
+            300.0f,
+            50.0f
+        };
+        
+        Color border = i == state->selectedPreset ? highlightColor : borderColor;
+        
+        // 简约线条边框
+        DrawRectangleLinesEx(rect, 1.5f, border);
+        
+        const char *text = state->presets[i].name;
+        Vector2 textSize = MeasureTextCached(&state->textFont, text, 30, 1);
+        DrawTextCached(&state->textFont, text, 
+                 (Vector2){rect.x + rect.width/2.0f - textSize.x/2.0f, 
+                          rect.y + rect.height/2.0f - textSize.y/2.0f},
+                 30, 1, textColor);
+    }
+}
+
 // 极简风格主界面
 void DrawMainScreen(AppState *state, float screenWidth, float screenHeight) {
     // 顶部按钮区域参数
@@ -212,27 +319,21 @@ void DrawMainScreen(AppState *state, float screenWidth, float screenHeight) {
     float groupWidth = 3 * buttonSize + 2 * buttonSpacing;
     float startX = screenWidth - groupWidth - groupRightMargin;
 
-    // 设置背景色 - 根据主题变化
-    if (state->isDarkTheme) {
-        ClearBackground((Color){30, 30, 40, 255}); // 暗色背景
-    } else {
-        ClearBackground(RAYWHITE); // 亮色背景
+    // 静态层：背景、标题、预设选项，仅在尺寸、主题、选中项变化时重绘
+    unsigned long long layerKey = HashUILayerData(UI_LAYER_HASH_SEED, &state->isDarkTheme, sizeof(state->isDarkTheme));
+    layerKey = HashUILayerData(layerKey, &state->selectedPreset, sizeof(state->selectedPreset));
+    if (BeginUILayer(&state->mainLayer, (int)screenWidth, (int)screenHeight, layerKey)) {
+        DrawMainScreenLayer(state, screenWidth, screenHeight);
+        EndUILayer(&state->mainLayer);
     }
+    DrawUILayer(&state->mainLayer);
     
     // 定义主题颜色
-    Color titleColor = state->isDarkTheme ? LIGHTGRAY : DARKGRAY;
     Color textColor = state->isDarkTheme ? LIGHTGRAY : DARKGRAY;
     Color borderColor = state->isDarkTheme ? LIGHTGRAY : DARKGRAY;
     Color highlightColor = state->isDarkTheme ? GOLD : SKYBLUE;
     Color grayColor = state->isDarkTheme ? GRAY : LIGHTGRAY;
     
-    // 标题
-    const char* title = "番茄钟";
-    Vector2 titleSize = MeasureTextEx(state->titleFont, title, state->titleFont.baseSize, 1);
-    DrawTextEx(state->titleFont, title, 
-             (Vector2){screenWidth/2.0f - titleSize.x/2.0f, 80.0f}, 
-             state->titleFont.baseSize, 1, titleColor);
-    
     // === 统计按钮 ===
     Rectangle statisticsButton = {
         startX,
@@ -242,18 +343,14 @@ void DrawMainScreen(AppState *state, float screenWidth, float screenHeight) {
     };
     bool hoverStatistics = CheckCollisionPointRec(GetMousePosition(), statisticsButton);
     
-    // 根据主题选择图标
-    Texture2D dateIcon = state->isDarkTheme ? state->dateIconDark : state->dateIconLight;
+    // 根据主题选择图标（顶部按钮图标均来自同一图集，整排按钮在同一批次中绘制）
+    IconId dateIcon = state->isDarkTheme ? ICON_DATE_DARK : ICON_DATE_LIGHT;
+    Color statisticsTint = hoverStatistics ? 
+               (state->isDarkTheme ? GOLD : SKYBLUE) : 
+               (state->isDarkTheme ? LIGHTGRAY : GRAY);
     
-    if (dateIcon.id != 0) {
-        Color tint = hoverStatistics ? 
-                   (state->isDarkTheme ? GOLD : SKYBLUE) : 
-                   (state->isDarkTheme ? LIGHTGRAY : GRAY);
-        
-        Rectangle source = {0, 0, (float)dateIcon.width, (float)dateIcon.height};
-        Rectangle dest = {statisticsButton.x, statisticsButton.y, 50.0f, 50.0f};
-        DrawTexturePro(dateIcon, source, dest, (Vector2){0, 0}, 0.0f, tint);
-    } else {
+    if (!DrawIcon(&state->icons, dateIcon, 
+                  (Rectangle){statisticsButton.x, statisticsButton.y, 50.0f, 50.0f}, statisticsTint)) {
         // 简约圆形按钮（备用）
         DrawCircleLines(statisticsButton.x + buttonSize/2, statisticsButton.y + buttonSize/2, buttonSize/2 - 5, 
                       hoverStatistics ? 
@@ -273,17 +370,13 @@ void DrawMainScreen(AppState *state, float screenWidth, float screenHeight) {
     bool hoverTheme = CheckCollisionPointRec(GetMousePosition(), themeButton);
     
     // 使用明暗主题分离的图标
-    Texture2D themeIcon = state->themeIcon;
+    IconId themeIcon = state->isDarkTheme ? ICON_MOON : ICON_SUN;
+    Color themeTint = hoverTheme ? 
+            (state->isDarkTheme ? GOLD : SKYBLUE) : 
+            (state->isDarkTheme ? LIGHTGRAY : GRAY);
     
-    if (themeIcon.id != 0) {
-        Color tint = hoverTheme ? 
-                (state->isDarkTheme ? GOLD : SKYBLUE) : 
-                (state->isDarkTheme ? LIGHTGRAY : GRAY);
-        
-        Rectangle source = {0, 0, (float)themeIcon.width, (float)themeIcon.height};
-        Rectangle dest = {themeButton.x, themeButton.y, buttonSize, buttonSize};
-        DrawTexturePro(themeIcon, source, dest, (Vector2){0, 0}, 0.0f, tint);
-    } else {
+    if (!DrawIcon(&state->icons, themeIcon, 
+                  (Rectangle){themeButton.x, themeButton.y, buttonSize, buttonSize}, themeTint)) {
         // 简约圆形按钮
         DrawCircleLines(themeButton.x + buttonSize/2, themeButton.y + buttonSize/2, buttonSize/2 - 5, 
                       hoverTheme ? highlightColor : grayColor);
@@ -300,17 +393,13 @@ void DrawMainScreen(AppState *state, float screenWidth, float screenHeight) {
     bool hoverAchievement = CheckCollisionPointRec(GetMousePosition(), achievementButton);
     
     // 根据主题选择成就图标
-    Texture2D achieveIcon = state->isDarkTheme ? state->achieveIconDark : state->achieveIconLight;
+    IconId achieveIcon = state->isDarkTheme ? ICON_ACHIEVE_DARK : ICON_ACHIEVE_LIGHT;
+    Color achievementTint = hoverAchievement ? 
+               (state->isDarkTheme ? GOLD : SKYBLUE) : 
+               (state->isDarkTheme ? LIGHTGRAY : GRAY);
     
-    if (achieveIcon.id != 0) {
-        Color tint = hoverAchievement ? 
-                   (state->isDarkTheme ? GOLD : SKYBLUE) : 
-                   (state->isDarkTheme ? LIGHTGRAY : GRAY);
-        
-        Rectangle source = {0, 0, (float)achieveIcon.width, (float)achieveIcon.height};
-        Rectangle dest = {achievementButton.x, achievementButton.y, buttonSize, buttonSize};
-        DrawTexturePro(achieveIcon, source, dest, (Vector2){0, 0}, 0.0f, tint);
-    } else {
+    if (!DrawIcon(&state->icons, achieveIcon, 
+                  (Rectangle){achievementButton.x, achievementButton.y, buttonSize, buttonSize}, achievementTint)) {
         // 简约圆形按钮（备用）
         DrawCircleLines(achievementButton.x + buttonSize/2, achievementButton.y + buttonSize/2, buttonSize/2 - 5, 
                       hoverAchievement ? 
@@ -320,35 +409,31 @@ void DrawMainScreen(AppState *state, float screenWidth, float screenHeight) {
                state->isDarkTheme ? LIGHTGRAY : GRAY);
     }
     
-    // 预设选项 - 简约线条设计
+    // 预设选项（边框与文字在静态层中）
     const int presetCount = 3;
     const float presetSpacing = 80.0f;
     const float presetStartY = 180.0f;
-    
-    for (int i = 0; i < presetCount; i++) {
-        float rectY = presetStartY + i * presetSpacing;
-        Rectangle rect = {
-            screenWidth/2.0f - 150.0f,
-            rectY,
-            300.0f,
-            50.0f
-        };
-        
-        bool hover = CheckCollisionPointRec(GetMousePosition(), rect);
-        Color border = i == state->selectedPreset ? highlightColor : borderColor;
-        
-        // 简约线条边框
-        DrawRectangleLinesEx(rect, 1.5f, border);
-        
-        const char *text = state->presets[i].name;
-        Vector2 textSize = MeasureTextEx(state->textFont, text, 30, 1);
-        DrawTextEx(state->textFont, text, 
-                 (Vector2){rect.x + rect.width/2.0f - textSize.x/2.0f, 
-                          rect.y + rect.height/2.0f - textSize.y/2.0f},
-                 30, 1, textColor);
-    }
 
     DrawTrash();  // 绘制垃圾
+
+    // 框选中的垃圾与鼠标下的垃圾加边框（网格查询，不逐个遍历）
+    if (IsTrashDragSelecting(state)) {
+        Rectangle selectRect = GetTrashSelectRect(state->selectStart, GetMousePosition());
+        TrashHandle selected[MAX_CLEANUP_TRASH];
+        int selectedCount = FindTrashInRect(selectRect, selected, MAX_CLEANUP_TRASH);
+        if (selectedCount > MAX_CLEANUP_TRASH) selectedCount = MAX_CLEANUP_TRASH;
+
+        DrawRectangleRec(selectRect, Fade(highlightColor, 0.15f));
+        DrawRectangleLinesEx(selectRect, 1.0f, highlightColor);
+        for (int i = 0; i < selectedCount; i++) {
+            Rectangle rect;
+            if (GetTrashDrawRect(selected[i], &rect)) DrawRectangleLinesEx(rect, 2.0f, highlightColor);
+        }
+    } else {
+        // 边框跟随插值后的绘制位置，低步频下不会落后于方块
+        Rectangle rect;
+        if (GetTrashDrawRect(FindTrashAt(GetMousePosition()), &rect)) DrawRectangleLinesEx(rect, 2.0f, highlightColor);
+    }
     
     // 自定义输入框 - 简约设计（位置调整）
     const float inputY = presetStartY + presetCount * presetSpacing + 20.0f;
@@ -368,8 +453,8 @@ void DrawMainScreen(AppState *state, float screenWidth, float screenHeight) {
             strcpy(displayText, "输入分钟数");
         }
         
-        Vector2 textSize = MeasureTextEx(state->textFont, displayText, 30, 1);
-        DrawTextEx(state->textFont, displayText, 
+        Vector2 textSize = MeasureTextCached(&state->textFont, displayText, 30, 1);
+        DrawTextCached(&state->textFont, displayText, 
                  (Vector2){inputRect.x + inputRect.width/2.0f - textSize.x/2.0f, 
                           inputRect.y + inputRect.height/2.0f - textSize.y/2.0f},
                  30, 1, textColor);
@@ -377,8 +462,8 @@ void DrawMainScreen(AppState *state, float screenWidth, float screenHeight) {
         // 提示文本
         if (strlen(state->customMinutes) == 0 && !state->editingCustom) {
             const char* hint = "点击输入分钟数 30-120";
-            Vector2 hintSize = MeasureTextEx(state->textFont, hint, 20, 1);
-            DrawTextEx(state->textFont, hint, 
+            Vector2 hintSize = MeasureTextCached(&state->textFont, hint, 20, 1);
+            DrawTextCached(&state->textFont, hint, 
                      (Vector2){inputRect.x + inputRect.width/2.0f - hintSize.x/2.0f, 
                               inputRect.y + inputRect.height + 10.0f}, 
                      20, 1, grayColor);
@@ -411,42 +496,45 @@ void DrawTimerScreen(AppState *state, float screenWidth, float screenHeight) {
     int fontSize = state->titleFont.baseSize;
     Color timerColor = state->timerActive ? timerActiveColor : timerInactiveColor;
     
-    Vector2 timeSize = MeasureTextEx(state->titleFont, timeText, fontSize, 1);
+    Vector2 timeSize = MeasureTextCached(&state->titleFont, timeText, fontSize, 1);
     Vector2 position = {screenWidth/2.0f - timeSize.x/2.0f, 50.0f};
     
-    DrawTextEx(state->titleFont, timeText, position, fontSize, 1, timerColor);
+    DrawTextCached(&state->titleFont, timeText, position, fontSize, 1, timerColor);
 
     // 简约分隔线
     DrawLine(0, 120, screenWidth, 120, separatorColor);
     
     // 显示当前任务
     char taskText[50];
-    if (state->currentTrashIndex >= 0) {
+    int cleanupCount = CountCleanupTrash(state);
+    if (cleanupCount > 1) {
+        sprintf(taskText, "清理%d个垃圾: %d分钟", cleanupCount, state->cleanupDuration / 60);
+    } else if (cleanupCount == 1) {
         sprintf(taskText, "清理垃圾: %d分钟", state->cleanupDuration / 60);
     } else {
         sprintf(taskText, "专注工作: %d分钟", state->pomodoroDuration / 60);
     }
     
-    Vector2 taskSize = MeasureTextEx(state->textFont, taskText, 28, 1);
-    DrawTextEx(state->textFont, taskText, 
+    Vector2 taskSize = MeasureTextCached(&state->textFont, taskText, 28, 1);
+    DrawTextCached(&state->textFont, taskText, 
              (Vector2){screenWidth/2.0f - taskSize.x/2.0f, 140.0f}, 
              28, 1, textColor);
     
     // 简约警告文本
     const char *warningText = "注意: 切换窗口将中断计时并产生垃圾";
-    Vector2 warningSize = MeasureTextEx(state->textFont, warningText, 20, 1);
-    DrawTextEx(state->textFont, warningText, 
+    Vector2 warningSize = MeasureTextCached(&state->textFont, warningText, 20, 1);
+    DrawTextCached(&state->textFont, warningText, 
              (Vector2){screenWidth/2.0f - warningSize.x/2.0f, 180.0f}, 
              20, 1, hintColor);
     
     // 显示学习图片 - 移除边框，深色主题下添加背景色
+    Texture2D currentImage = {0};
     if (state->currentStudyImage >= 0 && state->currentStudyImage < STUDY_IMAGE_COUNT && 
-        state->studyImages[state->currentStudyImage].id != 0) {
+        AcquireResidentTexture(state->studyImageSlots[state->currentStudyImage], &currentImage)) {
         
-        Texture2D currentImage = state->studyImages[state->currentStudyImage];
-        float imageScale = 0.35f;
-        float imageWidth = currentImage.width * imageScale;
-        float imageHeight = currentImage.height * imageScale;
+        // 纹理加载时已缩放到 STUDY_IMAGE_SCALE，按原尺寸绘制
+        float imageWidth = (float)currentImage.width;
+        float imageHeight = (float)currentImage.height;
         
         Vector2 imagePos = {
             screenWidth / 2 - imageWidth / 2,
@@ -462,19 +550,20 @@ void DrawTimerScreen(AppState *state, float screenWidth, float screenHeight) {
         }
         
         // 绘制图片
-        DrawTextureEx(currentImage, imagePos, 0.0f, imageScale, WHITE);
+        DrawTextureEx(currentImage, imagePos, 0.0f, 1.0f, WHITE);
     }
 
     const char *timerHint = "空格键: 开始/暂停  R键: 重置";
-    Vector2 timerHintSize = MeasureTextEx(state->textFont, timerHint, 20, 1);
-    DrawTextEx(state->textFont, timerHint, 
+    Vector2 timerHintSize = MeasureTextCached(&state->textFont, timerHint, 20, 1);
+    DrawTextCached(&state->textFont, timerHint, 
             (Vector2){screenWidth/2.0f - timerHintSize.x/2.0f, 
                     screenHeight - 40.0f}, 
             20, 1, hintColor);
 }
 
 // 极简风格成就界面
-void DrawAchievements(AppState *state, float screenWidth, float screenHeight) {
+// 成就界面静态内容：头部、两侧面板及成就列表（按当前滚动位置）
+static void DrawAchievementsLayer(AppState *state, float screenWidth, float screenHeight) {
     // 设置背景色
     if (state->isDarkTheme) {
         ClearBackground((Color){30, 30, 40, 255});
@@ -484,7 +573,6 @@ void DrawAchievements(AppState *state, float screenWidth, float screenHeight) {
     
     // 定义主题颜色
     Color titleColor = state->isDarkTheme ? GOLD : BLACK;
-    Color textColor = state->isDarkTheme ? LIGHTGRAY : DARKGRAY;
     Color statsColor = state->isDarkTheme ? LIGHTGRAY : DARKGRAY;
     Color positivePanelBg = state->isDarkTheme ? (Color){40, 50, 40, 255} : (Color){245, 255, 245, 255};
     Color positivePanelBorder = state->isDarkTheme ? (Color){60, 80, 60, 255} : (Color){220, 240, 220, 255};
@@ -504,18 +592,19 @@ void DrawAchievements(AppState *state, float screenWidth, float screenHeight) {
     
     // 标题
     const char* title = "成就";
-    Vector2 titleSize = MeasureTextEx(*titleFont, title, 60, 2);
-    DrawTextEx(*titleFont, title, 
+    Vector2 titleSize = MeasureTextCached(titleFont, title, 60, 2);
+    DrawTextCached(titleFont, title, 
              (Vector2){screenWidth/2.0f - titleSize.x/2.0f, 30.0f}, 
              60, 2, titleColor);
     
     // 统计信息
     char statsText[256];
     sprintf(statsText, "总番茄钟: %d | 清理垃圾: %d | 产生垃圾: %d | 中断次数: %d | 连续天数: %d", 
-            manager->totalPomodoros, manager->cleanedTrashCount, manager->generatedTrashCount,
-            manager->interruptionsCount, manager->streakDays);
-    Vector2 statsSize = MeasureTextEx(*textFont, statsText, 20, 1);
-    DrawTextEx(*textFont, statsText, 
+            GetMetric(&state->metrics, METRIC_TOTAL_POMODOROS), GetMetric(&state->metrics, METRIC_CLEANED_TRASH),
+            GetMetric(&state->metrics, METRIC_GENERATED_TRASH), GetMetric(&state->metrics, METRIC_INTERRUPTIONS),
+            GetMetric(&state->metrics, METRIC_STREAK_DAYS));
+    Vector2 statsSize = MeasureTextCached(textFont, statsText, 20, 1);
+    DrawTextCached(textFont, statsText, 
              (Vector2){screenWidth/2.0f - statsSize.x/2.0f, 100.0f}, 
              20, 1, statsColor);
     
@@ -538,53 +627,36 @@ void DrawAchievements(AppState *state, float screenWidth, float screenHeight) {
     
     // 面板标题
     const char* positiveTitle = "成长徽章";
-    Vector2 positiveTitleSize = MeasureTextEx(*textFont, positiveTitle, 30, 1);
-    DrawTextEx(*textFont, positiveTitle, 
+    Vector2 positiveTitleSize = MeasureTextCached(textFont, positiveTitle, 30, 1);
+    DrawTextCached(textFont, positiveTitle, 
              (Vector2){leftPanel.x + leftPanel.width/2 - positiveTitleSize.x/2, 
                       leftPanel.y - 30.0f}, 
              30, 1, state->isDarkTheme ? GOLD : DARKGREEN);
     
     const char* negativeTitle = "改进空间";
-    Vector2 negativeTitleSize = MeasureTextEx(*textFont, negativeTitle, 30, 1);
-    DrawTextEx(*textFont, negativeTitle, 
+    Vector2 negativeTitleSize = MeasureTextCached(textFont, negativeTitle, 30, 1);
+    DrawTextCached(textFont, negativeTitle, 
              (Vector2){rightPanel.x + rightPanel.width/2 - negativeTitleSize.x/2, 
                       rightPanel.y - 30.0f}, 
              30, 1, state->isDarkTheme ? (Color){220, 150, 150, 255} : MAROON);
     
-    // 处理滚动
-    Vector2 mousePos = GetMousePosition();
+    // 滚动位置已在 DrawAchievements 中处理并限制范围
     float *positiveScroll = &state->positiveScrollOffset;
     float *negativeScroll = &state->negativeScrollOffset;
     
-    // 左侧面板滚动
-    if (CheckCollisionPointRec(mousePos, leftPanel)) {
-        float wheel = GetMouseWheelMove();
-        *positiveScroll -= wheel * 30.0f;
-    }
-    
-    // 右侧面板滚动
-    if (CheckCollisionPointRec(mousePos, rightPanel)) {
-        float wheel = GetMouseWheelMove();
-        *negativeScroll -= wheel * 30.0f;
-    }
-    
-    // 限制滚动范围
-    float maxPositiveScroll = (ACH_COUNT * spacing) - panelHeight;
+    float maxPositiveScroll = (manager->achievementCount * spacing) - panelHeight;
     if (maxPositiveScroll < 0) maxPositiveScroll = 0;
-    if (*positiveScroll < 0) *positiveScroll = 0;
-    if (*positiveScroll > maxPositiveScroll) *positiveScroll = maxPositiveScroll;
     
-    float maxNegativeScroll = (NEG_COUNT * spacing) - panelHeight;
+    float maxNegativeScroll = (manager->negativeCount * spacing) - panelHeight;
     if (maxNegativeScroll < 0) maxNegativeScroll = 0;
-    if (*negativeScroll < 0) *negativeScroll = 0;
-    if (*negativeScroll > maxNegativeScroll) *negativeScroll = maxNegativeScroll;
     
     // 绘制左侧面板内容（正面成就）
     BeginScissorMode((int)leftPanel.x, (int)leftPanel.y, (int)leftPanel.width, (int)leftPanel.height);
     {
         float startY = leftPanel.y + 10.0f - *positiveScroll;
         
-        for (int i = 0; i < ACH_COUNT; i++) {
+        // 第一遍只画背景和图标：形状都从图标图集的白色区域采样，整列在同一批次中完成
+        for (int i = 0; i < manager->achievementCount; i++) {
             float yPos = startY + i * spacing;
             
             if (yPos + spacing > leftPanel.y && yPos < leftPanel.y + leftPanel.height) {
@@ -596,38 +668,54 @@ void DrawAchievements(AppState *state, float screenWidth, float screenHeight) {
                 };
                 
                 // 成就背景
-                Color bgColor = manager->achievements[i].unlocked ? 
+                bool unlocked = IsAchievementUnlocked(manager, GetAchievementDefIndex(false, i));
+                Color bgColor = unlocked ? 
                     positivePanelBg : (state->isDarkTheme ? (Color){40, 40, 40, 255} : (Color){250, 250, 250, 255});
                 DrawRectangleRec(achievementRect, bgColor);
                 
                 // 成就图标
-                if (manager->achievements[i].unlocked) {
+                if (unlocked) {
                     DrawCircle(achievementRect.x + 30, achievementRect.y + 25, 15, state->isDarkTheme ? GOLD : (Color){200, 170, 50, 255});
                 } else {
                     DrawCircle(achievementRect.x + 30, achievementRect.y + 25, 15, state->isDarkTheme ? (Color){80, 80, 80, 255} : (Color){230, 230, 230, 255});
                 }
+            }
+        }
+        
+        // 第二遍画文字（字体纹理）
+        for (int i = 0; i < manager->achievementCount; i++) {
+            float yPos = startY + i * spacing;
+            
+            if (yPos + spacing > leftPanel.y && yPos < leftPanel.y + leftPanel.height) {
+                Rectangle achievementRect = {
+                    leftPanel.x + 10.0f,
+                    yPos,
+                    leftPanel.width - 20.0f,
+                    50.0f
+                };
                 
                 // 成就名称和描述
-                Color nameColor = manager->achievements[i].unlocked ? unlockedNameColor : lockedNameColor;
-                Color descColor = manager->achievements[i].unlocked ? unlockedDescColor : lockedDescColor;
+                int def = GetAchievementDefIndex(false, i);
+                bool unlocked = IsAchievementUnlocked(manager, def);
+                Color nameColor = unlocked ? unlockedNameColor : lockedNameColor;
+                Color descColor = unlocked ? unlockedDescColor : lockedDescColor;
                 
-                DrawTextEx(*textFont, manager->achievements[i].name, 
+                DrawTextCached(textFont, GetAchievementDef(def)->name, 
                          (Vector2){achievementRect.x + 60.0f, achievementRect.y + 10.0f}, 
                          22, 1, nameColor);
                 
-                DrawTextEx(*textFont, manager->achievements[i].description, 
+                DrawTextCached(textFont, GetAchievementDef(def)->description, 
                          (Vector2){achievementRect.x + 60.0f, achievementRect.y + 30.0f}, 
                          16, 1, descColor);
                 
                 // 解锁时间
-                if (manager->achievements[i].unlocked) {
-                    time_t unlockTime = manager->achievements[i].unlockTime;
-                    time_t unlockTimeCopy = manager->achievements[i].unlockTime;
-                    struct tm *timeinfo = localtime(&unlockTimeCopy);
+                if (unlocked) {
+                    time_t unlockTime = GetAchievementUnlockTime(manager, def);
+                    struct tm *timeinfo = localtime(&unlockTime);
                     char timeStr[50];
                     strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M", timeinfo);
-                    Vector2 timeSize = MeasureTextEx(*textFont, timeStr, 14, 1);
-                    DrawTextEx(*textFont, timeStr, 
+                    Vector2 timeSize = MeasureTextCached(textFont, timeStr, 14, 1);
+                    DrawTextCached(textFont, timeStr, 
                              (Vector2){achievementRect.x + achievementRect.width - timeSize.x - 10.0f, 
                                       achievementRect.y + 15.0f}, 
                              14, 1, state->isDarkTheme ? (Color){150, 200, 150, 255} : (Color){100, 150, 100, 255});
@@ -642,7 +730,8 @@ void DrawAchievements(AppState *state, float screenWidth, float screenHeight) {
     {
         float startY = rightPanel.y + 10.0f - *negativeScroll;
         
-        for (int i = 0; i < NEG_COUNT; i++) {
+        // 第一遍只画背景和图标：形状都从图标图集的白色区域采样，整列在同一批次中完成
+        for (int i = 0; i < manager->negativeCount; i++) {
             float yPos = startY + i * spacing;
             
             if (yPos + spacing > rightPanel.y && yPos < rightPanel.y + rightPanel.height) {
@@ -654,36 +743,54 @@ void DrawAchievements(AppState *state, float screenWidth, float screenHeight) {
                 };
                 
                 // 成就背景
-                Color bgColor = manager->negativeAchievements[i].unlocked ? 
+                bool unlocked = IsAchievementUnlocked(manager, GetAchievementDefIndex(true, i));
+                Color bgColor = unlocked ? 
                     negativePanelBg : (state->isDarkTheme ? (Color){40, 40, 40, 255} : (Color){250, 250, 250, 255});
                 DrawRectangleRec(achievementRect, bgColor);
                 
                 // 成就图标
-                if (manager->negativeAchievements[i].unlocked) {
+                if (unlocked) {
                     DrawCircle(achievementRect.x + 30, achievementRect.y + 25, 15, state->isDarkTheme ? (Color){150, 150, 150, 255} : (Color){180, 180, 180, 255});
                 } else {
                     DrawCircle(achievementRect.x + 30, achievementRect.y + 25, 15, state->isDarkTheme ? (Color){80, 80, 80, 255} : (Color){230, 230, 230, 255});
                 }
+            }
+        }
+        
+        // 第二遍画文字（字体纹理）
+        for (int i = 0; i < manager->negativeCount; i++) {
+            float yPos = startY + i * spacing;
+            
+            if (yPos + spacing > rightPanel.y && yPos < rightPanel.y + rightPanel.height) {
+                Rectangle achievementRect = {
+                    rightPanel.x + 10.0f,
+                    yPos,
+                    rightPanel.width - 20.0f,
+                    50.0f
+                };
                 
                 // 成就名称和描述
-                Color nameColor = manager->negativeAchievements[i].unlocked ? unlockedNameColor : lockedNameColor;
-                Color descColor = manager->negativeAchievements[i].unlocked ? unlockedDescColor : lockedDescColor;
+                int def = GetAchievementDefIndex(true, i);
+                bool unlocked = IsAchievementUnlocked(manager, def);
+                Color nameColor = unlocked ? unlockedNameColor : lockedNameColor;
+                Color descColor = unlocked ? unlockedDescColor : lockedDescColor;
                 
-                DrawTextEx(*textFont, manager->negativeAchievements[i].name, 
+                DrawTextCached(textFont, GetAchievementDef(def)->name, 
                          (Vector2){achievementRect.x + 60.0f, achievementRect.y + 10.0f}, 
                          22, 1, nameColor);
                 
-                DrawTextEx(*textFont, manager->negativeAchievements[i].description, 
+                DrawTextCached(textFont, GetAchievementDef(def)->description, 
                          (Vector2){achievementRect.x + 60.0f, achievementRect.y + 30.0f}, 
                          16, 1, descColor);
                 
                 // 解锁时间
-                if (manager->negativeAchievements[i].unlocked) {
-                    struct tm *timeinfo = localtime(&manager->negativeAchievements[i].unlockTime);
+                if (unlocked) {
+                    time_t unlockTime = GetAchievementUnlockTime(manager, def);
+                    struct tm *timeinfo = localtime(&unlockTime);
                     char timeStr[50];
                     strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M", timeinfo);
-                    Vector2 timeSize = MeasureTextEx(*textFont, timeStr, 14, 1);
-                    DrawTextEx(*textFont, timeStr, 
+                    Vector2 timeSize = MeasureTextCached(textFont, timeStr, 14, 1);
+                    DrawTextCached(textFont, timeStr, 
                              (Vector2){achievementRect.x + achievementRect.width - timeSize.x - 10.0f, 
                                       achievementRect.y + 15.0f}, 
                              14, 1, state->isDarkTheme ? (Color){200, 150, 150, 255} : (Color){150, 100, 100, 255});
@@ -695,7 +802,7 @@ void DrawAchievements(AppState *state, float screenWidth, float screenHeight) {
     
     // 绘制滚动条 (修复滚动条高度计算)
     if (maxPositiveScroll > 0) {
-        float contentHeight = ACH_COUNT * spacing;
+        float contentHeight = manager->achievementCount * spacing;
         float visibleRatio = panelHeight / contentHeight;
         float scrollbarHeight = panelHeight * visibleRatio;
         float scrollbarPosition = (*positiveScroll / maxPositiveScroll) * (panelHeight - scrollbarHeight);
@@ -710,7 +817,7 @@ void DrawAchievements(AppState *state, float screenWidth, float screenHeight) {
     }
     
     if (maxNegativeScroll > 0) {
-        float contentHeight = NEG_COUNT * spacing;
+        float contentHeight = manager->negativeCount * spacing;
         float visibleRatio = panelHeight / contentHeight;
         float scrollbarHeight = panelHeight * visibleRatio;
         float scrollbarPosition = (*negativeScroll / maxNegativeScroll) * (panelHeight - scrollbarHeight);
@@ -723,6 +830,67 @@ void DrawAchievements(AppState *state, float screenWidth, float screenHeight) {
         };
         DrawRectangleRec(scrollbar, state->isDarkTheme ? (Color){150, 100, 100, 200} : (Color){220, 180, 180, 200});
     }
+}
+
+// 成就界面用到的数据只比较版本号：统计计数与各成就的解锁状态
+static unsigned long long HashAchievementState(const AppState *state) {
+    unsigned long long hash = UI_LAYER_HASH_SEED;
+    hash = HashUILayerData(hash, &state->metrics.version, sizeof(state->metrics.version));
+    hash = HashUILayerData(hash, &state->achievementManager.version, sizeof(state->achievementManager.version));
+    return hash;
+}
+
+void DrawAchievements(AppState *state, float screenWidth, float screenHeight) {
+    Color textColor = state->isDarkTheme ? LIGHTGRAY : DARKGRAY;
+    Font *textFont = &state->textFont;
+
+    // 与 DrawAchievementsLayer 相同的面板布局
+    const float headerHeight = 150.0f;
+    const float bodyY = headerHeight + 10.0f;
+    const float panelWidth = screenWidth / 2.0f - 20.0f;
+    const float panelHeight = screenHeight - headerHeight - 80.0f - 20.0f;
+    const float spacing = 60.0f;
+    Rectangle leftPanel = {10.0f, bodyY, panelWidth, panelHeight};
+    Rectangle rightPanel = {screenWidth / 2.0f + 10.0f, bodyY, panelWidth, panelHeight};
+
+    // 处理滚动
+    Vector2 mousePos = GetMousePosition();
+    float *positiveScroll = &state->positiveScrollOffset;
+    float *negativeScroll = &state->negativeScrollOffset;
+    
+    // 左侧面板滚动
+    if (CheckCollisionPointRec(mousePos, leftPanel)) {
+        float wheel = GetMouseWheelMove();
+        *positiveScroll -= wheel * 30.0f;
+    }
+    
+    // 右侧面板滚动
+    if (CheckCollisionPointRec(mousePos, rightPanel)) {
+        float wheel = GetMouseWheelMove();
+        *negativeScroll -= wheel * 30.0f;
+    }
+    
+    // 限制滚动范围
+    float maxPositiveScroll = (state->achievementManager.achievementCount * spacing) - panelHeight;
+    if (maxPositiveScroll < 0) maxPositiveScroll = 0;
+    if (*positiveScroll < 0) *positiveScroll = 0;
+    if (*positiveScroll > maxPositiveScroll) *positiveScroll = maxPositiveScroll;
+    
+    float maxNegativeScroll = (state->achievementManager.negativeCount * spacing) - panelHeight;
+    if (maxNegativeScroll < 0) maxNegativeScroll = 0;
+    if (*negativeScroll < 0) *negativeScroll = 0;
+    if (*negativeScroll > maxNegativeScroll) *negativeScroll = maxNegativeScroll;
+
+    // 静态层：主题、成就数据或滚动位置变化时重绘
+    unsigned long long layerKey = HashAchievementState(state);
+    layerKey = HashUILayerData(layerKey, &state->isDarkTheme, sizeof(state->isDarkTheme));
+    layerKey = HashUILayerData(layerKey, positiveScroll, sizeof(float));
+    layerKey = HashUILayerData(layerKey, negativeScroll, sizeof(float));
+    if (BeginUILayer(&state->achievementLayer, (int)screenWidth, (int)screenHeight, layerKey)) {
+        DrawAchievementsLayer(state, screenWidth, screenHeight);
+        EndUILayer(&state->achievementLayer);
+    }
+    DrawUILayer(&state->achievementLayer);
     
     // ================ 尾部 ================
     // 返回按钮
@@ -739,8 +907,8 @@ void DrawAchievements(AppState *state, float screenWidth, float screenHeight) {
     DrawRectangleLinesEx(backButton, 1, state->isDarkTheme ? (Color){100, 100, 100, 255} : (Color){200, 200, 200, 255});
     
     const char* backText = "返回";
-    Vector2 backTextSize = MeasureTextEx(*textFont, backText, 24, 1);
-    DrawTextEx(*textFont, backText, 
+    Vector2 backTextSize = MeasureTextCached(textFont, backText, 24, 1);
+    DrawTextCached(textFont, backText, 
              (Vector2){backButton.x + backButton.width/2 - backTextSize.x/2, 
                       backButton.y + backButton.height/2 - backTextSize.y/2},
              24, 1, textColor);
@@ -774,16 +942,16 @@ void DrawInterruptionAlert(AppState *state, float screenWidth, float screenHeigh
     
     // 标题
     const char* title = "专注被打断!";
-    Vector2 titleSize = MeasureTextEx(state->titleFont, title, 36, 1);
-    DrawTextEx(state->titleFont, title, 
+    Vector2 titleSize = MeasureTextCached(&state->titleFont, title, 36, 1);
+    DrawTextCached(&state->titleFont, title, 
              (Vector2){alertRect.x + alertRect.width/2.0f - titleSize.x/2.0f, 
                       alertRect.y + 30.0f}, 
              36, 1, state->isDarkTheme ? GOLD : MAROON);
     
     // 消息
     const char* message = "已产生垃圾!请返回主界面清理";
-    Vector2 msgSize = MeasureTextEx(state->textFont, message, 24, 1);
-    DrawTextEx(state->textFont, message, 
+    Vector2 msgSize = MeasureTextCached(&state->textFont, message, 24, 1);
+    DrawTextCached(&state->textFont, message, 
              (Vector2){alertRect.x + alertRect.width/2.0f - msgSize.x/2.0f, 
                       alertRect.y + 90.0f}, 
              24, 1, state->isDarkTheme ? LIGHTGRAY : DARKGRAY);
@@ -801,8 +969,8 @@ void DrawInterruptionAlert(AppState *state, float screenWidth, float screenHeigh
     DrawRectangleLinesEx(okButton, 1.5f, hover ? (state->isDarkTheme ? GOLD : SKYBLUE) : GRAY);
     
     const char* okText = "确定";
-    Vector2 okTextSize = MeasureTextEx(state->textFont, okText, 24, 1);
-    DrawTextEx(state->textFont, okText, 
+    Vector2 okTextSize = MeasureTextCached(&state->textFont, okText, 24, 1);
+    DrawTextCached(&state->textFont, okText, 
              (Vector2){okButton.x + okButton.width/2.0f - okTextSize.x/2.0f, 
                       okButton.y + okButton.height/2.0f - okTextSize.y/2.0f}, 
              24, 1, state->isDarkTheme ? LIGHTGRAY : DARKGRAY);
@@ -828,16 +996,16 @@ void DrawCleanFailedAlert(AppState *state, float screenWidth, float screenHeight
     
     // 标题
     const char* title = "清理失败!";
-    Vector2 titleSize = MeasureTextEx(state->titleFont, title, 36, 1);
-    DrawTextEx(state->titleFont, title, 
+    Vector2 titleSize = MeasureTextCached(&state->titleFont, title, 36, 1);
+    DrawTextCached(&state->titleFont, title, 
              (Vector2){alertRect.x + alertRect.width/2.0f - titleSize.x/2.0f, 
                       alertRect.y + 30.0f}, 
              36, 1, state->isDarkTheme ? (Color){220, 150, 150, 255} : (Color){200, 100, 100, 255});
     
     // 消息
     const char* message = "请完成整个番茄钟来清理垃圾";
-    Vector2 msgSize = MeasureTextEx(state->textFont, message, 22, 1);
-    DrawTextEx(state->textFont, message, 
+    Vector2 msgSize = MeasureTextCached(&state->textFont, message, 22, 1);
+    DrawTextCached(&state->textFont, message, 
              (Vector2){alertRect.x + alertRect.width/2.0f - msgSize.x/2.0f, 
                       alertRect.y + 90.0f}, 
              22, 1, state->isDarkTheme ? LIGHTGRAY : DARKGRAY);
@@ -858,47 +1026,466 @@ void DrawCleanFailedAlert(AppState *state, float screenWidth, float screenHeight
     
     DrawRectangleLinesEx(okButton, 1, state->isDarkTheme ? LIGHTGRAY : DARKGRAY);
     const char* okText = "确定";
-    Vector2 okTextSize = MeasureTextEx(state->textFont, okText, 22, 1);
-    DrawTextEx(state->textFont, okText, 
+    Vector2 okTextSize = MeasureTextCached(&state->textFont, okText, 22, 1);
+    DrawTextCached(&state->textFont, okText, 
              (Vector2){okButton.x + okButton.width/2.0f - okTextSize.x/2.0f, 
                       okButton.y + okButton.height/2.0f - okTextSize.y/2.0f}, 
              22, 1, state->isDarkTheme ? LIGHTGRAY : DARKGRAY);
 }
 
-// 计时逻辑更新
-void UpdateTimerLogic(AppState *state) {
-    if (state->timeLeft <= 0) {
-        state->timerActive = false;
-        bool pomodoroCompleted = false;
-        bool trashCleaned = false;
-        
-        if (state->currentTrashIndex >= 0) {
-            CleanTrash(state->currentTrashIndex);
-            state->achievementManager.cleanedTrashCount++;
-            trashCleaned = true;
-            state->currentTrashIndex = -1;
-        } else {
-            state->achievementManager.totalPomodoros++;
-            pomodoroCompleted = true;
+// ===== 状态持久化 =====
+// 每次状态变化先作为事件追加到日志（后台线程批量落盘），定期把完整状态原子地写成快照并清空日志；
+// 启动时读快照，再回放序号在快照之后的事件
+#define SNAPSHOT_FILE "state_snapshot.dat"
+#define ACHIEVEMENT_DEFS_FILE "assets/achievements.txt"   // 可选，不存在时使用内置成就
+#define JOURNAL_FILE "state_journal.log"
+#define APP_SECTION_TAG STATE_TAG('A', 'P', 'P', 'S')
+#define APP_SECTION_VERSION 1
+#define JOURNAL_SECTION_TAG STATE_TAG('J', 'R', 'N', 'L')
+#define JOURNAL_SECTION_VERSION 1
+#define SNAPSHOT_INTERVAL 300.0       // 有新事件时最长隔多久写一次快照（秒）
+#define SNAPSHOT_MAX_RECORDS 256      // 日志积攒到这么多条时立即写快照
+
+// 事件类型会写入日志文件，只能在末尾追加
+typedef enum {
+    EVENT_SESSION_COMPLETED = 1,  // SessionEvent：完成一个番茄钟
+    EVENT_INTERRUPTION,           // SessionEvent：计时中切走窗口
+    EVENT_TRASH_GENERATED,        // TrashGeneratedEvent
+    EVENT_TRASH_CLEANED,          // TrashCleanedEvent：清理计时结束
+    EVENT_SETTING_CHANGED         // SettingEvent
+} AppEventType;
+
+typedef enum {
+    SETTING_THEME = 1,
+    SETTING_PRESET,
+    SETTING_CUSTOM_MINUTES
+} SettingKey;
+
+// 事件负载: u8 负载版本 | 各事件的字段，全部为定长小端，与快照段使用同一套读写函数：
+//   SessionEvent:        i32 时长 | i32 实际专注秒数 | i32 预设 | u32 垃圾编号
+//   TrashGeneratedEvent: 一条 TRSH 段的垃圾记录（含编号）
+//   TrashCleanedEvent:   i32 时长 | u32 数量 | u32 编号 × 数量
+//   SettingEvent:        i32 键 | i32 值 | 10 字节文本
+// 字段只在末尾追加并提高负载版本；版本不认识或字段不全的记录在回放时跳过
+#define EVENT_PAYLOAD_VERSION 1
+#define SESSION_EVENT_SIZE 16
+#define TRASH_CLEANED_EVENT_MIN_SIZE 8
+#define SETTING_TEXT_SIZE 10
+#define SETTING_EVENT_SIZE (8 + SETTING_TEXT_SIZE)
+
+typedef struct {
+    int duration;
+    int elapsed;            // 实际专注的秒数，中断时小于 duration
+    int preset;             // SessionPreset
+    unsigned int trashId;   // 中断产生的垃圾
+} SessionEvent;
+
+typedef struct {
+    unsigned int id;
+    Trash trash;      // 完整记录，回放时原样恢复而不是重新随机
+} TrashGeneratedEvent;
+
+typedef struct {
+    int duration;
+    int count;
+    unsigned int ids[MAX_CLEANUP_TRASH];
+} TrashCleanedEvent;
+
+typedef struct {
+    int key;          // SettingKey
+    int value;
+    char text[SETTING_TEXT_SIZE];    // 自定义分钟数的原始输入
+} SettingEvent;
+
+// 负载借用一个段来组装：写入器里只有这一个段，起点没有对齐填充
+static void BeginEventPayload(StateWriter *writer) {
+    InitStateWriter(writer);
+    BeginStateSection(writer, 0, EVENT_PAYLOAD_VERSION);
+    WriteStateU8(writer, EVENT_PAYLOAD_VERSION);
+}
+
+// 读出负载版本，剩余字节不足 minSize 时拒绝
+static bool OpenEventPayload(StateReader *reader, const void *payload, uint32_t size, uint32_t minSize) {
+    InitStateReader(reader, payload, size);
+    reader->version = ReadStateU8(reader);
+    if (reader->version < 1 || reader->version > EVENT_PAYLOAD_VERSION) return false;
+    return GetStateReaderRemaining(reader) >= minSize;
+}
+
+static void WriteSessionEvent(StateWriter *writer, const SessionEvent *event) {
+    WriteStateI32(writer, event->duration);
+    WriteStateI32(writer, event->elapsed);
+    WriteStateI32(writer, event->preset);
+    WriteStateU32(writer, event->trashId);
+}
+
+static bool ReadSessionEvent(const void *payload, uint32_t size, SessionEvent *event) {
+    StateReader reader;
+    if (!OpenEventPayload(&reader, payload, size, SESSION_EVENT_SIZE)) return false;
+    event->duration = ReadStateI32(&reader);
+    event->elapsed = ReadStateI32(&reader);
+    event->preset = ReadStateI32(&reader);
+    event->trashId = ReadStateU32(&reader);
+    return true;
+}
+
+static bool ReadTrashGeneratedEvent(const void *payload, uint32_t size, TrashGeneratedEvent *event) {
+    StateReader reader;
+    if (!OpenEventPayload(&reader, payload, size, TRASH_RECORD_SIZE)) return false;
+    return ReadTrashRecord(&reader, &event->id, &event->trash);
+}
+
+static void WriteTrashCleanedEvent(StateWriter *writer, const TrashCleanedEvent *event) {
+    WriteStateI32(writer, event->duration);
+    WriteStateU32(writer, (uint32_t)event->count);
+    for (int i = 0; i < event->count; i++) WriteStateU32(writer, event->ids[i]);
+}
+
+static bool ReadTrashCleanedEvent(const void *payload, uint32_t size, TrashCleanedEvent *event) {
+    StateReader reader;
+    if (!OpenEventPayload(&reader, payload, size, TRASH_CLEANED_EVENT_MIN_SIZE)) return false;
+    event->duration = ReadStateI32(&reader);
+    uint32_t count = ReadStateU32(&reader);
+    if (count > MAX_CLEANUP_TRASH || GetStateReaderRemaining(&reader) / 4 < count) return false;
+
+    event->count = (int)count;
+    for (uint32_t i = 0; i < count; i++) event->ids[i] = ReadStateU32(&reader);
+    return true;
+}
+
+static void WriteSettingEvent(StateWriter *writer, const SettingEvent *event) {
+    WriteStateI32(writer, event->key);
+    WriteStateI32(writer, event->value);
+    WriteStateBytes(writer, event->text, SETTING_TEXT_SIZE);
+}
+
+static bool ReadSettingEvent(const void *payload, uint32_t size, SettingEvent *event) {
+    StateReader reader;
+    if (!OpenEventPayload(&reader, payload, size, SETTING_EVENT_SIZE)) return false;
+    event->key = ReadStateI32(&reader);
+    event->value = ReadStateI32(&reader);
+    memcpy(event->text, ReadStateBytes(&reader, SETTING_TEXT_SIZE), SETTING_TEXT_SIZE);
+    event->text[SETTING_TEXT_SIZE - 1] = '\0';
+    return true;
+}
+
+// 历史记录以事件时间为结束时间
+static void RecordSession(AppState *state, time_t time, int elapsed, int preset, SessionOutcome outcome, unsigned int trashId) {
+    SessionRecord record = {
+        .startTime = (int64_t)time - elapsed,
+        .duration = elapsed,
+        .preset = (uint8_t)preset,
+        .outcome = (uint8_t)outcome,
+        .trashId = trashId
+    };
+    AppendSession(&state->history, &record);
+}
+
+// 事件对状态的全部修改都在这里，实时执行与启动回放走同一段代码；
+// 回放时垃圾直接移除而不播放动画，成就按事件发生时的时间判断
+static void ApplyAppEvent(AppState *state, uint32_t type, const void *payload, uint32_t size, time_t time, bool replaying) {
+    AchievementManager *manager = &state->achievementManager;
+    MetricsStore *metrics = &state->metrics;
+
+    switch (type) {
+        case EVENT_SESSION_COMPLETED: {
+            SessionEvent event;
+            if (!ReadSessionEvent(payload, size, &event)) break;
+
+            AddMetric(metrics, METRIC_TOTAL_POMODOROS, 1);
             state->interruptionOccurred = false;
-            
+
             // 更新番茄钟类型统计
-            if (state->pomodoroDuration == 25 * 60) {
-                state->statistics.pomodoros25++;
-            } else if (state->pomodoroDuration == 45 * 60) {
-                state->statistics.pomodoros45++;
-                state->achievementManager.longSessionCount++; // 只在这里增加
+            if (event.duration == 25 * 60) {
+                AddMetric(metrics, METRIC_POMODOROS_25, 1);
+            } else if (event.duration == 45 * 60) {
+                AddMetric(metrics, METRIC_POMODOROS_45, 1);
+                AddMetric(metrics, METRIC_LONG_SESSIONS, 1);
             } else {
-                state->statistics.pomodorosCustom++;
+                AddMetric(metrics, METRIC_POMODOROS_CUSTOM, 1);
             }
+            CheckAchievementsAt(manager, metrics, true, time);
+            RecordSession(state, time, event.elapsed, event.preset, SESSION_COMPLETED, 0);
+            break;
         }
-        
-        // 在计数更新后检查成就
-        CheckAchievements(&state->achievementManager, 
-                         pomodoroCompleted, 
-                         trashCleaned, 
-                         state->pomodoroDuration);
-        
+        case EVENT_INTERRUPTION: {
+            SessionEvent event;
+            if (!ReadSessionEvent(payload, size, &event)) break;
+
+            AddMetric(metrics, METRIC_INTERRUPTIONS, 1);
+            manager->interruptionOccurred = true;
+            CheckAchievementsAt(manager, metrics, false, time);
+            RecordSession(state, time, event.elapsed, event.preset, SESSION_INTERRUPTED, event.trashId);
+            break;
+        }
+        case EVENT_TRASH_GENERATED: {
+            TrashGeneratedEvent event;
+            if (!ReadTrashGeneratedEvent(payload, size, &event)) break;
+
+            AddMetric(metrics, METRIC_GENERATED_TRASH, 1);
+            // 实时执行时垃圾已经生成，只有回放需要放回世界
+            if (replaying) RestoreWorldTrash(GetTrashWorld(), &event.trash, event.id);
+            break;
+        }
+        case EVENT_TRASH_CLEANED: {
+            TrashCleanedEvent event;
+            if (!ReadTrashCleanedEvent(payload, size, &event)) break;
+
+            for (int i = 0; i < event.count; i++) {
+                TrashHandle handle = FindWorldTrashById(GetTrashWorld(), event.ids[i]);
+                if (replaying) {
+                    RemoveWorldTrash(GetTrashWorld(), handle);
+                } else {
+                    CleanTrash(handle);
+                }
+            }
+            AddMetric(metrics, METRIC_CLEANED_TRASH, event.count);
+            SetMetric(metrics, METRIC_TRASH_ALL_CLEANED, IsAllTrashTypeCleaned() ? 1 : 0);
+            CheckAchievementsAt(manager, metrics, false, time);
+            RecordSession(state, time, event.duration, SESSION_PRESET_NONE, SESSION_CLEANUP, (event.count > 0) ? event.ids[0] : 0);
+            break;
+        }
+        case EVENT_SETTING_CHANGED: {
+            SettingEvent event;
+            if (!ReadSettingEvent(payload, size, &event)) break;
+
+            if (event.key == SETTING_THEME) {
+                state->isDarkTheme = event.value != 0;
+            } else if (event.key == SETTING_PRESET && event.value >= 0 && event.value < 3) {
+                state->selectedPreset = event.value;
+            } else if (event.key == SETTING_CUSTOM_MINUTES) {
+                memcpy(state->customMinutes, event.text, sizeof(state->customMinutes));
+                state->customMinutes[sizeof(state->customMinutes) - 1] = '\0';
+            }
+            break;
+        }
+        default:
+            TraceLog(LOG_WARNING, "状态日志: 未知事件类型 %u", type);
+            break;
+    }
+}
+
+// 结束 BeginEventPayload 组装的负载，执行事件并追加到日志，落盘由日志的后台线程完成；
+// 实时执行也从编码后的字节解码，与回放完全一致
+static void CommitAppEvent(AppState *state, AppEventType type, StateWriter *payload) {
+    EndStateSection(payload);
+    if (!payload->failed && payload->size <= JOURNAL_MAX_PAYLOAD) {
+        time_t now = time(NULL);
+        ApplyAppEvent(state, type, payload->data, (uint32_t)payload->size, now, false);
+        AppendJournalRecord(type, (int64_t)now, payload->data, (uint32_t)payload->size);
+    } else {
+        TraceLog(LOG_WARNING, "状态日志: 事件 %d 编码失败", (int)type);
+    }
+    FreeStateWriter(payload);
+}
+
+static void ReplayAppEvent(const JournalRecord *record, const void *payload, void *userData) {
+    ApplyAppEvent((AppState*)userData, record->type, payload, record->size, (time_t)record->time, true);
+}
+
+static void CommitSetting(AppState *state, SettingKey key, int value, const char *text) {
+    SettingEvent event = { .key = key, .value = value };
+    if (text != NULL) strncpy(event.text, text, sizeof(event.text) - 1);
+
+    StateWriter payload;
+    BeginEventPayload(&payload);
+    WriteSettingEvent(&payload, &event);
+    CommitAppEvent(state, EVENT_SETTING_CHANGED, &payload);
+}
+
+// 新生成的垃圾带着完整记录写入日志，返回其编号
+static unsigned int CommitGeneratedTrash(AppState *state, TrashHandle handle) {
+    const Trash *trash = GetTrash(handle);
+    if (trash == NULL) return 0;
+
+    unsigned int id = GetWorldTrashId(GetTrashWorld(), handle);
+    StateWriter payload;
+    BeginEventPayload(&payload);
+    WriteTrashRecord(&payload, id, trash);
+    CommitAppEvent(state, EVENT_TRASH_GENERATED, &payload);
+    return id;
+}
+
+// 当前计时对应的预设：清理垃圾的计时不属于任何预设
+static SessionPreset GetCurrentSessionPreset(const AppState *state) {
+    if (state->cleanupTrashCount > 0) return SESSION_PRESET_NONE;
+    if (state->selectedPreset == 0) return SESSION_PRESET_25;
+    if (state->selectedPreset == 1) return SESSION_PRESET_45;
+    return SESSION_PRESET_CUSTOM;
+}
+
+// 计时结束：选中的垃圾仍有存在的就记为清理，否则记为完成一个番茄钟
+static void CompleteTimerSession(AppState *state) {
+    SessionPreset preset = GetCurrentSessionPreset(state);
+    TrashCleanedEvent cleaned = { .duration = state->pomodoroDuration };
+    for (int i = 0; i < state->cleanupTrashCount; i++) {
+        unsigned int id = GetWorldTrashId(GetTrashWorld(), state->cleanupTrash[i]);
+        if (id != 0) cleaned.ids[cleaned.count++] = id;
+    }
+    state->cleanupTrashCount = 0;
+
+    StateWriter payload;
+    BeginEventPayload(&payload);
+    if (cleaned.count > 0) {
+        WriteTrashCleanedEvent(&payload, &cleaned);
+        CommitAppEvent(state, EVENT_TRASH_CLEANED, &payload);
+    } else {
+        SessionEvent completed = { state->pomodoroDuration, state->pomodoroDuration, preset, 0 };
+        WriteSessionEvent(&payload, &completed);
+        CommitAppEvent(state, EVENT_SESSION_COMPLETED, &payload);
+    }
+}
+
+// 快照是一个存档容器：APPS 设置 | JRNL 覆盖到的日志序号 | MTRC 计数器 | ACHV 成就 | TRSH 垃圾 | HIST 历史
+// APPS 段: i32 窗口宽、高、x、y | i32 预设 | u8 暗色主题 | 10 字节自定义分钟数
+static void WriteAppSection(StateWriter *writer, const AppState *state) {
+    BeginStateSection(writer, APP_SECTION_TAG, APP_SECTION_VERSION);
+    WriteStateI32(writer, state->windowWidth);
+    WriteStateI32(writer, state->windowHeight);
+    WriteStateI32(writer, state->windowX);
+    WriteStateI32(writer, state->windowY);
+    WriteStateI32(writer, state->selectedPreset);
+    WriteStateU8(writer, state->isDarkTheme ? 1 : 0);
+    WriteStateBytes(writer, state->customMinutes, sizeof(state->customMinutes));
+    EndStateSection(writer);
+}
+
+static void ApplyPersistentAppState(AppState *state, const PersistentAppState *persistent) {
+    state->selectedPreset = (persistent->selectedPreset >= 0 && persistent->selectedPreset < 3) ? persistent->selectedPreset : 0;
+    memcpy(state->customMinutes, persistent->customMinutes, sizeof(state->customMinutes));
+    state->customMinutes[sizeof(state->customMinutes) - 1] = '\0';
+}
+
+// 窗口尺寸与位置在启动时以实际窗口为准，这里只取设置
+static void ReadAppSection(const StateFile *file, AppState *state) {
+    StateReader reader;
+    if (!FindStateSection(file, APP_SECTION_TAG, 1, APP_SECTION_VERSION, &reader)) return;
+
+    PersistentAppState persistent = {0};
+    persistent.windowWidth = ReadStateI32(&reader);
+    persistent.windowHeight = ReadStateI32(&reader);
+    persistent.windowX = ReadStateI32(&reader);
+    persistent.windowY = ReadStateI32(&reader);
+    persistent.selectedPreset = ReadStateI32(&reader);
+    state->isDarkTheme = ReadStateU8(&reader) != 0;
+    const void *customMinutes = ReadStateBytes(&reader, sizeof(persistent.customMinutes));
+    if (customMinutes != NULL) memcpy(persistent.customMinutes, customMinutes, sizeof(persistent.customMinutes));
+    ApplyPersistentAppState(state, &persistent);
+}
+
+// 在日志的写线程中执行：原子地写出快照（含 fsync）并释放写入器
+static bool WriteStateSnapshot(void *userData) {
+    StateWriter *writer = (StateWriter*)userData;
+    bool saved = !writer->failed && SaveStateFile(writer, SNAPSHOT_FILE);
+    FreeStateWriter(writer);
+    free(writer);
+
+    if (!saved) TraceLog(LOG_WARNING, "状态快照写入失败，保留上一份快照");
+    return saved;
+}
+
+// 主线程只把完整状态序列化到内存，记录其覆盖到的日志序号；写文件、落盘与清空日志由写线程完成。
+// 清空前崩溃时日志里的记录序号不大于快照序号，回放时会被跳过
+static void CompactStateJournal(AppState *state) {
+    // 上一份快照还在写时提交必然被拒绝，先检查以免每帧白白序列化全部状态
+    if (IsJournalCheckpointPending()) return;
+
+    StateWriter *writer = (StateWriter*)malloc(sizeof(StateWriter));
+    if (writer == NULL) return;
+    InitStateWriter(writer);
+
+    WriteAppSection(writer, state);
+    BeginStateSection(writer, JOURNAL_SECTION_TAG, JOURNAL_SECTION_VERSION);
+    WriteStateU64(writer, GetJournalSequence());
+    EndStateSection(writer);
+    WriteMetricsSection(writer, &state->metrics);
+    WriteAchievementSection(writer, &state->achievementManager);
+    WriteTrashWorldSection(GetTrashWorld(), writer);
+    WriteSessionHistorySection(writer, &state->history);
+
+    if (!SubmitJournalCheckpoint(WriteStateSnapshot, writer)) {
+        FreeStateWriter(writer);
+        free(writer);
+        return;
+    }
+    state->lastSnapshotTime = GetTime();
+}
+
+// 读取快照，返回其覆盖到的日志序号；没有可用快照时返回 false
+static bool LoadStateSnapshot(AppState *state, uint64_t *sequence) {
+    StateFile file;
+    StateFileResult result = OpenStateFile(&file, SNAPSHOT_FILE);
+    if (result == STATE_FILE_LEGACY || result == STATE_FILE_CORRUPT) TraceLog(LOG_WARNING, "状态快照无法识别: %s", SNAPSHOT_FILE);
+    if (result != STATE_FILE_OK) return false;
+
+    StateReader reader;
+    if (FindStateSection(&file, JOURNAL_SECTION_TAG, 1, JOURNAL_SECTION_VERSION, &reader)) {
+        *sequence = ReadStateU64(&reader);
+    }
+    ReadAppSection(&file, state);
+    ReadMetricsSection(&file, &state->metrics);
+    ReadAchievementSection(&file, &state->achievementManager);
+    ReadTrashWorldSection(GetTrashWorld(), &file);
+    ReadSessionHistorySection(&file, &state->history);
+    CloseStateFile(&file);
+    return true;
+}
+
+// 旧版本的分散存档，只在还没有快照时读取一次
+static void LoadLegacyState(AppState *state, const char *trashStateFile) {
+    FILE *appState = fopen("app_state.dat", "rb");
+    if (appState) {
+        PersistentAppState persistent = {0};
+        if (fread(&persistent, sizeof(PersistentAppState), 1, appState) == 1) {
+            ApplyPersistentAppState(state, &persistent);
+        }
+        fclose(appState);
+    }
+    state->isDarkTheme = LoadAppThemeState();
+    LoadTrashSystem(trashStateFile);
+    LoadStatistics(&state->metrics, state->statisticsFile);
+    LoadAchievements(&state->achievementManager, &state->metrics, state->achievementFile);
+}
+
+// 启动时恢复状态：快照（或旧存档）加上日志中快照之后的事件
+static void LoadPersistentState(AppState *state, const char *trashStateFile) {
+    uint64_t sequence = 0;
+    bool fromSnapshot = LoadStateSnapshot(state, &sequence);
+    if (fromSnapshot) {
+        TraceLog(LOG_INFO, "状态快照已加载 (序号 %llu)", (unsigned long long)sequence);
+    } else {
+        LoadLegacyState(state, trashStateFile);
+    }
+
+    // 读档写入的计数不算新变化，成就规则从这里开始跟踪指标（带时间窗口的规则只认新变化）
+    BindAchievementMetrics(&state->achievementManager, &state->metrics);
+
+    if (!OpenStateJournal(JOURNAL_FILE, sequence, ReplayAppEvent, state)) {
+        TraceLog(LOG_WARNING, "无法打开状态日志: %s，本次运行只在退出时保存", JOURNAL_FILE);
+    }
+
+    JournalStats journal = GetStateJournalStats();
+    if (journal.replayed > 0) TraceLog(LOG_INFO, "状态日志: 回放 %lu 条事件", journal.replayed);
+
+    // 回放过的事件和旧存档立即并入快照
+    if (!fromSnapshot || journal.replayed > 0) CompactStateJournal(state);
+    state->lastSnapshotTime = GetTime();
+}
+
+// 有新事件时定期写快照，控制日志长度和启动回放时间
+static void UpdateStateSnapshot(AppState *state) {
+    int records = GetJournalRecordCount();
+    if (records == 0) return;
+    if (records >= SNAPSHOT_MAX_RECORDS || GetTime() - state->lastSnapshotTime >= SNAPSHOT_INTERVAL) {
+        CompactStateJournal(state);
+    }
+}
+
+// 计时逻辑更新
+void UpdateTimerLogic(AppState *state) {
+    if (state->timeLeft <= 0) {
+        state->timerActive = false;
+        CompleteTimerSession(state);
         state->currentScreen = MAIN_SCREEN;
     }
 }
@@ -930,9 +1517,7 @@ void HandleMainScreenInput(AppState *state, float screenWidth, float screenHeigh
         IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) 
     {
         // 切换主题
-        state->isDarkTheme = !state->isDarkTheme;
-        state->themeIcon = state->isDarkTheme ? state->moonTexture : state->sunTexture;
-        SaveAppThemeState(state->isDarkTheme);
+        CommitSetting(state, SETTING_THEME, !state->isDarkTheme, NULL);
         eventHandled = true;
     }
 
@@ -964,14 +1549,6 @@ void HandleMainScreenInput(AppState *state, float screenWidth, float screenHeigh
     if (!eventHandled && CheckCollisionPointRec(GetMousePosition(), statisticsButton) && 
         IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) 
     {
-        // 更新统计数据
-        state->statistics.totalPomodoros = state->achievementManager.totalPomodoros;
-        state->statistics.cleanedTrash = state->achievementManager.cleanedTrashCount;
-        state->statistics.generatedTrash = state->achievementManager.generatedTrashCount;
-        state->statistics.interruptions = state->achievementManager.interruptionsCount;
-        state->statistics.streakDays = state->achievementManager.streakDays;
-        state->statistics.longSessions = state->achievementManager.longSessionCount;
-        
         state->currentScreen = STATISTICS_SCREEN;
         eventHandled = true;
     }
@@ -991,7 +1568,7 @@ void HandleMainScreenInput(AppState *state, float screenWidth, float screenHeigh
         
         if (!eventHandled && CheckCollisionPointRec(GetMousePosition(), rect) && 
             IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-            state->selectedPreset = i;
+            if (state->selectedPreset != i) CommitSetting(state, SETTING_PRESET, i, NULL);
             eventHandled = true;
             
             if (i == 2) { // 自定义选项
@@ -1004,7 +1581,7 @@ void HandleMainScreenInput(AppState *state, float screenWidth, float screenHeigh
                 state->currentScreen = TIMER_SCREEN;
                 state->timerActive = true;
                 state->lastUpdateTime = GetTime();
-                state->currentStudyImage = GetRandomValue(0, STUDY_IMAGE_COUNT - 1);
+                PickStudyImage(state);
             }
         }
     }
@@ -1045,17 +1622,18 @@ void HandleMainScreenInput(AppState *state, float screenWidth, float screenHeigh
                 if (strlen(state->customMinutes) > 0) {
                     int minutes = atoi(state->customMinutes);
                     if (minutes >= 30 && minutes <= 120) { 
+                        CommitSetting(state, SETTING_CUSTOM_MINUTES, minutes, state->customMinutes);
                         state->pomodoroDuration = minutes * 60; // 分钟转秒
                         state->timeLeft = state->pomodoroDuration;
                         state->currentScreen = TIMER_SCREEN;
                         state->timerActive = true;
                         state->lastUpdateTime = GetTime();
-                        state->currentStudyImage = GetRandomValue(0, STUDY_IMAGE_COUNT - 1);
+                        PickStudyImage(state);
                     } else {
                         // 显示错误提示
                         const char* error = "请输入30-120之间的数字";
-                        Vector2 errorSize = MeasureTextEx(state->textFont, error, 20, 1);
-                        DrawTextEx(state->textFont, error, 
+                        Vector2 errorSize = MeasureTextCached(&state->textFont, error, 20, 1);
+                        DrawTextCached(&state->textFont, error, 
                                 (Vector2){inputRect.x + inputRect.width/2.0f - errorSize.x/2.0f, 
                                         inputRect.y + 60.0f}, 
                                 20, 1, RED);
@@ -1065,34 +1643,91 @@ void HandleMainScreenInput(AppState *state, float screenWidth, float screenHeigh
         }
     }
 
-    // 垃圾点击处理 - 只在没有其他事件处理时进行
+    // 垃圾点击与框选 - 只在没有其他事件处理时开始，松开时单击选中最上层的垃圾，拖动则框选多个
     if (!eventHandled && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-        Vector2 mousePos = GetMousePosition();
-        for (int i = 0; i < trashCount; i++) {
-            if (trashes[i].active && !trashes[i].cleaning) {
-                // 计算鼠标到垃圾中心的距离
-                float distance = Vector2Distance(mousePos, trashes[i].position);
-                
-                // 如果距离小于垃圾半径，则命中
-                if (distance <= trashes[i].radius) {
-                    // 分钟转秒
-                    state->cleanupDuration = trashes[i].pomodoroDuration * 60;
-                    state->currentTrashIndex = i;
-                    state->pomodoroDuration = state->cleanupDuration;
-                    state->timeLeft = state->pomodoroDuration;
-                    state->currentScreen = TIMER_SCREEN;
-                    state->timerActive = true;
-                    state->lastUpdateTime = GetTime();
-                    state->currentStudyImage = GetRandomValue(0, STUDY_IMAGE_COUNT - 1);
-                    eventHandled = true;
-                    break;
-                }
+        state->selectingTrash = true;
+        state->selectStart = GetMousePosition();
+    }
+    if (state->selectingTrash && IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) {
+        TrashHandle selected[MAX_CLEANUP_TRASH];
+        int selectedCount = 0;
+        if (IsTrashDragSelecting(state)) {
+            selectedCount = FindTrashInRect(GetTrashSelectRect(state->selectStart, GetMousePosition()),
+                                            selected, MAX_CLEANUP_TRASH);
+            if (selectedCount > MAX_CLEANUP_TRASH) selectedCount = MAX_CLEANUP_TRASH;
+        } else {
+            selected[0] = FindTrashAt(GetMousePosition());
+            if (IsTrashHandleValid(selected[0])) selectedCount = 1;
+        }
+        state->selectingTrash = false;
+
+        if (selectedCount > 0) {
+            // 清理时长为所选垃圾时长之和，分钟转秒
+            state->cleanupDuration = 0;
+            for (int i = 0; i < selectedCount; i++) {
+                state->cleanupTrash[i] = selected[i];
+                state->cleanupDuration += GetTrash(selected[i])->pomodoroDuration * 60;
             }
+            state->cleanupTrashCount = selectedCount;
+            state->pomodoroDuration = state->cleanupDuration;
+            state->timeLeft = state->pomodoroDuration;
+            state->currentScreen = TIMER_SCREEN;
+            state->timerActive = true;
+            state->lastUpdateTime = GetTime();
+            PickStudyImage(state);
         }
     }
 }
 
-// 资源加载函数
+// 绘制加载界面：学习图片 + 进度条，进度条上的高光条随时间移动表示仍在加载
+static void DrawLoadingScreen(Texture2D splashTexture, float progress) {
+    float screenWidth = (float)GetScreenWidth();
+    float screenHeight = (float)GetScreenHeight();
+    float contentBottom = screenHeight / 2.0f;
+
+    BeginDrawing();
+    ClearBackground(RAYWHITE);
+
+    if (splashTexture.id != 0) {
+        // 计算缩放比例，使图片占据屏幕高度的40%
+        float scale = (screenHeight * 0.4f) / splashTexture.height;
+        float width = splashTexture.width * scale;
+        float height = splashTexture.height * scale;
+
+        // 居中显示
+        DrawTextureEx(splashTexture,
+                     (Vector2){screenWidth/2 - width/2, screenHeight/2 - height/2},
+                     0.0f, scale, WHITE);
+        contentBottom = screenHeight/2 + height/2;
+    }
+
+    // 在图片下方显示加载文本
+    const char* loadingText = "The resource is loading...";
+    int fontSize = 30;
+    Font defaultFont = GetFontDefault();
+    Vector2 textSize = MeasureTextCached(&defaultFont, loadingText, fontSize, 1);
+    DrawTextCached(&defaultFont, loadingText, (Vector2){ screenWidth/2 - textSize.x/2, contentBottom + 20 }, fontSize, 1, DARKGRAY);
+
+    // 进度条
+    Rectangle bar = { screenWidth/2 - 200.0f, contentBottom + 70.0f, 400.0f, 12.0f };
+    DrawRectangleRounded(bar, 1.0f, 8, LIGHTGRAY);
+    Rectangle filled = bar;
+    filled.width = bar.width * Clamp(progress, 0.0f, 1.0f);
+    if (filled.width > 0.0f) {
+        DrawRectangleRounded(filled, 1.0f, 8, (Color){ 76, 175, 80, 255 });
+
+        float shimmer = fmodf((float)GetTime() * 0.8f, 1.0f);
+        float shimmerX = filled.x + (filled.width - 30.0f) * shimmer;
+        if (filled.width > 30.0f) {
+            DrawRectangleRounded((Rectangle){ shimmerX, filled.y, 30.0f, filled.height }, 1.0f, 8, Fade(WHITE, 0.35f));
+        }
+    }
+
+    EndDrawing();
+}
+
+// 资源加载函数：字体光栅化与图片解码交给工作线程，主线程一边上传一边刷新加载界面，
+// 主界面所需资源就绪后立即返回，学习图片等在主循环中继续上传
 bool LoadResources(AppState *state) {
     // 提前加载一张随机学习图片用于加载界面
     int randomIndex = GetRandomValue(0, STUDY_IMAGE_COUNT-1);
@@ -1102,46 +1737,16 @@ bool LoadResources(AppState *state) {
     Texture2D loadingTexture = {0};
     if (FileExists(loadingImgPath)) {
         loadingTexture = LoadTexture(loadingImgPath);
+        SetTextureFilter(loadingTexture, TEXTURE_FILTER_BILINEAR);
     }
-    
-    // 绘制加载界面
-    BeginDrawing();
-    ClearBackground(RAYWHITE);
-    
-    if (loadingTexture.id != 0) {
-        // 计算缩放比例，使图片占据屏幕高度的40%
-        float scale = (GetScreenHeight() * 0.4f) / loadingTexture.height;
-        float width = loadingTexture.width * scale;
-        float height = loadingTexture.height * scale;
-        
-        // 居中显示
-        DrawTextureEx(loadingTexture, 
-                     (Vector2){GetScreenWidth()/2 - width/2, 
-                              GetScreenHeight()/2 - height/2}, 
-                     0.0f, scale, WHITE);
-        
-        // 在图片下方显示加载文本
-        const char* loadingText = "The resource is loading...";
-        int fontSize = 30;
-        Vector2 textSize = MeasureTextEx(GetFontDefault(), loadingText, fontSize, 1);
-        DrawText(loadingText, 
-                GetScreenWidth()/2 - textSize.x/2, 
-                GetScreenHeight()/2 + height/2 + 20, 
-                fontSize, DARKGRAY);
-    } else {
-        // 没有图片时显示文本
-        DrawText("The resource is loading...", GetScreenWidth()/2 - 100, GetScreenHeight()/2, 30, DARKGRAY);
-    }
-    
-    EndDrawing();
+    DrawLoadingScreen(loadingTexture, 0.0f);
 
-    // 生成CJK字符集
-    int codepointCount = 0;
-    int *codepoints = GenerateCJKCodepoints(&codepointCount);
-    
     const int baseFontSize = 32;
     const char *regularFontPath = "assets/fonts/SourceHanSansCN-Regular.otf";
     const char *boldFontPath = "assets/fonts/SourceHanSansCN-Bold.otf";
+    // 构建期生成的预烘焙图集（见 tools/font_baker.c）
+    const char *regularBakedPath = "assets/fonts/SourceHanSansCN-Regular-32.glyphs";
+    const char *boldBakedPath = "assets/fonts/SourceHanSansCN-Bold-60.glyphs";
     
     const int titleFontSize = 60;  // 增大标题字体尺寸
 
@@ -1149,114 +1754,62 @@ bool LoadResources(AppState *state) {
     if (!DirectoryExists("assets/fonts")) {
         TraceLog(LOG_WARNING, "字体目录不存在");
     }
-    
-    // 加载常规字体
-    if (FileExists(regularFontPath)) {
-        state->textFont = LoadFontEx(regularFontPath, baseFontSize, codepoints, codepointCount);
-        if (state->textFont.texture.id == 0) {
-            TraceLog(LOG_WARNING, "常规字体加载失败: %s", regularFontPath);
-            state->textFont = GetFontDefault();
-        } else {
-            SetTextureFilter(state->textFont.texture, TEXTURE_FILTER_BILINEAR);
-        }
-    } else {
-        TraceLog(LOG_WARNING, "常规字体文件未找到: %s", regularFontPath);
-        state->textFont = GetFontDefault();
-    }
-    
-    // 加载粗体字体
-    if (FileExists(boldFontPath)) {
-        state->titleFont = LoadFontEx(boldFontPath, titleFontSize, codepoints, codepointCount);
-        if (state->titleFont.texture.id == 0) {
-            TraceLog(LOG_WARNING, "粗体字体加载失败: %s", boldFontPath);
-            state->titleFont = state->textFont;
-        } else {
-            SetTextureFilter(state->titleFont.texture, TEXTURE_FILTER_BILINEAR);
-        }
-    } else {
-        TraceLog(LOG_WARNING, "粗体字体文件未找到: %s", boldFontPath);
-        state->titleFont = state->textFont;
-    }
 
-    // 加载成就图标 - 亮色主题
-    const char *achieveIconLightPath = "assets/img/achieve1.png";
-    if (FileExists(achieveIconLightPath)) {
-        state->achieveIconLight = LoadTexture(achieveIconLightPath);
-        SetTextureFilter(state->achieveIconLight, TEXTURE_FILTER_BILINEAR);
-    } else {
-        TraceLog(LOG_WARNING, "亮色成就图标未找到: %s", achieveIconLightPath);
-    }
-    
-    // 加载成就图标 - 暗色主题
-    const char *achieveIconDarkPath = "assets/img/achieve2.png";
-    if (FileExists(achieveIconDarkPath)) {
-        state->achieveIconDark = LoadTexture(achieveIconDarkPath);
-        SetTextureFilter(state->achieveIconDark, TEXTURE_FILTER_BILINEAR);
-    } else {
-        TraceLog(LOG_WARNING, "暗色成就图标未找到: %s", achieveIconDarkPath);
-    }
+    InitAssetLoader();
 
-    // 加载统计图标 - 亮色主题
-    const char *dateIconLightPath = "assets/img/date2.png";
-    if (FileExists(dateIconLightPath)) {
-        state->dateIconLight = LoadTexture(dateIconLightPath);
-        SetTextureFilter(state->dateIconLight, TEXTURE_FILTER_BILINEAR);
-    } else {
-        TraceLog(LOG_WARNING, "亮色统计图标未找到: %s", dateIconLightPath);
-    }
-    
-    // 加载统计图标 - 暗色主题
-    const char *dateIconDarkPath = "assets/img/date1.png";
-    if (FileExists(dateIconDarkPath)) {
-        state->dateIconDark = LoadTexture(dateIconDarkPath);
-        SetTextureFilter(state->dateIconDark, TEXTURE_FILTER_BILINEAR);
-    } else {
-        TraceLog(LOG_WARNING, "暗色统计图标未找到: %s", dateIconDarkPath);
-    }
+    // 没有预烘焙图集时只光栅化界面实际用到的字符，其余字符在首次绘制时加入图集
+    // （种子文本需保留到字体在工作线程中准备完毕）
+    char *glyphSeed = BuildGlyphSeedText();
 
-    // 加载皮肤图标
-    const char *sunIconPath = GetResourcePath("assets/img/sun.png");
-    const char *moonIconPath = GetResourcePath("assets/img/moon.png");
-    
-    // 根据当前主题加载对应图标
-    if (FileExists(sunIconPath) && FileExists(moonIconPath)) {
-        state->sunTexture = LoadTexture(sunIconPath);
-        state->moonTexture = LoadTexture(moonIconPath);
-        state->themeIcon = state->isDarkTheme ? state->moonTexture : state->sunTexture;
-    } else {
-        TraceLog(LOG_WARNING, "皮肤图标文件未找到");
+    // 常规字体
+    if (!FileExists(regularBakedPath) && !FileExists(regularFontPath)) {
+        TraceLog(LOG_WARNING, "常规字体文件未找到: %s", regularFontPath);
     }
-    
-    free(codepoints);
-    
-    // 加载成就图标
-    const char *achieveIconPath = "assets/img/achieve.png";
-    if (FileExists(achieveIconPath)) {
-        state->achieveIcon = LoadTexture(achieveIconPath);
-        if (state->achieveIcon.id == 0) {
-            TraceLog(LOG_WARNING, "成就图标加载失败: %s", achieveIconPath);
-        } else {
-            SetTextureFilter(state->achieveIcon, TEXTURE_FILTER_BILINEAR);
-        }
-    } else {
-        TraceLog(LOG_WARNING, "成就图标文件未找到: %s", achieveIconPath);
+    QueueFontAsset(&state->textFont, (FontLoadJob){
+        .bakedFile = regularBakedPath, .fontFile = regularFontPath,
+        .fontSize = baseFontSize, .seedText = glyphSeed }, true);
+
+    // 粗体字体（缺失时使用常规字体文件，图集需各自独立以便按需扩容）
+    const char *titleFontPath = FileExists(boldFontPath) ? boldFontPath : regularFontPath;
+    if (titleFontPath != boldFontPath) {
+        TraceLog(LOG_WARNING, "粗体字体文件未找到: %s", boldFontPath);
     }
-    
-    // 加载学习图片
+    QueueFontAsset(&state->titleFont, (FontLoadJob){
+        .bakedFile = boldBakedPath, .fontFile = titleFontPath,
+        .fontSize = titleFontSize, .seedText = glyphSeed }, true);
+
+    // 界面图标打包为一张图集
+    SetIconSource(&state->icons, ICON_ACHIEVE_LIGHT, "assets/img/achieve1.png");
+    SetIconSource(&state->icons, ICON_ACHIEVE_DARK, "assets/img/achieve2.png");
+    SetIconSource(&state->icons, ICON_DATE_LIGHT, "assets/img/date2.png");
+    SetIconSource(&state->icons, ICON_DATE_DARK, "assets/img/date1.png");
+    SetIconSource(&state->icons, ICON_SUN, GetResourcePath("assets/img/sun.png"));
+    SetIconSource(&state->icons, ICON_MOON, GetResourcePath("assets/img/moon.png"));
+    SetIconSource(&state->icons, ICON_ACHIEVE, "assets/img/achieve.png");
+    QueueIconAtlasAsset(&state->icons, true);
+
+    // 学习图片只登记，开始计时时才加载
     for (int i = 0; i < STUDY_IMAGE_COUNT; i++) {
         char imgPath[256];
         sprintf(imgPath, "assets/img/study%d.png", i + 1);
-        
-        if (FileExists(imgPath)) {
-            state->studyImages[i] = LoadTexture(imgPath);
-            if (state->studyImages[i].id == 0) {
-                TraceLog(LOG_WARNING, "图片加载失败: %s", imgPath);
-            } else {
-                SetTextureFilter(state->studyImages[i], TEXTURE_FILTER_BILINEAR);
-            }
-        } else {
-            TraceLog(LOG_WARNING, "图片文件未找到: %s", imgPath);
+        state->studyImageSlots[i] = RegisterResidentTexture(imgPath, STUDY_IMAGE_SCALE);
+    }
+
+    StartAssetLoading();
+
+    while (!AreEssentialAssetsReady()) {
+        if (WindowShouldClose()) {
+            TraceLog(LOG_INFO, "资源加载过程中窗口被关闭");
+            ShutdownAssetLoader();
+            ShutdownWorkerPool();
+            free(glyphSeed);
+            if (loadingTexture.id != 0) UnloadTexture(loadingTexture);
+            UnloadResources(state);
+            return false;
         }
+
+        PumpAssetLoader(0.008);
+        DrawLoadingScreen(loadingTexture, GetAssetLoadProgress(true));
     }
 
     // 卸载临时加载的纹理
@@ -1264,154 +1817,59 @@ bool LoadResources(AppState *state) {
         UnloadTexture(loadingTexture);
     }
 
-    return true;
-}
+    // 字体全部准备完毕后才能释放种子文本
+    free(glyphSeed);
 
-// 仅生成必要字符集
-int* GenerateEssentialCodepoints(int* count) {
-    // 基本ASCII字符 (0-127)
-    const int asciiCount = 128;
-    
-    // 常用汉字 (Unicode范围: 0x4E00-0x9FA5)
-    const int minHan = 0x4E00;
-    const int maxHan = 0x9FA5;
-    const int hanCount = maxHan - minHan + 1;
-    
-    // 数字和标点符号
-    const int extraCount = 50;
-    
-    *count = asciiCount + hanCount + extraCount;
-    int* codepoints = (int*)malloc(*count * sizeof(int));
-    
-    // 填充ASCII
-    for (int i = 0; i < asciiCount; i++) {
-        codepoints[i] = i;
+    if (state->textFont.texture.id == 0) {
+        TraceLog(LOG_WARNING, "常规字体加载失败，使用默认字体");
+        state->textFont = GetFontDefault();
     }
-    
-    // 填充常用汉字
-    for (int i = 0; i < hanCount; i++) {
-        codepoints[asciiCount + i] = minHan + i;
+    if (state->titleFont.texture.id == 0) {
+        TraceLog(LOG_WARNING, "粗体字体加载失败，使用默认字体");
+        state->titleFont = GetFontDefault();
     }
-    
-    // 填充额外字符
-    const int extraChars[] = {0x3000, 0x3001, 0x3002, 0xFF01, 0xFF08, 0xFF09}; // 中文标点等
-    for (int i = 0; i < extraCount; i++) {
-        if (i < sizeof(extraChars)/sizeof(extraChars[0])) {
-            codepoints[asciiCount + hanCount + i] = extraChars[i];
-        } else {
-            codepoints[asciiCount + hanCount + i] = 0;
-        }
-    }
-    
-    return codepoints;
+
+    LogFontCacheStats(&state->textFont, "text");
+    LogFontCacheStats(&state->titleFont, "title");
+
+    return true;
 }
 
 // 卸载资源
 void UnloadResources(AppState *state) {
-    if (state->textFont.texture.id != 0 && state->textFont.texture.id != GetFontDefault().texture.id) {
-        UnloadFont(state->textFont);
-    }
-    if (state->titleFont.texture.id != 0 && state->titleFont.texture.id != GetFontDefault().texture.id) {
-        UnloadFont(state->titleFont);
-    }
-    if (state->achieveIcon.id != 0) {
-        UnloadTexture(state->achieveIcon);
-    }
-    for (int i = 0; i < STUDY_IMAGE_COUNT; i++) {
-        if (state->studyImages[i].id != 0) {
-            UnloadTexture(state->studyImages[i]);
-        }
-    }
-    // 卸载皮肤图标
-    if (state->sunTexture.id != 0) {
-        UnloadTexture(state->sunTexture);
-    }
-    if (state->moonTexture.id != 0) {
-        UnloadTexture(state->moonTexture);
-    }
-    // 卸载成就图标
-    if (state->achieveIconLight.id != 0) {
-        UnloadTexture(state->achieveIconLight);
-    }
-    if (state->achieveIconDark.id != 0) {
-        UnloadTexture(state->achieveIconDark);
-    }
-    // 卸载统计图标
-    if (state->dateIconLight.id != 0) {
-        UnloadTexture(state->dateIconLight);
-    }
-    if (state->dateIconDark.id != 0) {
-        UnloadTexture(state->dateIconDark);
-    }
+    LogFontCacheStats(&state->textFont, "text");
+    LogFontCacheStats(&state->titleFont, "title");
+    UnloadFontCached(&state->textFont);
+    UnloadFontCached(&state->titleFont);
+    ShutdownTextureResidency();
+    // 卸载图标图集（同时恢复默认形状纹理）
+    UnloadIconAtlas(&state->icons);
+    // 卸载界面静态层
+    UnloadUILayer(&state->mainLayer);
+    UnloadUILayer(&state->achievementLayer);
+    UnloadStatisticsScreen();
 }
 
 void ProcessTimerCompletion(AppState *state) {
-    bool pomodoroCompleted = false;
-    bool trashCleaned = false;
-    
     if (state->timeLeft <= 0) {
         state->timerActive = false;
-        
-        if (state->currentTrashIndex >= 0) {
-            CleanTrash(state->currentTrashIndex);
-            state->achievementManager.cleanedTrashCount++;
-            trashCleaned = true;
-            state->currentTrashIndex = -1;
-        } else {
-            state->achievementManager.totalPomodoros++;
-            state->interruptionOccurred = false;
-            pomodoroCompleted = true;
-            
-            // 更新番茄钟类型统计
-            if (state->pomodoroDuration == 25 * 60) {
-                state->statistics.pomodoros25++;
-            } else if (state->pomodoroDuration == 45 * 60) {
-                state->statistics.pomodoros45++;
-            } else {
-                state->statistics.pomodorosCustom++;
-            }
-        }
-        
-        // 统一在此处检查成就
-        CheckAchievements(&state->achievementManager, 
-                         pomodoroCompleted, 
-                         trashCleaned, 
-                         state->pomodoroDuration);
+        CompleteTimerSession(state);
     }
 }
 
 
 int main(void) {
-    // 状态文件路径
+    // 旧版本的垃圾存档，只在没有状态快照时迁移
     const char* trashStateFile = "trash_state.dat";
-    const char* appStateFile = "app_state.dat";
     
-    // 尝试加载应用状态
-    PersistentAppState persistentState = {0};
+    // 默认初始化，持久化的设置在窗口创建后随快照一起加载
     AppState state = {0};
-    
-    FILE* appState = fopen(appStateFile, "rb");
-    if (appState) {
-        fread(&persistentState, sizeof(PersistentAppState), 1, appState);
-        fclose(appState);
-        TraceLog(LOG_INFO, "应用状态已加载");
-        
-        // 应用持久化状态
-        state.windowWidth = persistentState.windowWidth > 0 ? persistentState.windowWidth : INIT_WIDTH;
-        state.windowHeight = persistentState.windowHeight > 0 ? persistentState.windowHeight : INIT_HEIGHT;
-        state.windowX = persistentState.windowX;
-        state.windowY = persistentState.windowY;
-        state.selectedPreset = persistentState.selectedPreset;
-        strcpy(state.customMinutes, persistentState.customMinutes);
-    } else {
-        // 默认初始化
-        state.windowWidth = INIT_WIDTH;
-        state.windowHeight = INIT_HEIGHT;
-        state.windowX = 100;
-        state.windowY = 100;
-        state.selectedPreset = 0;
-        state.customMinutes[0] = '\0';
-    }
+    state.windowWidth = INIT_WIDTH;
+    state.windowHeight = INIT_HEIGHT;
+    state.windowX = 100;
+    state.windowY = 100;
+    state.selectedPreset = 0;
+    state.customMinutes[0] = '\0';
 
     // ===== 关键修改：窗口初始化部分 =====
     
@@ -1439,14 +1897,8 @@ int main(void) {
     state.windowX = GetWindowPosition().x;
     state.windowY = GetWindowPosition().y;
 
-    // 加载主题状态
-    state.isDarkTheme = LoadAppThemeState();
-
     // 初始化垃圾系统
-    LoadTrashSystem(trashStateFile);
-    if (trashCount == 0) {
-        InitTrashSystem();
-    }
+    InitTrashSystem();
  
     // 初始化AppState
     state.windowShake = (WindowShake){0};
@@ -1454,8 +1906,10 @@ int main(void) {
 
     // 初始化统计数据
     state.statisticsFile = "statistics.dat";
+    InitMetricsStore(&state.metrics);
     InitStatistics(&state.statistics);
-    LoadStatistics(&state.statistics, state.statisticsFile);
+    BindStatisticsView(&state.statistics, &state.metrics);
+    InitSessionHistory(&state.history);
     
     // 初始化番茄钟预设
     state.presets[0] = (PomodoroPreset){"25分钟", 25};
@@ -1464,20 +1918,36 @@ int main(void) {
     
     // 初始化成就系统
     state.achievementFile = "achievements.dat";
+    if (LoadAchievementDefinitions(ACHIEVEMENT_DEFS_FILE)) {
+        TraceLog(LOG_INFO, "已加载成就定义: %s (%d 个)", ACHIEVEMENT_DEFS_FILE, GetAchievementDefCount());
+    } else if (FileExists(ACHIEVEMENT_DEFS_FILE)) {
+        TraceLog(LOG_WARNING, "成就定义文件无效，使用内置定义: %s", ACHIEVEMENT_DEFS_FILE);
+    }
     state.achievementManager = (AchievementManager){0};
-    LoadAchievements(&state.achievementManager, state.achievementFile);
+    InitAchievementManager(&state.achievementManager);
+
+    // 恢复持久化状态：快照加日志回放，首次运行时迁移旧存档
+    LoadPersistentState(&state, trashStateFile);
     
     // 初始化计时器相关状态
     state.pomodoroDuration = state.presets[0].minutes * 60;
     state.timeLeft = state.pomodoroDuration;
     state.currentStudyImage = GetRandomValue(0, STUDY_IMAGE_COUNT - 1);
+    state.nextStudyImage = GetRandomValue(0, STUDY_IMAGE_COUNT - 1);
     state.currentScreen = MAIN_SCREEN;
     state.windowFocused = true;
-    state.currentTrashIndex = -1;
+    state.cleanupTrashCount = 0;
+    state.selectingTrash = false;
     state.interruptionOccurred = false;
     
     SetRandomSeed((unsigned int)time(NULL));
 
+    // 加载界面动画同样需要限帧
+    SetTargetFPS(60);
+
+    // 学习图片闲置超过该时间后卸载
+    InitTextureResidency(DEFAULT_TEXTURE_IDLE_SECONDS);
+
     // 加载资源（确保在窗口初始化后）
     if (!LoadResources(&state)) {
         TraceLog(LOG_ERROR, "资源加载失败");
@@ -1485,20 +1955,32 @@ int main(void) {
         return 1;
     }
 
-    SetTargetFPS(60);
-
     // 窗口聚焦监测
     bool wasFocused = true;
     double focusLostTime = 0;
     const double FOCUS_LOSS_TOLERANCE = 3.0; // 3秒容忍时间
 
-    // 确保主题图标正确初始化
-    state.themeIcon = state.isDarkTheme ? state.moonTexture : state.sunTexture;
-    
     // === 关键修复：定义 lastWindowPos ===
     Vector2 lastWindowPos = GetWindowPosition();
+
+    // 静止时不再按 60 FPS 重绘，只在输入、动画或计时跳秒时绘制
+    InitFramePacer();
         
     while (!WindowShouldClose()) {
+        BeginFramePacing();
+
+        // 后台资源每帧最多占用 4ms 上传
+        if (!IsAssetLoadingComplete()) {
+            KeepFrameAwake();
+            if (PumpAssetLoader(0.004) > 0) MarkFrameDirty();
+        }
+        if (UpdateTextureResidency(0.004) > 0) MarkFrameDirty();
+        if (IsTextureResidencyBusy()) KeepFrameAwake();
+
+        // 闲置纹理到期时需要醒来卸载
+        double evictionTime = GetTextureEvictionTime();
+        if (evictionTime >= 0.0) ScheduleFrameAt(evictionTime + 0.01);
+
         Vector2 currentWindowPos = GetWindowPosition();
         
         // 实时更新窗口加速度
@@ -1510,16 +1992,20 @@ int main(void) {
             if (wasFocused && !isFocused) {
                 // 立即处理中断逻辑
                 state.interruptionOccurred = true;
-                state.achievementManager.interruptionsCount++;
-                state.achievementManager.generatedTrashCount++; // 增加产生垃圾数
-                GenerateTrash(state.pomodoroDuration / 60);
+                unsigned int trashId = CommitGeneratedTrash(&state, GenerateTrash(state.pomodoroDuration / 60));
+
+                // 中断计数、标记与成就检查由事件完成
+                SessionEvent interruption = {
+                    state.pomodoroDuration,
+                    state.pomodoroDuration - state.timeLeft,
+                    GetCurrentSessionPreset(&state),
+                    trashId
+                };
+                StateWriter payload;
+                BeginEventPayload(&payload);
+                WriteSessionEvent(&payload, &interruption);
+                CommitAppEvent(&state, EVENT_INTERRUPTION, &payload);
                 state.currentScreen = INTERRUPTION_ALERT;
-
-                // 设置中断标记
-                state.achievementManager.interruptionOccurred = true;
-                
-                // 关键修改：中断发生时检查成就
-                CheckAchievements(&state.achievementManager, false, false, state.pomodoroDuration);
                 
                 // 震动效果
                 TriggerWindowShake(&state, 15.0f, 0.7f);
@@ -1530,20 +2016,16 @@ int main(void) {
         // 优化：减少垃圾更新频率
         static int trashUpdateCounter = 0;
         trashUpdateCounter++;
-        UpdateTrash();
-        
-        // 修复数据统计
-        if (state.currentScreen == STATISTICS_SCREEN) {
-            // 确保使用最新数据
-            state.statistics.totalPomodoros = state.achievementManager.totalPomodoros;
-            state.statistics.cleanedTrash = state.achievementManager.cleanedTrashCount;
-            state.statistics.generatedTrash = state.achievementManager.generatedTrashCount;
-            state.statistics.interruptions = state.achievementManager.interruptionsCount;
-            state.statistics.streakDays = state.achievementManager.streakDays;
-            state.statistics.longSessions = state.achievementManager.longSessionCount;
-        }
-        
+        float frameDelta = GetPacedFrameTime();
+        UpdateTrash(frameDelta);
+        if (IsTrashAnimating()) KeepFrameAnimating();
+
+        UpdateStateSnapshot(&state);
+
+        float shakeDelta = frameDelta;
+        if (UpdateWindowShake(&state, shakeDelta > 0.1f ? 0.1f : shakeDelta)) KeepFrameAnimating();
         
+
         // 更新窗口尺寸
         state.windowWidth = GetScreenWidth();
         state.windowHeight = GetScreenHeight();
@@ -1565,13 +2047,7 @@ int main(void) {
                 IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
                 
                 // 切换主题
-                state.isDarkTheme = !state.isDarkTheme;
-                
-                // 更新图标
-                state.themeIcon = state.isDarkTheme ? state.moonTexture : state.sunTexture;
-                
-                // 保存主题设置
-                SaveAppThemeState(state.isDarkTheme);
+                CommitSetting(&state, SETTING_THEME, !state.isDarkTheme, NULL);
             }
         }
         
@@ -1586,7 +2062,7 @@ int main(void) {
             TraceLog(LOG_DEBUG, "重置计时器");
             state.timerActive = false;
             state.timeLeft = state.pomodoroDuration;
-            state.currentStudyImage = GetRandomValue(0, STUDY_IMAGE_COUNT - 1);
+            PickStudyImage(&state);
         }
 
         // 重置当前任务信息 - 这是唯一的时间更新逻辑
@@ -1604,12 +2080,16 @@ int main(void) {
                 int secondsToDeduct = (int)accumulatedTime; // 取整数部分
                 state.timeLeft -= secondsToDeduct; // 减少秒数
                 accumulatedTime -= secondsToDeduct; // 保留小数部分
+                MarkFrameDirty();
                 
                 // 防止时间变为负数
                 if (state.timeLeft < 0) {
                     state.timeLeft = 0;
                 }
             }
+
+            // 计时显示只在跳秒时变化
+            ScheduleFrameAt(currentTime + (1.0 - accumulatedTime) + 0.001);
             
             // 检查计时结束
             if (state.timeLeft <= 0) {
@@ -1623,6 +2103,13 @@ int main(void) {
             HandleMainScreenInput(&state, screenWidth, screenHeight);
         }
         
+        // 没有变化时跳过绘制，等待输入事件或下一次定时唤醒
+        if (!ShouldRenderFrame()) {
+            lastWindowPos = currentWindowPos;
+            WaitForNextFrame();
+            continue;
+        }
+
         // 开始绘制
         BeginDrawing();
         ClearBackground(RAYWHITE);
@@ -1666,11 +2153,7 @@ int main(void) {
                     40.0f
                 }) && IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || 
                 IsKeyPressed(KEY_ENTER)) {
-                    if (state.currentTrashIndex >= 0) {
-                        trashes[state.currentTrashIndex].cleaning = false;
-                        trashes[state.currentTrashIndex].cleanProgress = 0.0f;
-                    }
-                    state.currentTrashIndex = -1;
+                    state.cleanupTrashCount = 0;
                     state.currentScreen = MAIN_SCREEN;
                     TraceLog(LOG_DEBUG, "返回主屏幕");
                 }
@@ -1687,7 +2170,7 @@ int main(void) {
                 break;
 
             case STATISTICS_SCREEN:
-                DrawStatisticsScreen(&state.statistics, state.textFont, 
+                DrawStatisticsScreen(&state.statistics, &state.history, &state.textFont, 
                                     state.isDarkTheme, screenWidth, screenHeight);
                 // 处理返回按钮
                 Rectangle backButton = {
@@ -1714,32 +2197,26 @@ int main(void) {
         EndDrawing();
     }
 
-    // 程序退出前保存状态
-    SaveTrashSystem(trashStateFile);
-
-    // 程序退出前保存统计数据
-    SaveStatistics(&state.statistics, state.statisticsFile);
-    
-    // 保存持久化应用状态
-    PersistentAppState persistentStateToSave = {
-        .windowWidth = state.windowWidth,
-        .windowHeight = state.windowHeight,
-        .windowX = state.windowX,
-        .windowY = state.windowY,
-        .selectedPreset = state.selectedPreset
-    };
-    strcpy(persistentStateToSave.customMinutes, state.customMinutes);
-    
-    FILE* saveAppState = fopen(appStateFile, "wb");
-    if (saveAppState) {
-        fwrite(&persistentStateToSave, sizeof(PersistentAppState), 1, saveAppState);
-        fclose(saveAppState);
-        TraceLog(LOG_INFO, "应用状态已保存");
-    }
-    
-    SaveAchievements(&state.achievementManager, state.achievementFile);
-
-    // 清理资源
+    // 程序退出前写最终快照（窗口位置等不产生事件的状态也在其中），先等进行中的快照写完
+    FlushStateJournal();
+    CompactStateJournal(&state);
+    CloseStateJournal();
+    JournalStats journalStats = GetStateJournalStats();
+    TraceLog(LOG_INFO, "状态日志: 追加 %lu 条事件, 落盘 %lu 次, %lu 字节, 快照 %lu 次%s",
+             journalStats.records, journalStats.batches, journalStats.bytes, journalStats.checkpoints,
+             journalStats.failed ? " (有写入失败)" : "");
+    FreeTrashSystem();
+    FreeAchievementManager(&state.achievementManager);
+    FreeSessionHistory(&state.history);
+
+    LogFramePacerStats();
+    LogTrashStepStats();
+    LogTextCacheStats();
+    ClearTextCache();
+
+    // 清理资源（先停止后台加载，避免上传到已卸载的目标）
+    ShutdownAssetLoader();
+    ShutdownWorkerPool();
     UnloadResources(&state);
     
     CloseWindow();
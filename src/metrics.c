@@ -0,0 +1,75 @@
+#include "metrics.h"
+#include <string.h>
+
+static const char *metricNames[METRIC_COUNT] = {
+    "total_pomodoros", "cleaned_trash", "generated_trash", "interruptions",
+    "long_sessions", "streak_days", "pomodoros_25", "pomodoros_45", "pomodoros_custom",
+    "consecutive_pomodoros", "daily_pomodoros", "broken_streaks", "trash_all_cleaned"
+};
+
+void InitMetricsStore(MetricsStore *metrics) {
+    memset(metrics, 0, sizeof(MetricsStore));
+}
+
+void ResetMetrics(MetricsStore *metrics) {
+    for (int i = 0; i < METRIC_COUNT; i++) SetMetric(metrics, (MetricID)i, 0);
+}
+
+bool AddMetricsListener(MetricsStore *metrics, MetricsListener func, void *userData) {
+    if (metrics->listenerCount >= MAX_METRICS_LISTENERS) return false;
+    metrics->listeners[metrics->listenerCount].func = func;
+    metrics->listeners[metrics->listenerCount].userData = userData;
+    metrics->listenerCount++;
+    return true;
+}
+
+int GetMetric(const MetricsStore *metrics, MetricID id) {
+    if (id < 0 || id >= METRIC_COUNT) return 0;
+    return metrics->values[id];
+}
+
+void SetMetric(MetricsStore *metrics, MetricID id, int value) {
+    if (id < 0 || id >= METRIC_COUNT || metrics->values[id] == value) return;
+
+    metrics->values[id] = value;
+    metrics->version++;
+    for (int i = 0; i < metrics->listenerCount; i++) {
+        metrics->listeners[i].func(id, value, metrics->listeners[i].userData);
+    }
+}
+
+void AddMetric(MetricsStore *metrics, MetricID id, int delta) {
+    SetMetric(metrics, id, GetMetric(metrics, id) + delta);
+}
+
+const char *GetMetricName(MetricID id) {
+    if (id < 0 || id >= METRIC_COUNT) return "";
+    return metricNames[id];
+}
+
+MetricID FindMetricByName(const char *name) {
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        if (strcmp(metricNames[i], name) == 0) return (MetricID)i;
+    }
+    return METRIC_COUNT;
+}
+
+void WriteMetricsSection(StateWriter *writer, const MetricsStore *metrics) {
+    BeginStateSection(writer, METRICS_SECTION_TAG, METRICS_SECTION_VERSION);
+    WriteStateU32(writer, METRIC_COUNT);
+    for (int i = 0; i < METRIC_COUNT; i++) WriteStateI32(writer, metrics->values[i]);
+    EndStateSection(writer);
+}
+
+// 新版本追加的指标被忽略，旧版本缺少的指标保持 0
+bool ReadMetricsSection(const StateFile *file, MetricsStore *metrics) {
+    StateReader reader;
+    if (!FindStateSection(file, METRICS_SECTION_TAG, 1, METRICS_SECTION_VERSION, &reader)) return false;
+
+    uint32_t count = ReadStateU32(&reader);
+    for (uint32_t i = 0; i < count; i++) {
+        int value = ReadStateI32(&reader);
+        if (i < METRIC_COUNT) SetMetric(metrics, (MetricID)i, value);
+    }
+    return true;
+}
@@ -0,0 +1,267 @@
+#include "session_history.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+void InitSessionHistory(SessionHistory *history) {
+    memset(history, 0, sizeof(SessionHistory));
+}
+
+void FreeSessionHistory(SessionHistory *history) {
+    free(history->startTimes);
+    free(history->durations);
+    free(history->presets);
+    free(history->outcomes);
+    free(history->trashIds);
+    free(history->days);
+    free(history->dayTotals);
+    free(history->dayPrefix);
+    memset(history, 0, sizeof(SessionHistory));
+}
+
+void ClearSessionHistory(SessionHistory *history) {
+    history->count = 0;
+    history->dayCount = 0;
+    history->version++;
+}
+
+static bool GrowColumn(void **column, int capacity, size_t elementSize) {
+    void *grown = realloc(*column, (size_t)capacity * elementSize);
+    if (grown == NULL) return false;
+    *column = grown;
+    return true;
+}
+
+static bool ReserveSessions(SessionHistory *history, int count) {
+    if (count <= history->capacity) return true;
+
+    int capacity = (history->capacity > 0) ? history->capacity : 256;
+    while (capacity < count) capacity *= 2;
+    if (!GrowColumn((void **)&history->startTimes, capacity, sizeof(int64_t)) ||
+        !GrowColumn((void **)&history->durations, capacity, sizeof(int32_t)) ||
+        !GrowColumn((void **)&history->presets, capacity, sizeof(uint8_t)) ||
+        !GrowColumn((void **)&history->outcomes, capacity, sizeof(uint8_t)) ||
+        !GrowColumn((void **)&history->trashIds, capacity, sizeof(uint32_t))) {
+        return false;
+    }
+    history->capacity = capacity;
+    return true;
+}
+
+static bool ReserveDays(SessionHistory *history, int count) {
+    if (count <= history->dayCapacity) return true;
+
+    int capacity = (history->dayCapacity > 0) ? history->dayCapacity : 64;
+    while (capacity < count) capacity *= 2;
+    if (!GrowColumn((void **)&history->days, capacity, sizeof(int32_t)) ||
+        !GrowColumn((void **)&history->dayTotals, capacity, sizeof(SessionTotals)) ||
+        !GrowColumn((void **)&history->dayPrefix, capacity, sizeof(SessionTotals))) {
+        return false;
+    }
+    history->dayCapacity = capacity;
+    return true;
+}
+
+static void AddSessionTotals(SessionTotals *totals, const SessionTotals *add) {
+    totals->focusSeconds += add->focusSeconds;
+    totals->sessions += add->sessions;
+    totals->completed += add->completed;
+    totals->interrupted += add->interrupted;
+    totals->cleanups += add->cleanups;
+}
+
+static void SubtractSessionTotals(SessionTotals *totals, const SessionTotals *sub) {
+    totals->focusSeconds -= sub->focusSeconds;
+    totals->sessions -= sub->sessions;
+    totals->completed -= sub->completed;
+    totals->interrupted -= sub->interrupted;
+    totals->cleanups -= sub->cleanups;
+}
+
+// 第一个日期不小于 day 的索引项
+static int FindSessionDay(const SessionHistory *history, int32_t day) {
+    int low = 0;
+    int high = history->dayCount;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (history->days[mid] < day) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// 记录按时间顺序追加时只改最后一项；系统时间被调回时插入到中间，之后的累计值重算
+static bool IndexSession(SessionHistory *history, int32_t day, const SessionTotals *totals) {
+    int index = FindSessionDay(history, day);
+    if (index == history->dayCount || history->days[index] != day) {
+        if (!ReserveDays(history, history->dayCount + 1)) return false;
+        int tail = history->dayCount - index;
+        memmove(&history->days[index + 1], &history->days[index], (size_t)tail * sizeof(int32_t));
+        memmove(&history->dayTotals[index + 1], &history->dayTotals[index], (size_t)tail * sizeof(SessionTotals));
+        memmove(&history->dayPrefix[index + 1], &history->dayPrefix[index], (size_t)tail * sizeof(SessionTotals));
+        history->days[index] = day;
+        history->dayTotals[index] = (SessionTotals){0};
+        history->dayCount++;
+    }
+
+    AddSessionTotals(&history->dayTotals[index], totals);
+    for (int i = index; i < history->dayCount; i++) {
+        history->dayPrefix[i] = history->dayTotals[i];
+        if (i > 0) AddSessionTotals(&history->dayPrefix[i], &history->dayPrefix[i - 1]);
+    }
+    return true;
+}
+
+bool AppendSession(SessionHistory *history, const SessionRecord *record) {
+    if (!ReserveSessions(history, history->count + 1)) return false;
+
+    SessionTotals totals = {
+        .focusSeconds = (record->duration > 0) ? record->duration : 0,
+        .sessions = 1,
+        .completed = record->outcome == SESSION_COMPLETED,
+        .interrupted = record->outcome == SESSION_INTERRUPTED,
+        .cleanups = record->outcome == SESSION_CLEANUP
+    };
+    if (!IndexSession(history, GetSessionDay(record->startTime), &totals)) return false;
+
+    int index = history->count++;
+    history->startTimes[index] = record->startTime;
+    history->durations[index] = record->duration;
+    history->presets[index] = record->preset;
+    history->outcomes[index] = record->outcome;
+    history->trashIds[index] = record->trashId;
+    history->version++;
+    return true;
+}
+
+SessionRecord GetSession(const SessionHistory *history, int index) {
+    return (SessionRecord){
+        .startTime = history->startTimes[index],
+        .duration = history->durations[index],
+        .preset = history->presets[index],
+        .outcome = history->outcomes[index],
+        .trashId = history->trashIds[index]
+    };
+}
+
+// ===== 日期换算 =====
+// 公历日期与 1970-01-01 起的天数互换，不经过 mktime，闰年规则按 400 年周期计算
+
+int32_t GetSessionDayFromDate(int year, int month, int day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yearOfEra = year - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+void GetSessionDate(int32_t day, int *year, int *month, int *dayOfMonth) {
+    day += 719468;
+    int era = (day >= 0 ? day : day - 146096) / 146097;
+    int dayOfEra = day - era * 146097;
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int monthIndex = (5 * dayOfYear + 2) / 153;
+    *dayOfMonth = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    *month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    *year = yearOfEra + era * 400 + (*month <= 2);
+}
+
+int32_t GetSessionDay(int64_t time) {
+    time_t value = (time_t)time;
+    struct tm *local = localtime(&value);
+    if (local == NULL) return (int32_t)(time / 86400);
+    return GetSessionDayFromDate(local->tm_year + 1900, local->tm_mon + 1, local->tm_mday);
+}
+
+int GetSessionWeekday(int32_t day) {
+    // 1970-01-01 是周四
+    int weekday = (day + 3) % 7;
+    return weekday < 0 ? weekday + 7 : weekday;
+}
+
+int32_t GetSessionWeekStart(int32_t day) {
+    return day - GetSessionWeekday(day);
+}
+
+int32_t GetSessionMonthStart(int32_t day) {
+    int year, month, dayOfMonth;
+    GetSessionDate(day, &year, &month, &dayOfMonth);
+    return day - (dayOfMonth - 1);
+}
+
+// ===== 查询 =====
+
+SessionTotals QuerySessionDays(const SessionHistory *history, int32_t firstDay, int32_t lastDay) {
+    SessionTotals totals = {0};
+    if (firstDay > lastDay) return totals;
+
+    int first = FindSessionDay(history, firstDay);
+    int end = FindSessionDay(history, lastDay + 1);
+    if (first >= end) return totals;
+
+    totals = history->dayPrefix[end - 1];
+    if (first > 0) SubtractSessionTotals(&totals, &history->dayPrefix[first - 1]);
+    return totals;
+}
+
+// 范围内只遍历有记录的日期
+void QuerySessionWeekdays(const SessionHistory *history, int32_t firstDay, int32_t lastDay, SessionTotals weekdays[7]) {
+    memset(weekdays, 0, 7 * sizeof(SessionTotals));
+    int end = FindSessionDay(history, lastDay + 1);
+    for (int i = FindSessionDay(history, firstDay); i < end; i++) {
+        AddSessionTotals(&weekdays[GetSessionWeekday(history->days[i])], &history->dayTotals[i]);
+    }
+}
+
+// ===== 存档 =====
+
+void WriteSessionHistorySection(StateWriter *writer, const SessionHistory *history) {
+    BeginStateSection(writer, SESSION_SECTION_TAG, SESSION_SECTION_VERSION);
+    WriteStateU32(writer, (uint32_t)history->count);
+    WriteStateU32(writer, 0);
+    for (int i = 0; i < history->count; i++) WriteStateI64(writer, history->startTimes[i]);
+    for (int i = 0; i < history->count; i++) WriteStateI32(writer, history->durations[i]);
+    for (int i = 0; i < history->count; i++) WriteStateU32(writer, history->trashIds[i]);
+    WriteStateBytes(writer, history->presets, (size_t)history->count);
+    WriteStateBytes(writer, history->outcomes, (size_t)history->count);
+    EndStateSection(writer);
+}
+
+bool ReadSessionHistorySection(const StateFile *file, SessionHistory *history) {
+    StateReader reader;
+    if (!FindStateSection(file, SESSION_SECTION_TAG, 1, SESSION_SECTION_VERSION, &reader)) return false;
+
+    ClearSessionHistory(history);
+    uint32_t count = ReadStateU32(&reader);
+    ReadStateU32(&reader);
+    if (count > GetStateReaderRemaining(&reader) / 18) return false;   // 每条记录 18 字节
+    if (!ReserveSessions(history, (int)count)) return false;
+
+    // 各列在映射内存中连续存放，逐列读取
+    StateReader durations = reader;
+    durations.offset += count * 8;
+    StateReader trashIds = durations;
+    trashIds.offset += count * 4;
+    StateReader bytes = trashIds;
+    bytes.offset += count * 4;
+    const uint8_t *presets = (const uint8_t*)ReadStateBytes(&bytes, count);
+    const uint8_t *outcomes = (const uint8_t*)ReadStateBytes(&bytes, count);
+    if (count > 0 && (presets == NULL || outcomes == NULL)) return false;
+
+    for (uint32_t i = 0; i < count; i++) {
+        SessionRecord record = {
+            .startTime = ReadStateI64(&reader),
+            .duration = ReadStateI32(&durations),
+            .preset = presets[i],
+            .outcome = outcomes[i],
+            .trashId = ReadStateU32(&trashIds)
+        };
+        if (!AppendSession(history, &record)) return false;
+    }
+    return true;
+}
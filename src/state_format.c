@@ -0,0 +1,297 @@
+#include "state_format.h"
+#include "atomic_file.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define STATE_HEADER_SIZE 32
+#define STATE_SECTION_ENTRY_SIZE 24
+#define STATE_SECTION_ALIGN 8
+
+static void PutU16(unsigned char *out, uint16_t value) {
+    out[0] = (unsigned char)value;
+    out[1] = (unsigned char)(value >> 8);
+}
+
+static void PutU32(unsigned char *out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out[i] = (unsigned char)(value >> (8 * i));
+}
+
+static void PutU64(unsigned char *out, uint64_t value) {
+    for (int i = 0; i < 8; i++) out[i] = (unsigned char)(value >> (8 * i));
+}
+
+static uint16_t GetU16(const unsigned char *in) {
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+static uint32_t GetU32(const unsigned char *in) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--) value = (value << 8) | in[i];
+    return value;
+}
+
+static uint64_t GetU64(const unsigned char *in) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) value = (value << 8) | in[i];
+    return value;
+}
+
+static uint32_t HashStateBytes(const unsigned char *data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// ===== 写入 =====
+
+void InitStateWriter(StateWriter *writer) {
+    memset(writer, 0, sizeof(StateWriter));
+}
+
+void FreeStateWriter(StateWriter *writer) {
+    free(writer->data);
+    memset(writer, 0, sizeof(StateWriter));
+}
+
+static unsigned char *ReserveStateBytes(StateWriter *writer, size_t size) {
+    if (writer->failed) return NULL;
+    if (!writer->open) {
+        writer->failed = true;
+        return NULL;
+    }
+
+    if (writer->size + size > writer->capacity) {
+        size_t capacity = (writer->capacity > 0) ? writer->capacity : 1024;
+        while (capacity < writer->size + size) capacity *= 2;
+        unsigned char *grown = (unsigned char*)realloc(writer->data, capacity);
+        if (grown == NULL) {
+            writer->failed = true;
+            return NULL;
+        }
+        writer->data = grown;
+        writer->capacity = capacity;
+    }
+
+    unsigned char *out = writer->data + writer->size;
+    writer->size += size;
+    return out;
+}
+
+void BeginStateSection(StateWriter *writer, uint32_t tag, uint32_t version) {
+    if (writer->open || writer->sectionCount >= STATE_MAX_SECTIONS) {
+        writer->failed = true;
+        return;
+    }
+
+    // 段起点对齐，映射后可以按自然对齐访问
+    writer->open = true;
+    size_t padding = (STATE_SECTION_ALIGN - writer->size % STATE_SECTION_ALIGN) % STATE_SECTION_ALIGN;
+    unsigned char *out = ReserveStateBytes(writer, padding);
+    if (out != NULL) memset(out, 0, padding);
+
+    StateSectionInfo *section = &writer->sections[writer->sectionCount];
+    section->tag = tag;
+    section->version = version;
+    section->offset = writer->size;
+    section->size = 0;
+}
+
+void EndStateSection(StateWriter *writer) {
+    if (!writer->open) {
+        writer->failed = true;
+        return;
+    }
+
+    StateSectionInfo *section = &writer->sections[writer->sectionCount];
+    size_t size = writer->size - (size_t)section->offset;
+    if (size > UINT32_MAX) writer->failed = true;
+    section->size = (uint32_t)size;
+    writer->sectionCount++;
+    writer->open = false;
+}
+
+void WriteStateU8(StateWriter *writer, uint8_t value) {
+    unsigned char *out = ReserveStateBytes(writer, 1);
+    if (out != NULL) out[0] = value;
+}
+
+void WriteStateU32(StateWriter *writer, uint32_t value) {
+    unsigned char *out = ReserveStateBytes(writer, 4);
+    if (out != NULL) PutU32(out, value);
+}
+
+void WriteStateI32(StateWriter *writer, int32_t value) {
+    WriteStateU32(writer, (uint32_t)value);
+}
+
+void WriteStateU64(StateWriter *writer, uint64_t value) {
+    unsigned char *out = ReserveStateBytes(writer, 8);
+    if (out != NULL) PutU64(out, value);
+}
+
+void WriteStateI64(StateWriter *writer, int64_t value) {
+    WriteStateU64(writer, (uint64_t)value);
+}
+
+// 按 IEEE 754 位模式存储
+void WriteStateF32(StateWriter *writer, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteStateU32(writer, bits);
+}
+
+void WriteStateBytes(StateWriter *writer, const void *data, size_t size) {
+    unsigned char *out = ReserveStateBytes(writer, size);
+    if (out != NULL && size > 0) memcpy(out, data, size);
+}
+
+bool SaveStateFile(StateWriter *writer, const char *path) {
+    if (writer->failed || writer->open) return false;
+
+    size_t tableSize = (size_t)writer->sectionCount * STATE_SECTION_ENTRY_SIZE;
+    size_t dataStart = STATE_HEADER_SIZE + tableSize;   // 32 + 24n，本身就是 8 的倍数
+    unsigned char header[STATE_HEADER_SIZE] = {0};
+    unsigned char table[STATE_MAX_SECTIONS * STATE_SECTION_ENTRY_SIZE];
+
+    for (int i = 0; i < writer->sectionCount; i++) {
+        const StateSectionInfo *section = &writer->sections[i];
+        unsigned char *entry = table + i * STATE_SECTION_ENTRY_SIZE;
+        PutU32(entry, section->tag);
+        PutU32(entry + 4, section->version);
+        PutU64(entry + 8, dataStart + section->offset);
+        PutU32(entry + 16, section->size);
+        PutU32(entry + 20, HashStateBytes(writer->data + section->offset, section->size));
+    }
+
+    PutU32(header, STATE_FORMAT_MAGIC);
+    PutU16(header + 4, STATE_FORMAT_VERSION);
+    PutU16(header + 6, 1);   // 版本 1 的读取方即可读取
+    PutU32(header + 8, (uint32_t)writer->sectionCount);
+    PutU32(header + 12, HashStateBytes(table, tableSize));
+    PutU64(header + 16, dataStart + writer->size);
+
+    AtomicFile atomic;
+    if (!BeginAtomicFile(&atomic, path)) return false;
+    fwrite(header, sizeof(header), 1, atomic.file);
+    if (tableSize > 0) fwrite(table, tableSize, 1, atomic.file);
+    if (writer->size > 0) fwrite(writer->data, writer->size, 1, atomic.file);
+    return CommitAtomicFile(&atomic);
+}
+
+// ===== 读取 =====
+
+StateFileResult OpenStateFile(StateFile *file, const char *path) {
+    memset(file, 0, sizeof(StateFile));
+    if (!MapFile(&file->map, path)) {
+        // 空文件也无法映射，当作不存在
+        return STATE_FILE_MISSING;
+    }
+
+    const unsigned char *data = file->map.data;
+    size_t size = file->map.size;
+    if (size < 4 || GetU32(data) != STATE_FORMAT_MAGIC) {
+        UnmapFile(&file->map);
+        return STATE_FILE_LEGACY;
+    }
+
+    bool valid = size >= STATE_HEADER_SIZE && GetU16(data + 6) <= STATE_FORMAT_VERSION;
+    uint32_t sectionCount = valid ? GetU32(data + 8) : 0;
+    size_t tableSize = (size_t)sectionCount * STATE_SECTION_ENTRY_SIZE;
+    valid = valid && sectionCount <= STATE_MAX_SECTIONS &&
+            GetU64(data + 16) == size && STATE_HEADER_SIZE + tableSize <= size &&
+            GetU32(data + 12) == HashStateBytes(data + STATE_HEADER_SIZE, tableSize);
+    if (!valid) {
+        UnmapFile(&file->map);
+        return STATE_FILE_CORRUPT;
+    }
+
+    file->sectionCount = sectionCount;
+    return STATE_FILE_OK;
+}
+
+void CloseStateFile(StateFile *file) {
+    UnmapFile(&file->map);
+    file->sectionCount = 0;
+}
+
+bool FindStateSection(const StateFile *file, uint32_t tag, uint32_t minVersion, uint32_t maxVersion, StateReader *reader) {
+    memset(reader, 0, sizeof(StateReader));
+    const unsigned char *table = file->map.data + STATE_HEADER_SIZE;
+
+    for (uint32_t i = 0; i < file->sectionCount; i++) {
+        const unsigned char *entry = table + i * STATE_SECTION_ENTRY_SIZE;
+        if (GetU32(entry) != tag) continue;
+
+        uint32_t version = GetU32(entry + 4);
+        uint64_t offset = GetU64(entry + 8);
+        uint32_t size = GetU32(entry + 16);
+        if (version < minVersion || version > maxVersion) return false;
+        if (offset > file->map.size || size > file->map.size - offset) return false;
+
+        const unsigned char *data = file->map.data + offset;
+        if (GetU32(entry + 20) != HashStateBytes(data, size)) return false;
+
+        reader->data = data;
+        reader->size = size;
+        reader->version = version;
+        return true;
+    }
+    return false;
+}
+
+void InitStateReader(StateReader *reader, const void *data, uint32_t size) {
+    memset(reader, 0, sizeof(StateReader));
+    reader->data = (const unsigned char*)data;
+    reader->size = size;
+}
+
+static const unsigned char *TakeStateBytes(StateReader *reader, uint32_t size) {
+    if (reader->size - reader->offset < size) {
+        reader->offset = reader->size;
+        return NULL;
+    }
+    const unsigned char *in = reader->data + reader->offset;
+    reader->offset += size;
+    return in;
+}
+
+uint8_t ReadStateU8(StateReader *reader) {
+    const unsigned char *in = TakeStateBytes(reader, 1);
+    return (in != NULL) ? in[0] : 0;
+}
+
+uint32_t ReadStateU32(StateReader *reader) {
+    const unsigned char *in = TakeStateBytes(reader, 4);
+    return (in != NULL) ? GetU32(in) : 0;
+}
+
+int32_t ReadStateI32(StateReader *reader) {
+    return (int32_t)ReadStateU32(reader);
+}
+
+uint64_t ReadStateU64(StateReader *reader) {
+    const unsigned char *in = TakeStateBytes(reader, 8);
+    return (in != NULL) ? GetU64(in) : 0;
+}
+
+int64_t ReadStateI64(StateReader *reader) {
+    return (int64_t)ReadStateU64(reader);
+}
+
+float ReadStateF32(StateReader *reader) {
+    uint32_t bits = ReadStateU32(reader);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+const void *ReadStateBytes(StateReader *reader, uint32_t size) {
+    return TakeStateBytes(reader, size);
+}
+
+uint32_t GetStateReaderRemaining(const StateReader *reader) {
+    return reader->size - reader->offset;
+}
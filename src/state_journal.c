@@ -0,0 +1,433 @@
+#include "state_journal.h"
+#include "atomic_file.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    typedef HANDLE JournalThread;
+    typedef CRITICAL_SECTION JournalMutex;
+    typedef CONDITION_VARIABLE JournalCond;
+#else
+    #include <pthread.h>
+    typedef pthread_t JournalThread;
+    typedef pthread_mutex_t JournalMutex;
+    typedef pthread_cond_t JournalCond;
+#endif
+
+#define JOURNAL_MAGIC 0x4C4E524Au    // "JRNL"
+#define JOURNAL_VERSION 1u
+#define JOURNAL_HEADER_SIZE 8        // magic + version
+#define JOURNAL_RECORD_HEADER_SIZE 32
+
+// 记录头（小端）: u32 负载长度 | u32 校验和 | u64 序号 | i64 时间 | u32 类型 | u32 保留
+// 校验和覆盖校验和之后的记录头与负载
+
+static FILE *journalFile = NULL;
+static JournalThread journalThread;
+static bool journalThreadRunning = false;
+static JournalMutex journalMutex;
+static JournalCond journalWork;        // 有待写入的记录或需要退出
+static JournalCond journalWritten;     // 一批记录已落盘
+static unsigned char *pendingBuffer = NULL;   // 主线程追加到这里
+static size_t pendingSize = 0;
+static size_t pendingCapacity = 0;
+static unsigned char *writeBuffer = NULL;     // 写线程正在写的一批，与 pendingBuffer 交换
+static size_t writeCapacity = 0;
+static bool journalWriting = false;
+static bool journalStopping = false;
+static JournalCheckpointFunc checkpointSave = NULL;   // 已提交、写线程尚未开始的快照
+static void *checkpointData = NULL;
+static int checkpointRecords = 0;      // 提交快照时日志中的记录数，清空后只扣除这些
+static bool checkpointActive = false;  // 从提交到写完
+static uint64_t journalSequence = 0;   // 已分配的最大序号
+static int journalRecordCount = 0;
+static JournalStats journalStats = {0};
+
+// ---------------- 平台封装 ----------------
+#if defined(_WIN32)
+static void LockJournal(void) { EnterCriticalSection(&journalMutex); }
+static void UnlockJournal(void) { LeaveCriticalSection(&journalMutex); }
+static void WaitJournal(JournalCond *cond) { SleepConditionVariableCS(cond, &journalMutex, INFINITE); }
+static void BroadcastJournal(JournalCond *cond) { WakeAllConditionVariable(cond); }
+#else
+static void LockJournal(void) { pthread_mutex_lock(&journalMutex); }
+static void UnlockJournal(void) { pthread_mutex_unlock(&journalMutex); }
+static void WaitJournal(JournalCond *cond) { pthread_cond_wait(cond, &journalMutex); }
+static void BroadcastJournal(JournalCond *cond) { pthread_cond_broadcast(cond); }
+#endif
+
+static void PutU32(unsigned char *out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out[i] = (unsigned char)(value >> (8 * i));
+}
+
+static void PutU64(unsigned char *out, uint64_t value) {
+    for (int i = 0; i < 8; i++) out[i] = (unsigned char)(value >> (8 * i));
+}
+
+static uint32_t GetU32(const unsigned char *in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= (uint32_t)in[i] << (8 * i);
+    return value;
+}
+
+static uint64_t GetU64(const unsigned char *in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) value |= (uint64_t)in[i] << (8 * i);
+    return value;
+}
+
+// FNV-1a
+static uint32_t HashJournalBytes(uint32_t hash, const unsigned char *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t GetRecordChecksum(const unsigned char *header, const unsigned char *payload, uint32_t size) {
+    uint32_t hash = HashJournalBytes(2166136261u, header + 8, JOURNAL_RECORD_HEADER_SIZE - 8);
+    return HashJournalBytes(hash, payload, size);
+}
+
+static bool WriteJournalHeader(FILE *file) {
+    unsigned char header[JOURNAL_HEADER_SIZE];
+    PutU32(header, JOURNAL_MAGIC);
+    PutU32(header + 4, JOURNAL_VERSION);
+    return fwrite(header, sizeof(header), 1, file) == 1 && SyncFile(file);
+}
+
+// 逐条校验并回放，返回最后一条完整记录之后的偏移；文件头无效时返回 0
+static long ReplayJournalFile(FILE *file, uint64_t afterSequence, JournalReplayFunc replay, void *userData) {
+    unsigned char header[JOURNAL_RECORD_HEADER_SIZE];
+    if (fread(header, JOURNAL_HEADER_SIZE, 1, file) != 1) return 0;
+    if (GetU32(header) != JOURNAL_MAGIC || GetU32(header + 4) != JOURNAL_VERSION) return 0;
+
+    unsigned char *payload = (unsigned char *)malloc(JOURNAL_MAX_PAYLOAD);
+    if (payload == NULL) return 0;
+
+    long validLength = JOURNAL_HEADER_SIZE;
+    for (;;) {
+        if (fread(header, sizeof(header), 1, file) != 1) break;
+        uint32_t size = GetU32(header);
+        if (size > JOURNAL_MAX_PAYLOAD) break;
+        if (size > 0 && fread(payload, size, 1, file) != 1) break;
+        if (GetU32(header + 4) != GetRecordChecksum(header, payload, size)) break;
+
+        JournalRecord record = {
+            .sequence = GetU64(header + 8),
+            .time = (int64_t)GetU64(header + 16),
+            .type = GetU32(header + 24),
+            .size = size
+        };
+        if (record.sequence > afterSequence) {
+            if (replay != NULL) replay(&record, payload, userData);
+            journalStats.replayed++;
+        }
+        if (record.sequence > journalSequence) journalSequence = record.sequence;
+        journalRecordCount++;
+        validLength += JOURNAL_RECORD_HEADER_SIZE + (long)size;
+    }
+
+    free(payload);
+    return validLength;
+}
+
+static bool TruncateJournal(void) {
+    return TruncateFile(journalFile, 0) && fseek(journalFile, 0, SEEK_SET) == 0 && WriteJournalHeader(journalFile);
+}
+
+// 调用时持有锁，写快照期间释放。快照先于提交之后的任何一批记录处理，
+// 此时文件中只有提交之前追加的记录，都已被快照覆盖，可以整体清空；
+// 仍在待写缓冲区里的旧记录随后照常写入，回放时按序号跳过
+static void RunJournalCheckpoint(void) {
+    JournalCheckpointFunc save = checkpointSave;
+    void *userData = checkpointData;
+    int covered = checkpointRecords;
+    checkpointSave = NULL;
+    checkpointData = NULL;
+    journalWriting = true;
+    UnlockJournal();
+
+    bool reset = save(userData) && TruncateJournal();
+
+    LockJournal();
+    journalWriting = false;
+    checkpointActive = false;
+    if (reset) {
+        journalRecordCount -= covered;
+        journalStats.checkpoints++;
+    }
+    BroadcastJournal(&journalWritten);
+}
+
+// 写线程主循环：交换缓冲区后在锁外写入并落盘，期间主线程继续追加到另一块缓冲区
+static void JournalWriterLoop(void) {
+    LockJournal();
+    for (;;) {
+        while (pendingSize == 0 && checkpointSave == NULL && !journalStopping) {
+            WaitJournal(&journalWork);
+        }
+        if (checkpointSave != NULL) {
+            RunJournalCheckpoint();
+            continue;
+        }
+        if (pendingSize == 0 && journalStopping) break;
+
+        unsigned char *batch = pendingBuffer;
+        size_t batchSize = pendingSize;
+        size_t batchCapacity = pendingCapacity;
+        pendingBuffer = writeBuffer;
+        pendingCapacity = writeCapacity;
+        pendingSize = 0;
+        writeBuffer = batch;
+        writeCapacity = batchCapacity;
+        journalWriting = true;
+        UnlockJournal();
+
+        bool written = fwrite(batch, 1, batchSize, journalFile) == batchSize && SyncFile(journalFile);
+
+        LockJournal();
+        journalWriting = false;
+        journalStats.batches++;
+        journalStats.bytes += (unsigned long)batchSize;
+        if (!written) journalStats.failed = true;
+        BroadcastJournal(&journalWritten);
+    }
+    UnlockJournal();
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI JournalThreadMain(LPVOID arg) {
+    (void)arg;
+    JournalWriterLoop();
+    return 0;
+}
+#else
+static void *JournalThreadMain(void *arg) {
+    (void)arg;
+    JournalWriterLoop();
+    return NULL;
+}
+#endif
+
+bool OpenStateJournal(const char *path, uint64_t afterSequence, JournalReplayFunc replay, void *userData) {
+    if (journalFile != NULL) return true;
+
+    journalSequence = afterSequence;
+    journalRecordCount = 0;
+    journalStats = (JournalStats){0};
+
+    long validLength = 0;
+    FILE *file = fopen(path, "r+b");
+    if (file != NULL) {
+        validLength = ReplayJournalFile(file, afterSequence, replay, userData);
+        fseek(file, 0, SEEK_END);
+        long fileLength = ftell(file);
+        if (validLength > 0 && fileLength > validLength) {
+            // 崩溃时写了一半的记录
+            journalStats.truncated = true;
+            if (!TruncateFile(file, validLength)) validLength = 0;
+        }
+        if (validLength == 0) {
+            fclose(file);
+            file = NULL;
+        }
+    }
+    if (file == NULL) {
+        // 新建，或文件头已损坏，无法找到记录边界
+        journalRecordCount = 0;
+        file = fopen(path, "w+b");
+        if (file == NULL) return false;
+        if (!WriteJournalHeader(file)) {
+            fclose(file);
+            return false;
+        }
+    }
+    fseek(file, 0, SEEK_END);
+
+    journalFile = file;
+    pendingSize = 0;
+    journalStopping = false;
+    journalWriting = false;
+    checkpointSave = NULL;
+    checkpointData = NULL;
+    checkpointActive = false;
+
+#if defined(_WIN32)
+    InitializeCriticalSection(&journalMutex);
+    InitializeConditionVariable(&journalWork);
+    InitializeConditionVariable(&journalWritten);
+    journalThread = CreateThread(NULL, 0, JournalThreadMain, NULL, 0, NULL);
+    journalThreadRunning = journalThread != NULL;
+#else
+    pthread_mutex_init(&journalMutex, NULL);
+    pthread_cond_init(&journalWork, NULL);
+    pthread_cond_init(&journalWritten, NULL);
+    journalThreadRunning = pthread_create(&journalThread, NULL, JournalThreadMain, NULL) == 0;
+#endif
+    return true;
+}
+
+static bool ReservePending(size_t size) {
+    if (size <= pendingCapacity) return true;
+
+    size_t capacity = (pendingCapacity > 0) ? pendingCapacity : 4096;
+    while (capacity < size) capacity *= 2;
+    unsigned char *buffer = (unsigned char *)realloc(pendingBuffer, capacity);
+    if (buffer == NULL) return false;
+    pendingBuffer = buffer;
+    pendingCapacity = capacity;
+    return true;
+}
+
+uint64_t AppendJournalRecord(uint32_t type, int64_t time, const void *payload, uint32_t size) {
+    if (journalFile == NULL || size > JOURNAL_MAX_PAYLOAD) return 0;
+
+    LockJournal();
+    size_t recordSize = JOURNAL_RECORD_HEADER_SIZE + size;
+    if (!ReservePending(pendingSize + recordSize)) {
+        journalStats.failed = true;
+        UnlockJournal();
+        return 0;
+    }
+
+    uint64_t sequence = ++journalSequence;
+    unsigned char *header = pendingBuffer + pendingSize;
+    PutU32(header, size);
+    PutU64(header + 8, sequence);
+    PutU64(header + 16, (uint64_t)time);
+    PutU32(header + 24, type);
+    PutU32(header + 28, 0);
+    if (size > 0) memcpy(header + JOURNAL_RECORD_HEADER_SIZE, payload, size);
+    PutU32(header + 4, GetRecordChecksum(header, header + JOURNAL_RECORD_HEADER_SIZE, size));
+    pendingSize += recordSize;
+    journalRecordCount++;
+    journalStats.records++;
+
+    if (journalThreadRunning) {
+        BroadcastJournal(&journalWork);
+    } else {
+        // 写线程没能启动时同步写入
+        bool written = fwrite(pendingBuffer, 1, pendingSize, journalFile) == pendingSize && SyncFile(journalFile);
+        journalStats.batches++;
+        journalStats.bytes += (unsigned long)pendingSize;
+        if (!written) journalStats.failed = true;
+        pendingSize = 0;
+    }
+    UnlockJournal();
+    return sequence;
+}
+
+// 调用时持有锁；返回时所有已追加的记录与提交的快照都已写完（或写入失败），写线程空闲
+static void WaitJournalIdle(void) {
+    while (journalThreadRunning && (pendingSize > 0 || journalWriting || checkpointActive)) {
+        WaitJournal(&journalWritten);
+    }
+}
+
+void FlushStateJournal(void) {
+    if (journalFile == NULL) return;
+
+    LockJournal();
+    WaitJournalIdle();
+    UnlockJournal();
+}
+
+bool SubmitJournalCheckpoint(JournalCheckpointFunc save, void *userData) {
+    if (journalFile == NULL) {
+        save(userData);
+        return true;
+    }
+
+    LockJournal();
+    if (checkpointActive) {
+        UnlockJournal();
+        return false;
+    }
+
+    if (journalThreadRunning) {
+        checkpointSave = save;
+        checkpointData = userData;
+        checkpointRecords = journalRecordCount;
+        checkpointActive = true;
+        BroadcastJournal(&journalWork);
+    } else if (save(userData) && TruncateJournal()) {
+        // 写线程没能启动时同步写出，记录也是同步写入的，日志中没有更新的记录
+        journalRecordCount = 0;
+        journalStats.checkpoints++;
+    }
+    UnlockJournal();
+    return true;
+}
+
+void CloseStateJournal(void) {
+    if (journalFile == NULL) return;
+
+    if (journalThreadRunning) {
+        LockJournal();
+        journalStopping = true;
+        BroadcastJournal(&journalWork);
+        UnlockJournal();
+#if defined(_WIN32)
+        WaitForSingleObject(journalThread, INFINITE);
+        CloseHandle(journalThread);
+#else
+        pthread_join(journalThread, NULL);
+#endif
+        journalThreadRunning = false;
+    }
+
+#if defined(_WIN32)
+    DeleteCriticalSection(&journalMutex);
+#else
+    pthread_cond_destroy(&journalWritten);
+    pthread_cond_destroy(&journalWork);
+    pthread_mutex_destroy(&journalMutex);
+#endif
+
+    fclose(journalFile);
+    journalFile = NULL;
+    free(pendingBuffer);
+    free(writeBuffer);
+    pendingBuffer = NULL;
+    writeBuffer = NULL;
+    pendingSize = 0;
+    pendingCapacity = 0;
+    writeCapacity = 0;
+}
+
+uint64_t GetJournalSequence(void) {
+    return journalSequence;
+}
+
+int GetJournalRecordCount(void) {
+    // 快照写完时写线程会扣减记录数
+    if (journalFile == NULL) return journalRecordCount;
+
+    LockJournal();
+    int count = journalRecordCount;
+    UnlockJournal();
+    return count;
+}
+
+bool IsJournalCheckpointPending(void) {
+    if (journalFile == NULL) return false;
+
+    LockJournal();
+    bool pending = checkpointActive;
+    UnlockJournal();
+    return pending;
+}
+
+JournalStats GetStateJournalStats(void) {
+    if (journalFile == NULL) return journalStats;
+
+    LockJournal();
+    JournalStats stats = journalStats;
+    UnlockJournal();
+    return stats;
+}
@@ -0,0 +1,285 @@
+#include "text_cache.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TEXT_CACHE_CAPACITY 1024       // 开放寻址表大小（2 的幂）
+#define TEXT_CACHE_MAX_ENTRIES 768     // 超过后整表清空，计时等动态字符串不会无限增长
+#define MAX_GLYPH_INDEX_MAPS 4
+
+// 码点到字形下标的哈希表，替代 raylib GetGlyphIndex 的线性查找
+typedef struct {
+    const GlyphInfo *glyphs;     // 字体标识
+    int glyphCount;
+    int *codepoints;             // 0 表示空槽
+    int *indices;
+    int capacity;
+    int fallbackIndex;           // 缺字时使用的 '?' 下标
+} GlyphIndexMap;
+
+typedef struct {
+    unsigned long long hash;     // 0 表示空槽
+    const GlyphInfo *glyphs;
+    int glyphCount;
+    char *text;
+    TextRun run;
+} TextCacheEntry;
+
+static GlyphIndexMap glyphIndexMaps[MAX_GLYPH_INDEX_MAPS] = {0};
+static int nextGlyphIndexMap = 0;
+static TextCacheEntry textCache[TEXT_CACHE_CAPACITY] = {0};
+static TextCacheStats textCacheStats = {0};
+
+static unsigned int HashCodepoint(int codepoint) {
+    return (unsigned int)codepoint * 2654435761u;
+}
+
+static void FreeGlyphIndexMap(GlyphIndexMap *map) {
+    free(map->codepoints);
+    free(map->indices);
+    *map = (GlyphIndexMap){0};
+}
+
+static void BuildGlyphIndexMap(GlyphIndexMap *map, const Font *font) {
+    int capacity = 16;
+    while (capacity < font->glyphCount * 2) capacity *= 2;
+
+    map->glyphs = font->glyphs;
+    map->glyphCount = font->glyphCount;
+    map->capacity = capacity;
+    map->codepoints = (int *)calloc((size_t)capacity, sizeof(int));
+    map->indices = (int *)calloc((size_t)capacity, sizeof(int));
+    map->fallbackIndex = 0;
+    if (map->codepoints == NULL || map->indices == NULL) {
+        FreeGlyphIndexMap(map);
+        return;
+    }
+
+    for (int i = 0; i < font->glyphCount; i++) {
+        int codepoint = font->glyphs[i].value;
+        if (codepoint == '?') map->fallbackIndex = i;
+        if (codepoint == 0) continue;
+
+        unsigned int slot = HashCodepoint(codepoint) & (unsigned int)(capacity - 1);
+        while (map->codepoints[slot] != 0 && map->codepoints[slot] != codepoint) {
+            slot = (slot + 1) & (unsigned int)(capacity - 1);
+        }
+        // 重复码点保留第一个，与线性查找结果一致
+        if (map->codepoints[slot] == 0) {
+            map->codepoints[slot] = codepoint;
+            map->indices[slot] = i;
+        }
+    }
+}
+
+static GlyphIndexMap *GetGlyphIndexMap(const Font *font) {
+    for (int i = 0; i < MAX_GLYPH_INDEX_MAPS; i++) {
+        GlyphIndexMap *map = &glyphIndexMaps[i];
+        if (map->glyphs == font->glyphs && map->glyphCount == font->glyphCount && map->capacity > 0) {
+            return map;
+        }
+    }
+
+    GlyphIndexMap *map = &glyphIndexMaps[nextGlyphIndexMap];
+    nextGlyphIndexMap = (nextGlyphIndexMap + 1) % MAX_GLYPH_INDEX_MAPS;
+    FreeGlyphIndexMap(map);
+    BuildGlyphIndexMap(map, font);
+    return (map->capacity > 0) ? map : NULL;
+}
+
+int GetGlyphIndexCached(const Font *font, int codepoint) {
+    GlyphIndexMap *map = GetGlyphIndexMap(font);
+    if (map == NULL) return GetGlyphIndex(*font, codepoint);
+
+    unsigned int mask = (unsigned int)(map->capacity - 1);
+    unsigned int slot = HashCodepoint(codepoint) & mask;
+    while (map->codepoints[slot] != 0) {
+        if (map->codepoints[slot] == codepoint) return map->indices[slot];
+        slot = (slot + 1) & mask;
+    }
+    return map->fallbackIndex;
+}
+
+// FNV-1a，混入字体标识
+static unsigned long long HashText(const Font *font, const char *text) {
+    unsigned long long hash = 14695981039346656037ULL;
+    hash ^= (unsigned long long)(size_t)font->glyphs;
+    hash *= 1099511628211ULL;
+    hash ^= (unsigned long long)font->glyphCount;
+    hash *= 1099511628211ULL;
+    for (const unsigned char *p = (const unsigned char *)text; *p != '\0'; p++) {
+        hash ^= *p;
+        hash *= 1099511628211ULL;
+    }
+    return (hash != 0) ? hash : 1;
+}
+
+static TextCacheEntry *LookupTextEntry(const Font *font, const char *text, unsigned long long hash) {
+    unsigned int slot = (unsigned int)hash & (TEXT_CACHE_CAPACITY - 1);
+    while (textCache[slot].hash != 0) {
+        TextCacheEntry *entry = &textCache[slot];
+        if (entry->hash == hash && entry->glyphs == font->glyphs &&
+            entry->glyphCount == font->glyphCount && strcmp(entry->text, text) == 0) {
+            return entry;
+        }
+        slot = (slot + 1) & (TEXT_CACHE_CAPACITY - 1);
+    }
+    // 返回空槽供插入
+    return &textCache[slot];
+}
+
+static float GetGlyphAdvance(const Font *font, int index) {
+    if (font->glyphs[index].advanceX != 0) return (float)font->glyphs[index].advanceX;
+    return font->recs[index].width + (float)font->glyphs[index].offsetX;
+}
+
+TextRun *FindTextRun(const Font *font, const char *text) {
+    if (text == NULL || font->glyphs == NULL) return NULL;
+
+    TextCacheEntry *entry = LookupTextEntry(font, text, HashText(font, text));
+    if (entry->hash == 0) return NULL;
+
+    textCacheStats.hits++;
+    return &entry->run;
+}
+
+TextRun *CacheTextRun(const Font *font, const char *text) {
+    if (text == NULL || font->glyphs == NULL) return NULL;
+
+    if (textCacheStats.entries >= TEXT_CACHE_MAX_ENTRIES) {
+        ClearTextCache();
+        textCacheStats.flushes++;
+    }
+
+    unsigned long long hash = HashText(font, text);
+    TextCacheEntry *entry = LookupTextEntry(font, text, hash);
+    if (entry->hash != 0) return &entry->run;
+
+    size_t length = strlen(text);
+    char *copy = (char *)malloc(length + 1);
+    if (copy == NULL) return NULL;
+    memcpy(copy, text, length + 1);
+
+    TextRun run = {0};
+    int offset = 0;
+    while (offset < (int)length) {
+        int codepointSize = 0;
+        int codepoint = GetCodepointNext(&text[offset], &codepointSize);
+        offset += codepointSize;
+
+        if (codepoint == '\n') {
+            run.multiline = true;
+            continue;
+        }
+        run.advance += GetGlyphAdvance(font, GetGlyphIndexCached(font, codepoint));
+        run.codepointCount++;
+    }
+
+    entry->hash = hash;
+    entry->glyphs = font->glyphs;
+    entry->glyphCount = font->glyphCount;
+    entry->text = copy;
+    entry->run = run;
+    textCacheStats.misses++;
+    textCacheStats.entries++;
+    return &entry->run;
+}
+
+// 首次绘制时解码字形序列，之后的绘制不再解析 UTF-8
+static bool BuildTextGlyphs(const Font *font, TextRun *run, const char *text) {
+    if (run->glyphs != NULL) return true;
+    if (run->codepointCount == 0) return false;
+
+    run->glyphs = (TextGlyph *)malloc((size_t)run->codepointCount * sizeof(TextGlyph));
+    if (run->glyphs == NULL) return false;
+
+    int offset = 0;
+    int length = (int)strlen(text);
+    for (int i = 0; i < run->codepointCount && offset < length; i++) {
+        int codepointSize = 0;
+        int codepoint = GetCodepointNext(&text[offset], &codepointSize);
+        offset += codepointSize;
+
+        run->glyphs[i].index = GetGlyphIndexCached(font, codepoint);
+        run->glyphs[i].visible = (codepoint != ' ' && codepoint != '\t');
+    }
+    textCacheStats.runs++;
+    return true;
+}
+
+Vector2 MeasureTextRun(const Font *font, const TextRun *run, const char *text, float fontSize, float spacing) {
+    // 与 MeasureTextEx 的计算方式一致
+    if (run == NULL || run->multiline || run->codepointCount == 0 || font->texture.id == 0) {
+        return MeasureTextEx(*font, text, fontSize, spacing);
+    }
+
+    float scaleFactor = fontSize / (float)font->baseSize;
+    return (Vector2){ run->advance * scaleFactor + (float)(run->codepointCount - 1) * spacing, fontSize };
+}
+
+void DrawTextRun(const Font *font, TextRun *run, const char *text, Vector2 position, float fontSize, float spacing, Color tint) {
+    if (run == NULL || run->multiline || font->texture.id == 0 || !BuildTextGlyphs(font, run, text)) {
+        DrawTextEx(*font, text, position, fontSize, spacing, tint);
+        return;
+    }
+
+    // 与 DrawTextEx / DrawTextCodepoint 的排版方式一致，但直接使用预解码的字形下标
+    float scaleFactor = fontSize / (float)font->baseSize;
+    float padding = (float)font->glyphPadding;
+    float offsetX = 0.0f;
+
+    for (int i = 0; i < run->codepointCount; i++) {
+        int index = run->glyphs[i].index;
+        const GlyphInfo *glyph = &font->glyphs[index];
+        Rectangle rec = font->recs[index];
+
+        if (run->glyphs[i].visible) {
+            Rectangle source = { rec.x - padding, rec.y - padding, rec.width + 2.0f * padding, rec.height + 2.0f * padding };
+            Rectangle dest = {
+                position.x + offsetX + (glyph->offsetX - padding) * scaleFactor,
+                position.y + (glyph->offsetY - padding) * scaleFactor,
+                source.width * scaleFactor,
+                source.height * scaleFactor
+            };
+            DrawTexturePro(font->texture, source, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, tint);
+        }
+
+        if (glyph->advanceX == 0) offsetX += rec.width * scaleFactor + spacing;
+        else offsetX += (float)glyph->advanceX * scaleFactor + spacing;
+    }
+}
+
+void InvalidateTextCache(const Font *font) {
+    for (int i = 0; i < MAX_GLYPH_INDEX_MAPS; i++) {
+        if (glyphIndexMaps[i].glyphs == font->glyphs) FreeGlyphIndexMap(&glyphIndexMaps[i]);
+    }
+
+    // 开放寻址表不便单独删除，字形变化很少发生，直接清空
+    if (textCacheStats.entries > 0) {
+        ClearTextCache();
+        textCacheStats.flushes++;
+    }
+}
+
+void ClearTextCache(void) {
+    for (int i = 0; i < TEXT_CACHE_CAPACITY; i++) {
+        if (textCache[i].hash == 0) continue;
+        free(textCache[i].text);
+        free(textCache[i].run.glyphs);
+    }
+    memset(textCache, 0, sizeof(textCache));
+    for (int i = 0; i < MAX_GLYPH_INDEX_MAPS; i++) FreeGlyphIndexMap(&glyphIndexMaps[i]);
+    textCacheStats.entries = 0;
+    textCacheStats.runs = 0;
+}
+
+TextCacheStats GetTextCacheStats(void) {
+    return textCacheStats;
+}
+
+void LogTextCacheStats(void) {
+    unsigned long total = textCacheStats.hits + textCacheStats.misses;
+    TraceLog(LOG_INFO, "文本缓存: 命中率 %.2f%% (%lu/%lu), 字符串 %d, 字形序列 %d, 清空 %lu 次",
+             total > 0 ? 100.0 * textCacheStats.hits / total : 100.0,
+             textCacheStats.hits, total, textCacheStats.entries, textCacheStats.runs,
+             textCacheStats.flushes);
+}
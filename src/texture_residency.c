@@ -0,0 +1,201 @@
+#include "texture_residency.h"
+#include "worker_pool.h"
+#include <stdatomic.h>
+#include <string.h>
+
+#define MAX_RESIDENT_TEXTURES 16
+
+typedef enum {
+    TEXTURE_EVICTED,     // 未驻留
+    TEXTURE_DECODING,    // 工作线程解码中
+    TEXTURE_DECODED,     // 已解码，等待上传
+    TEXTURE_RESIDENT,    // 已上传
+    TEXTURE_MISSING      // 文件缺失或解码失败，不再重试
+} TextureResidencyStatus;
+
+typedef struct {
+    char fileName[256];
+    float drawScale;
+    atomic_int status;
+    Image image;           // 工作线程输出
+    Texture2D texture;
+    double lastUsedTime;
+    bool pinned;           // 预取后尚未显示，不因闲置卸载
+} ResidentTexture;
+
+static ResidentTexture residentTextures[MAX_RESIDENT_TEXTURES];
+static int residentTextureCount = 0;
+static double textureIdleSeconds = DEFAULT_TEXTURE_IDLE_SECONDS;
+static TextureResidencyStats residencyStats = {0};
+
+// 工作线程：解码并缩放到绘制尺寸，显存只保留实际显示的分辨率
+static void DecodeResidentTextureJob(void *userData) {
+    ResidentTexture *entry = (ResidentTexture *)userData;
+
+    Image image = LoadImage(entry->fileName);
+    if (image.data == NULL) {
+        atomic_store(&entry->status, TEXTURE_MISSING);
+        return;
+    }
+
+    if (entry->drawScale > 0.0f && entry->drawScale < 1.0f) {
+        int width = (int)(image.width * entry->drawScale + 0.5f);
+        int height = (int)(image.height * entry->drawScale + 0.5f);
+        if (width < 1) width = 1;
+        if (height < 1) height = 1;
+        ImageResize(&image, width, height);
+    }
+
+    entry->image = image;
+    atomic_store(&entry->status, TEXTURE_DECODED);
+}
+
+static int GetTextureBytes(Texture2D texture) {
+    return GetPixelDataSize(texture.width, texture.height, texture.format);
+}
+
+void InitTextureResidency(double idleSeconds) {
+    memset(residentTextures, 0, sizeof(residentTextures));
+    residentTextureCount = 0;
+    textureIdleSeconds = (idleSeconds > 0.0) ? idleSeconds : DEFAULT_TEXTURE_IDLE_SECONDS;
+    residencyStats = (TextureResidencyStats){0};
+}
+
+int RegisterResidentTexture(const char *fileName, float drawScale) {
+    if (residentTextureCount >= MAX_RESIDENT_TEXTURES) return -1;
+
+    int slot = residentTextureCount++;
+    ResidentTexture *entry = &residentTextures[slot];
+    strncpy(entry->fileName, fileName, sizeof(entry->fileName) - 1);
+    entry->drawScale = drawScale;
+
+    if (FileExists(fileName)) {
+        atomic_store(&entry->status, TEXTURE_EVICTED);
+    } else {
+        TraceLog(LOG_WARNING, "图片文件未找到: %s", fileName);
+        atomic_store(&entry->status, TEXTURE_MISSING);
+    }
+
+    residencyStats.registered = residentTextureCount;
+    return slot;
+}
+
+void RequestResidentTexture(int slot) {
+    if (slot < 0 || slot >= residentTextureCount) return;
+
+    ResidentTexture *entry = &residentTextures[slot];
+    entry->lastUsedTime = GetTime();
+    if (atomic_load(&entry->status) != TEXTURE_EVICTED) return;
+
+    atomic_store(&entry->status, TEXTURE_DECODING);
+    SubmitWorkerJob(DecodeResidentTextureJob, entry);
+}
+
+void SetResidentTexturePinned(int slot, bool pinned) {
+    if (slot < 0 || slot >= residentTextureCount) return;
+
+    ResidentTexture *entry = &residentTextures[slot];
+    entry->pinned = pinned;
+    // 解除固定时从现在开始计算闲置时间，避免刚显示就被卸载
+    entry->lastUsedTime = GetTime();
+}
+
+bool AcquireResidentTexture(int slot, Texture2D *texture) {
+    if (slot < 0 || slot >= residentTextureCount) return false;
+
+    // 绘制时仍未加载（例如被卸载后重新显示）则立即发起加载，下一帧起显示
+    RequestResidentTexture(slot);
+
+    ResidentTexture *entry = &residentTextures[slot];
+    if (atomic_load(&entry->status) != TEXTURE_RESIDENT) return false;
+
+    *texture = entry->texture;
+    return true;
+}
+
+int UpdateTextureResidency(double budgetSeconds) {
+    double now = GetTime();
+    int uploaded = 0;
+
+    for (int i = 0; i < residentTextureCount; i++) {
+        ResidentTexture *entry = &residentTextures[i];
+        int status = atomic_load(&entry->status);
+
+        if (status == TEXTURE_DECODED) {
+            if (uploaded > 0 && GetTime() - now >= budgetSeconds) continue;
+
+            entry->texture = LoadTextureFromImage(entry->image);
+            UnloadImage(entry->image);
+            entry->image = (Image){0};
+
+            if (entry->texture.id == 0) {
+                TraceLog(LOG_WARNING, "图片加载失败: %s", entry->fileName);
+                atomic_store(&entry->status, TEXTURE_MISSING);
+                continue;
+            }
+
+            SetTextureFilter(entry->texture, TEXTURE_FILTER_BILINEAR);
+            atomic_store(&entry->status, TEXTURE_RESIDENT);
+            residencyStats.resident++;
+            residencyStats.residentBytes += GetTextureBytes(entry->texture);
+            residencyStats.loads++;
+            uploaded++;
+        } else if (status == TEXTURE_RESIDENT && !entry->pinned && now - entry->lastUsedTime > textureIdleSeconds) {
+            residencyStats.resident--;
+            residencyStats.residentBytes -= GetTextureBytes(entry->texture);
+            residencyStats.evictions++;
+
+            UnloadTexture(entry->texture);
+            entry->texture = (Texture2D){0};
+            atomic_store(&entry->status, TEXTURE_EVICTED);
+            TraceLog(LOG_DEBUG, "纹理闲置超时已卸载: %s", entry->fileName);
+        }
+    }
+
+    return uploaded;
+}
+
+bool IsTextureResidencyBusy(void) {
+    for (int i = 0; i < residentTextureCount; i++) {
+        int status = atomic_load(&residentTextures[i].status);
+        if (status == TEXTURE_DECODING || status == TEXTURE_DECODED) return true;
+    }
+    return false;
+}
+
+double GetTextureEvictionTime(void) {
+    double earliest = -1.0;
+    for (int i = 0; i < residentTextureCount; i++) {
+        if (atomic_load(&residentTextures[i].status) != TEXTURE_RESIDENT || residentTextures[i].pinned) continue;
+
+        double evictTime = residentTextures[i].lastUsedTime + textureIdleSeconds;
+        if (earliest < 0.0 || evictTime < earliest) earliest = evictTime;
+    }
+    return earliest;
+}
+
+TextureResidencyStats GetTextureResidencyStats(void) {
+    return residencyStats;
+}
+
+void ShutdownTextureResidency(void) {
+    // 等待仍在解码的任务，避免工作线程写入已清空的槽位
+    WaitWorkerJobs();
+
+    for (int i = 0; i < residentTextureCount; i++) {
+        ResidentTexture *entry = &residentTextures[i];
+        int status = atomic_load(&entry->status);
+
+        if (status == TEXTURE_RESIDENT) {
+            UnloadTexture(entry->texture);
+        } else if (status == TEXTURE_DECODED) {
+            UnloadImage(entry->image);
+        }
+    }
+
+    TraceLog(LOG_INFO, "纹理驻留: 加载 %d 次, 闲置卸载 %d 次",
+             residencyStats.loads, residencyStats.evictions);
+    memset(residentTextures, 0, sizeof(residentTextures));
+    residentTextureCount = 0;
+    residencyStats = (TextureResidencyStats){0};
+}
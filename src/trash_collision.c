@@ -0,0 +1,711 @@
+#include "trash_collision.h"
+#include "worker_pool.h"
+#include "raymath.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MIN_BROAD_PHASE_BUCKETS 16
+#define GRID_MIN_BODIES 32             // 数量很少时逐对检测比建网格更快
+#define PAIR_QUERY_BATCH 512           // 并行查询时每批的垃圾数
+#define PAIR_RESOLVE_BATCH 256         // 并行解算时每批的碰撞对数
+
+// 睡眠的垃圾仍留在网格里，作为醒着的垃圾的静止障碍
+static bool IsBodyColliding(const TrashBodies *bodies, int i) {
+    return bodies->mobility[i] != 0.0f || bodies->island[i] > 0;
+}
+
+static bool IsBodySleeping(const TrashBodies *bodies, int i) {
+    return bodies->island[i] > 0;
+}
+
+static bool IsBodyAwake(const TrashBodies *bodies, int i) {
+    return bodies->island[i] == 0 && bodies->mobility[i] != 0.0f;
+}
+
+static float GetBodySpeedSqr(const TrashBodies *bodies, int i) {
+    return bodies->velocityX[i] * bodies->velocityX[i] + bodies->velocityY[i] * bodies->velocityY[i];
+}
+
+static unsigned int HashTrashCell(int cellX, int cellY) {
+    unsigned int hash = ((unsigned int)cellX * 73856093u) ^ ((unsigned int)cellY * 19349663u);
+    return hash ^ (hash >> 16);
+}
+
+// counter 记录扩容次数，分批查询时各批的列表在工作线程里扩容，计数记在各自的列表上
+static bool GrowArray(unsigned long *counter, void **array, int capacity, size_t elementSize) {
+    void *grown = realloc(*array, (size_t)capacity * elementSize);
+    if (grown == NULL) return false;
+    *array = grown;
+    (*counter)++;
+    return true;
+}
+
+static bool ReserveBodies(TrashBroadPhase *broadPhase, int count) {
+    if (count <= broadPhase->bodyCapacity) return true;
+
+    int capacity = (broadPhase->bodyCapacity > 0) ? broadPhase->bodyCapacity : 32;
+    while (capacity < count) capacity *= 2;
+
+    if (!GrowArray(&broadPhase->allocations, (void **)&broadPhase->entries, capacity, sizeof(int)) ||
+        !GrowArray(&broadPhase->allocations, (void **)&broadPhase->bodyBucket, capacity, sizeof(int)) ||
+        !GrowArray(&broadPhase->allocations, (void **)&broadPhase->cellX, capacity, sizeof(int)) ||
+        !GrowArray(&broadPhase->allocations, (void **)&broadPhase->cellY, capacity, sizeof(int)) ||
+        !GrowArray(&broadPhase->allocations, (void **)&broadPhase->islandParent, capacity, sizeof(int)) ||
+        !GrowArray(&broadPhase->allocations, (void **)&broadPhase->islandLabel, capacity, sizeof(int))) {
+        return false;
+    }
+    broadPhase->bodyCapacity = capacity;
+    return true;
+}
+
+static bool ReserveBuckets(TrashBroadPhase *broadPhase, int bodyCount) {
+    int bucketCount = MIN_BROAD_PHASE_BUCKETS;
+    while (bucketCount < bodyCount * 2) bucketCount *= 2;
+    if (bucketCount == broadPhase->bucketCount) return true;
+
+    if (!GrowArray(&broadPhase->allocations, (void **)&broadPhase->bucketStart, bucketCount + 1, sizeof(int))) return false;
+    broadPhase->bucketCount = bucketCount;
+    return true;
+}
+
+static bool AddTrashPair(TrashPairList *list, int a, int b) {
+    if (list->count >= list->capacity) {
+        int capacity = (list->capacity > 0) ? list->capacity * 2 : 64;
+        if (!GrowArray(&list->allocations, (void **)&list->pairs, capacity, sizeof(TrashPair))) return false;
+        list->capacity = capacity;
+    }
+    list->pairs[list->count++] = (TrashPair){ a, b };
+    return true;
+}
+
+static bool IsBodyBoundsOverlapping(const TrashBodies *bodies, int a, int b) {
+    float reach = bodies->radius[a] + bodies->radius[b];
+    return fabsf(bodies->positionX[b] - bodies->positionX[a]) < reach &&
+           fabsf(bodies->positionY[b] - bodies->positionY[a]) < reach;
+}
+
+static int BuildAllTrashPairs(TrashBroadPhase *broadPhase, const TrashBodies *bodies) {
+    TrashPairList *list = &broadPhase->pairList;
+    for (int i = 0; i < bodies->count; i++) {
+        if (!IsBodyColliding(bodies, i)) continue;
+        for (int j = i + 1; j < bodies->count; j++) {
+            if (!IsBodyColliding(bodies, j) || !IsBodyBoundsOverlapping(bodies, i, j)) continue;
+            if (!AddTrashPair(list, i, j)) return list->count;
+        }
+    }
+    return list->count;
+}
+
+void InitTrashBroadPhase(TrashBroadPhase *broadPhase) {
+    memset(broadPhase, 0, sizeof(TrashBroadPhase));
+}
+
+unsigned long GetTrashBroadPhaseAllocations(const TrashBroadPhase *broadPhase) {
+    unsigned long allocations = broadPhase->allocations + broadPhase->pairList.allocations;
+    for (int c = 0; c < broadPhase->chunkCapacity; c++) {
+        allocations += broadPhase->chunkPairs[c].allocations;
+    }
+    return allocations;
+}
+
+void SetTrashSleepParams(TrashBroadPhase *broadPhase, float sleepSpeed, float sleepDelay) {
+    broadPhase->sleepSpeed = sleepSpeed;
+    broadPhase->sleepDelay = sleepDelay;
+}
+
+void FreeTrashBroadPhase(TrashBroadPhase *broadPhase) {
+    free(broadPhase->bucketStart);
+    free(broadPhase->entries);
+    free(broadPhase->bodyBucket);
+    free(broadPhase->cellX);
+    free(broadPhase->cellY);
+    free(broadPhase->islandParent);
+    free(broadPhase->islandLabel);
+    free(broadPhase->pairList.pairs);
+    for (int c = 0; c < broadPhase->chunkCapacity; c++) {
+        free(broadPhase->chunkPairs[c].pairs);
+    }
+    free(broadPhase->chunkPairs);
+    free(broadPhase->bodyColors);
+    free(broadPhase->coloredPairs);
+    free(broadPhase->pairColors);
+    memset(broadPhase, 0, sizeof(TrashBroadPhase));
+}
+
+// 建立网格并返回参与碰撞的垃圾数；少于 GRID_MIN_BODIES 时不建网格
+static int PrepareTrashGrid(TrashBroadPhase *broadPhase, const TrashBodies *bodies) {
+    int count = bodies->count;
+    broadPhase->gridBodies = 0;
+    if (count < 2 || !ReserveBodies(broadPhase, count)) return 0;
+
+    // 格子边长取最大直径，相交的两个垃圾一定落在相邻格子里
+    int activeCount = 0;
+    float maxRadius = 0.0f;
+    for (int i = 0; i < count; i++) {
+        if (!IsBodyColliding(bodies, i)) continue;
+        activeCount++;
+        if (bodies->radius[i] > maxRadius) maxRadius = bodies->radius[i];
+    }
+    if (activeCount < 2 || maxRadius <= 0.0f) return 0;
+    if (activeCount < GRID_MIN_BODIES) return activeCount;
+    if (!ReserveBuckets(broadPhase, activeCount)) return 0;
+
+    broadPhase->cellSize = maxRadius * 2.0f;
+    unsigned int mask = (unsigned int)(broadPhase->bucketCount - 1);
+    int *bucketStart = broadPhase->bucketStart;
+    memset(bucketStart, 0, (size_t)(broadPhase->bucketCount + 1) * sizeof(int));
+
+    // 计数排序：先统计每个桶的数量，再按下标升序放入，桶内顺序稳定
+    for (int i = 0; i < count; i++) {
+        if (!IsBodyColliding(bodies, i)) {
+            broadPhase->bodyBucket[i] = -1;
+            continue;
+        }
+        int cellX = (int)floorf(bodies->positionX[i] / broadPhase->cellSize);
+        int cellY = (int)floorf(bodies->positionY[i] / broadPhase->cellSize);
+        int bucket = (int)(HashTrashCell(cellX, cellY) & mask);
+        broadPhase->cellX[i] = cellX;
+        broadPhase->cellY[i] = cellY;
+        broadPhase->bodyBucket[i] = bucket;
+        bucketStart[bucket + 1]++;
+    }
+    for (int b = 0; b < broadPhase->bucketCount; b++) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    for (int i = 0; i < count; i++) {
+        int bucket = broadPhase->bodyBucket[i];
+        if (bucket < 0) continue;
+        // 借用 bucketStart[bucket] 作为写入游标，完成后整体右移一位即恢复起始位置
+        broadPhase->entries[bucketStart[bucket]++] = i;
+    }
+    for (int b = broadPhase->bucketCount; b > 0; b--) {
+        bucketStart[b] = bucketStart[b - 1];
+    }
+    bucketStart[0] = 0;
+    broadPhase->gridBodies = count;
+
+    return activeCount;
+}
+
+void BuildTrashGrid(TrashBroadPhase *broadPhase, const TrashBodies *bodies) {
+    PrepareTrashGrid(broadPhase, bodies);
+}
+
+static bool IsPointInBody(const TrashBodies *bodies, int i, Vector2 point) {
+    float dx = point.x - bodies->positionX[i];
+    float dy = point.y - bodies->positionY[i];
+    return dx * dx + dy * dy <= bodies->radius[i] * bodies->radius[i];
+}
+
+static bool IsRectTouchingBody(const TrashBodies *bodies, int i, Rectangle rect) {
+    return CheckCollisionCircleRec((Vector2){ bodies->positionX[i], bodies->positionY[i] }, bodies->radius[i], rect);
+}
+
+int QueryTrashGridPoint(const TrashBroadPhase *broadPhase, const TrashBodies *bodies, Vector2 point) {
+    int hit = -1;
+    if (broadPhase->gridBodies == 0 || broadPhase->gridBodies != bodies->count) {
+        for (int i = bodies->count - 1; i >= 0; i--) {
+            if (IsBodyColliding(bodies, i) && IsPointInBody(bodies, i, point)) return i;
+        }
+        return -1;
+    }
+
+    // 格子边长不小于任何直径，包含该点的垃圾中心一定在周围 3x3 格子里；
+    // 桶里可能混有散列到同一桶的其他格子，只认所在格子与当前格子一致的垃圾，每个垃圾只检测一次
+    unsigned int mask = (unsigned int)(broadPhase->bucketCount - 1);
+    int cellX = (int)floorf(point.x / broadPhase->cellSize);
+    int cellY = (int)floorf(point.y / broadPhase->cellSize);
+    for (int y = cellY - 1; y <= cellY + 1; y++) {
+        for (int x = cellX - 1; x <= cellX + 1; x++) {
+            int bucket = (int)(HashTrashCell(x, y) & mask);
+            for (int e = broadPhase->bucketStart[bucket]; e < broadPhase->bucketStart[bucket + 1]; e++) {
+                int j = broadPhase->entries[e];
+                if (j <= hit || broadPhase->cellX[j] != x || broadPhase->cellY[j] != y) continue;
+                if (IsPointInBody(bodies, j, point)) hit = j;
+            }
+        }
+    }
+    return hit;
+}
+
+static int CompareBodyIndex(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+// 命中数超过容量时 indices 作为大顶堆，只保留下标最小的 maxCount 个，结果与逐个检测时的截断一致
+static void KeepLowestBodyIndex(int *heap, int written, int index) {
+    if (index >= heap[0]) return;
+
+    heap[0] = index;
+    int at = 0;
+    for (;;) {
+        int largest = at;
+        int left = 2 * at + 1;
+        int right = left + 1;
+        if (left < written && heap[left] > heap[largest]) largest = left;
+        if (right < written && heap[right] > heap[largest]) largest = right;
+        if (largest == at) break;
+
+        int swap = heap[at];
+        heap[at] = heap[largest];
+        heap[largest] = swap;
+        at = largest;
+    }
+}
+
+static void PushBodyIndexHeap(int *heap, int written, int index) {
+    int at = written;
+    heap[at] = index;
+    while (at > 0 && heap[(at - 1) / 2] < heap[at]) {
+        int parent = (at - 1) / 2;
+        int swap = heap[at];
+        heap[at] = heap[parent];
+        heap[parent] = swap;
+        at = parent;
+    }
+}
+
+int QueryTrashGridRect(const TrashBroadPhase *broadPhase, const TrashBodies *bodies, Rectangle rect, int *indices, int maxCount) {
+    int found = 0;
+    bool useGrid = broadPhase->gridBodies > 0 && broadPhase->gridBodies == bodies->count;
+
+    // 矩形覆盖的格子比垃圾还多时，逐个检测更快
+    int firstX = 0, firstY = 0, lastX = -1, lastY = -1;
+    if (useGrid) {
+        float margin = broadPhase->cellSize * 0.5f;
+        firstX = (int)floorf((rect.x - margin) / broadPhase->cellSize);
+        firstY = (int)floorf((rect.y - margin) / broadPhase->cellSize);
+        lastX = (int)floorf((rect.x + rect.width + margin) / broadPhase->cellSize);
+        lastY = (int)floorf((rect.y + rect.height + margin) / broadPhase->cellSize);
+        double cells = ((double)lastX - firstX + 1) * ((double)lastY - firstY + 1);
+        if (cells > bodies->count) useGrid = false;
+    }
+
+    if (!useGrid) {
+        for (int i = 0; i < bodies->count; i++) {
+            if (!IsBodyColliding(bodies, i) || !IsRectTouchingBody(bodies, i, rect)) continue;
+            if (found < maxCount) indices[found] = i;
+            found++;
+        }
+        return found;
+    }
+
+    unsigned int mask = (unsigned int)(broadPhase->bucketCount - 1);
+    for (int y = firstY; y <= lastY; y++) {
+        for (int x = firstX; x <= lastX; x++) {
+            int bucket = (int)(HashTrashCell(x, y) & mask);
+            for (int e = broadPhase->bucketStart[bucket]; e < broadPhase->bucketStart[bucket + 1]; e++) {
+                int j = broadPhase->entries[e];
+                if (broadPhase->cellX[j] != x || broadPhase->cellY[j] != y) continue;
+                if (!IsRectTouchingBody(bodies, j, rect)) continue;
+                if (found < maxCount) {
+                    PushBodyIndexHeap(indices, found, j);
+                } else if (maxCount > 0) {
+                    KeepLowestBodyIndex(indices, maxCount, j);
+                }
+                found++;
+            }
+        }
+    }
+
+    // 按格子遍历的顺序与下标无关，排序后与逐个检测的结果一致（包括超出容量时的截断）
+    int written = (found < maxCount) ? found : maxCount;
+    qsort(indices, (size_t)written, sizeof(int), CompareBodyIndex);
+    return found;
+}
+
+// 查询 [first, last) 内垃圾的候选对，只读网格与垃圾状态，可在多个线程同时执行
+static void QueryTrashPairs(const TrashBroadPhase *broadPhase, const TrashBodies *bodies, int first, int last, TrashPairList *list) {
+    unsigned int mask = (unsigned int)(broadPhase->bucketCount - 1);
+    const int *bucketStart = broadPhase->bucketStart;
+
+    for (int i = first; i < last; i++) {
+        if (broadPhase->bodyBucket[i] < 0) continue;
+
+        // 不同格子可能散列到同一个桶，每个桶只扫描一次，避免重复配对
+        int visited[9];
+        int visitedCount = 0;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int bucket = (int)(HashTrashCell(broadPhase->cellX[i] + dx, broadPhase->cellY[i] + dy) & mask);
+
+                bool seen = false;
+                for (int v = 0; v < visitedCount; v++) {
+                    if (visited[v] == bucket) { seen = true; break; }
+                }
+                if (seen) continue;
+                visited[visitedCount++] = bucket;
+
+                for (int e = bucketStart[bucket]; e < bucketStart[bucket + 1]; e++) {
+                    int j = broadPhase->entries[e];
+                    if (j <= i) continue;
+
+                    if (!IsBodyBoundsOverlapping(bodies, i, j)) continue;
+                    if (!AddTrashPair(list, i, j)) return;
+                }
+            }
+        }
+    }
+}
+
+int BuildTrashPairs(TrashBroadPhase *broadPhase, const TrashBodies *bodies) {
+    broadPhase->pairList.count = 0;
+
+    int activeCount = PrepareTrashGrid(broadPhase, bodies);
+    if (activeCount < 2) return 0;
+    if (activeCount < GRID_MIN_BODIES) return BuildAllTrashPairs(broadPhase, bodies);
+
+    QueryTrashPairs(broadPhase, bodies, 0, bodies->count, &broadPhase->pairList);
+    return broadPhase->pairList.count;
+}
+
+typedef struct {
+    TrashBroadPhase *broadPhase;
+    const TrashBodies *bodies;
+} PairQueryJob;
+
+static void QueryTrashPairChunks(int begin, int end, void *userData) {
+    PairQueryJob *job = (PairQueryJob *)userData;
+    for (int c = begin; c < end; c++) {
+        TrashPairList *list = &job->broadPhase->chunkPairs[c];
+        int first = c * PAIR_QUERY_BATCH;
+        int last = first + PAIR_QUERY_BATCH;
+        if (last > job->bodies->count) last = job->bodies->count;
+
+        list->count = 0;
+        QueryTrashPairs(job->broadPhase, job->bodies, first, last, list);
+    }
+}
+
+// 每批垃圾写入各自的列表，再按批次顺序合并，得到与串行查询完全相同的顺序
+static int BuildTrashPairsParallel(TrashBroadPhase *broadPhase, const TrashBodies *bodies) {
+    broadPhase->pairList.count = 0;
+
+    int activeCount = PrepareTrashGrid(broadPhase, bodies);
+    if (activeCount < 2) return 0;
+    if (activeCount < GRID_MIN_BODIES) return BuildAllTrashPairs(broadPhase, bodies);
+
+    int chunkCount = (bodies->count + PAIR_QUERY_BATCH - 1) / PAIR_QUERY_BATCH;
+    if (chunkCount > broadPhase->chunkCapacity) {
+        if (!GrowArray(&broadPhase->allocations, (void **)&broadPhase->chunkPairs, chunkCount, sizeof(TrashPairList))) {
+            return BuildTrashPairs(broadPhase, bodies);
+        }
+        memset(&broadPhase->chunkPairs[broadPhase->chunkCapacity], 0,
+               (size_t)(chunkCount - broadPhase->chunkCapacity) * sizeof(TrashPairList));
+        broadPhase->chunkCapacity = chunkCount;
+    }
+
+    PairQueryJob job = { broadPhase, bodies };
+    ParallelFor(chunkCount, 1, QueryTrashPairChunks, &job);
+
+    TrashPairList *list = &broadPhase->pairList;
+    for (int c = 0; c < chunkCount; c++) {
+        const TrashPairList *chunk = &broadPhase->chunkPairs[c];
+        for (int p = 0; p < chunk->count; p++) {
+            if (!AddTrashPair(list, chunk->pairs[p].a, chunk->pairs[p].b)) return list->count;
+        }
+    }
+    return list->count;
+}
+
+// 图着色：同一颜色内的碰撞对互不共享垃圾，可以并行解算；颜色按顺序处理，
+// 着色只取决于候选对顺序，与线程数无关。用完 TRASH_PAIR_COLORS 种颜色的对放入最后一组串行解算
+static bool ColorTrashPairs(TrashBroadPhase *broadPhase, int bodyCount) {
+    int pairCount = broadPhase->pairList.count;
+    if (bodyCount > broadPhase->colorBodyCapacity) {
+        if (!GrowArray(&broadPhase->allocations, (void **)&broadPhase->bodyColors, bodyCount, sizeof(unsigned long long))) return false;
+        broadPhase->colorBodyCapacity = bodyCount;
+    }
+    if (pairCount > broadPhase->coloredCapacity) {
+        if (!GrowArray(&broadPhase->allocations, (void **)&broadPhase->coloredPairs, pairCount, sizeof(TrashPair)) ||
+            !GrowArray(&broadPhase->allocations, (void **)&broadPhase->pairColors, pairCount, sizeof(unsigned char))) return false;
+        broadPhase->coloredCapacity = pairCount;
+    }
+    memset(broadPhase->bodyColors, 0, (size_t)bodyCount * sizeof(unsigned long long));
+
+    // 先记下每个候选对的颜色，计数排序后再写入最终位置
+    int *colorStart = broadPhase->colorStart;
+    memset(colorStart, 0, sizeof(broadPhase->colorStart));
+    unsigned char *pairColors = broadPhase->pairColors;
+
+    for (int p = 0; p < pairCount; p++) {
+        TrashPair pair = broadPhase->pairList.pairs[p];
+        unsigned long long used = broadPhase->bodyColors[pair.a] | broadPhase->bodyColors[pair.b];
+
+        int color = 0;
+        while (color < TRASH_PAIR_COLORS && (used & (1ULL << color))) color++;
+        if (color < TRASH_PAIR_COLORS) {
+            broadPhase->bodyColors[pair.a] |= 1ULL << color;
+            broadPhase->bodyColors[pair.b] |= 1ULL << color;
+        }
+        pairColors[p] = (unsigned char)color;
+        colorStart[color + 1]++;
+    }
+    for (int c = 0; c <= TRASH_PAIR_COLORS; c++) {
+        colorStart[c + 1] += colorStart[c];
+    }
+
+    int cursor[TRASH_PAIR_COLORS + 1];
+    memcpy(cursor, colorStart, sizeof(cursor));
+    for (int p = 0; p < pairCount; p++) {
+        broadPhase->coloredPairs[cursor[pairColors[p]]++] = broadPhase->pairList.pairs[p];
+    }
+    return true;
+}
+
+static int ResolveTrashPairs(TrashBodies *bodies, const TrashPair *pairs, int first, int last) {
+    int contacts = 0;
+    for (int p = first; p < last; p++) {
+        int a = pairs[p].a;
+        int b = pairs[p].b;
+
+        CollisionInfo info = GetTrashCollisionInfo(bodies, a, b);
+        if (info.collided) {
+            ResolveTrashCollision(bodies, a, b, info);
+            contacts++;
+        }
+    }
+    return contacts;
+}
+
+// 醒着且速度超过睡眠阈值的垃圾撞上睡眠的垃圾时整岛唤醒；两端都在睡眠的候选对不需要解算，直接剔除。
+// 在解算之前串行执行，并行路径的着色只看剔除后的列表，结果仍与线程数无关
+static int WakeTouchedIslands(TrashBroadPhase *broadPhase, TrashBodies *bodies) {
+    TrashPairList *list = &broadPhase->pairList;
+    if (broadPhase->sleepSpeed <= 0.0f) return list->count;
+
+    float wakeSpeedSqr = broadPhase->sleepSpeed * broadPhase->sleepSpeed;
+    for (int p = 0; p < list->count; p++) {
+        int a = list->pairs[p].a;
+        int b = list->pairs[p].b;
+        bool sleepingA = IsBodySleeping(bodies, a);
+        if (sleepingA == IsBodySleeping(bodies, b)) continue;
+
+        int mover = sleepingA ? b : a;
+        int sleeper = sleepingA ? a : b;
+        if (GetBodySpeedSqr(bodies, mover) <= wakeSpeedSqr) continue;
+        if (!GetTrashCollisionInfo(bodies, a, b).collided) continue;
+        WakeTrashBodies(bodies, bodies->island[sleeper]);
+    }
+
+    int kept = 0;
+    for (int p = 0; p < list->count; p++) {
+        TrashPair pair = list->pairs[p];
+        if (IsBodySleeping(bodies, pair.a) && IsBodySleeping(bodies, pair.b)) continue;
+        list->pairs[kept++] = pair;
+    }
+    list->count = kept;
+    return kept;
+}
+
+int ResolveTrashCollisions(TrashBroadPhase *broadPhase, TrashBodies *bodies) {
+    BuildTrashPairs(broadPhase, bodies);
+    int pairCount = WakeTouchedIslands(broadPhase, bodies);
+    return ResolveTrashPairs(bodies, broadPhase->pairList.pairs, 0, pairCount);
+}
+
+typedef struct {
+    TrashBodies *bodies;
+    const TrashPair *pairs;
+    atomic_int contacts;
+} PairResolveJob;
+
+static void ResolveTrashPairRange(int begin, int end, void *userData) {
+    PairResolveJob *job = (PairResolveJob *)userData;
+    int contacts = ResolveTrashPairs(job->bodies, job->pairs, begin, end);
+    atomic_fetch_add(&job->contacts, contacts);
+}
+
+int ResolveTrashCollisionsParallel(TrashBroadPhase *broadPhase, TrashBodies *bodies) {
+    BuildTrashPairsParallel(broadPhase, bodies);
+    int pairCount = WakeTouchedIslands(broadPhase, bodies);
+    if (pairCount == 0) return 0;
+    if (!ColorTrashPairs(broadPhase, bodies->count)) {
+        return ResolveTrashPairs(bodies, broadPhase->pairList.pairs, 0, pairCount);
+    }
+
+    PairResolveJob job = { .bodies = bodies };
+    atomic_init(&job.contacts, 0);
+    for (int c = 0; c < TRASH_PAIR_COLORS; c++) {
+        int first = broadPhase->colorStart[c];
+        int count = broadPhase->colorStart[c + 1] - first;
+        if (count == 0) continue;
+
+        job.pairs = broadPhase->coloredPairs + first;
+        ParallelFor(count, PAIR_RESOLVE_BATCH, ResolveTrashPairRange, &job);
+    }
+
+    // 颜色用尽的碰撞对
+    int overflow = broadPhase->colorStart[TRASH_PAIR_COLORS];
+    int contacts = ResolveTrashPairs(bodies, broadPhase->coloredPairs, overflow, pairCount);
+    return atomic_load(&job.contacts) + contacts;
+}
+
+static int FindIslandRoot(int *parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+// 把编号为 from 的睡眠岛并入 to
+static void RelabelIsland(TrashBodies *bodies, int from, int to) {
+    for (int i = 0; i < bodies->count; i++) {
+        if (bodies->island[i] == from) bodies->island[i] = to;
+    }
+}
+
+int UpdateTrashSleep(TrashBroadPhase *broadPhase, TrashBodies *bodies, float timeStep) {
+    int count = bodies->count;
+    int awakeCount = 0;
+    for (int i = 0; i < count; i++) {
+        if (IsBodyAwake(bodies, i)) awakeCount++;
+    }
+    if (broadPhase->sleepSpeed <= 0.0f || awakeCount == 0 || !ReserveBodies(broadPhase, count)) return awakeCount;
+
+    int *parent = broadPhase->islandParent;
+    int *label = broadPhase->islandLabel;   // 按根节点记录：-1 不能入睡，0 尚未分配，>0 岛编号
+    float restSpeedSqr = broadPhase->sleepSpeed * broadPhase->sleepSpeed;
+
+    for (int i = 0; i < count; i++) {
+        parent[i] = i;
+        label[i] = 0;
+        if (!IsBodyAwake(bodies, i)) continue;
+
+        if (GetBodySpeedSqr(bodies, i) < restSpeedSqr) {
+            bodies->restTime[i] += timeStep;
+        } else {
+            bodies->restTime[i] = 0.0f;
+        }
+    }
+
+    // 本步的候选对（已剔除两端都在睡眠的）把接触的垃圾连成岛，醒着的垃圾也会连到它压着的睡眠垃圾上
+    const TrashPairList *list = &broadPhase->pairList;
+    for (int p = 0; p < list->count; p++) {
+        int rootA = FindIslandRoot(parent, list->pairs[p].a);
+        int rootB = FindIslandRoot(parent, list->pairs[p].b);
+        if (rootA == rootB) continue;
+        // 较小的下标作根，合并顺序只取决于候选对顺序
+        if (rootA < rootB) parent[rootB] = rootA;
+        else parent[rootA] = rootB;
+    }
+
+    // 只要有一个醒着的成员还没静止够久，整个岛就保持醒着
+    for (int i = 0; i < count; i++) {
+        if (IsBodyAwake(bodies, i) && bodies->restTime[i] < broadPhase->sleepDelay) {
+            label[FindIslandRoot(parent, i)] = -1;
+        }
+    }
+    // 接触到已睡眠的岛时沿用其中最小的编号
+    for (int i = 0; i < count; i++) {
+        if (!IsBodySleeping(bodies, i)) continue;
+        int root = FindIslandRoot(parent, i);
+        if (label[root] == 0 || (label[root] > 0 && bodies->island[i] < label[root])) label[root] = bodies->island[i];
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (!IsBodyAwake(bodies, i)) continue;
+        int root = FindIslandRoot(parent, i);
+        if (label[root] < 0) continue;
+        if (label[root] == 0) label[root] = ++broadPhase->lastIsland;
+
+        bodies->island[i] = label[root];
+        bodies->mobility[i] = 0.0f;
+        bodies->velocityX[i] = 0.0f;
+        bodies->velocityY[i] = 0.0f;
+        bodies->restTime[i] = 0.0f;
+        awakeCount--;
+    }
+
+    // 同一个岛接触到多个睡眠岛时合并编号，之后唤醒其中任一个都会整体唤醒
+    for (int i = 0; i < count; i++) {
+        if (!IsBodySleeping(bodies, i)) continue;
+        int root = FindIslandRoot(parent, i);
+        if (label[root] > 0 && bodies->island[i] != label[root]) {
+            RelabelIsland(bodies, bodies->island[i], label[root]);
+        }
+    }
+
+    return awakeCount;
+}
+
+// 获取碰撞详细信息
+CollisionInfo GetTrashCollisionInfo(const TrashBodies *bodies, int a, int b) {
+    CollisionInfo info = {0};
+
+    Vector2 delta = (Vector2){bodies->positionX[b] - bodies->positionX[a], bodies->positionY[b] - bodies->positionY[a]};
+    float minDistance = bodies->radius[a] + bodies->radius[b];
+
+    // 先比较距离平方，未接触时省去开方
+    float distanceSq = delta.x * delta.x + delta.y * delta.y;
+    if (distanceSq >= minDistance * minDistance) return info;
+
+    float distance = sqrtf(distanceSq);
+    info.collided = true;
+    info.depth = minDistance - distance;
+
+    if (distance > 0) {
+        info.normal = (Vector2){delta.x / distance, delta.y / distance};
+    } else {
+        // 如果位置完全相同，使用默认法线
+        info.normal = (Vector2){1, 0};
+    }
+
+    return info;
+}
+
+// 解决碰撞
+void ResolveTrashCollision(TrashBodies *bodies, int a, int b, CollisionInfo info) {
+    if (!info.collided) return;
+
+    // 计算相对速度
+    Vector2 relativeVelocity = (Vector2){
+        bodies->velocityX[b] - bodies->velocityX[a],
+        bodies->velocityY[b] - bodies->velocityY[a]
+    };
+
+    // 计算碰撞速度
+    float velocityAlongNormal = Vector2DotProduct(relativeVelocity, info.normal);
+
+    // 如果物体正在分离，不处理
+    if (velocityAlongNormal > 0) return;
+
+    // 计算冲量大小
+    float restitution = 0.8f; // 弹性系数
+    float impulseScalar = -(1.0f + restitution) * velocityAlongNormal;
+
+    // 应用冲量（质量与半径成反比，倒数已预先算好）
+    // 睡眠的垃圾 mobility 为 0，相当于质量无穷大，只推开醒着的一方
+    float invMassA = bodies->inverseMass[a] * bodies->mobility[a];
+    float invMassB = bodies->inverseMass[b] * bodies->mobility[b];
+    impulseScalar /= (invMassA + invMassB);
+
+    Vector2 impulse = (Vector2){
+        impulseScalar * info.normal.x,
+        impulseScalar * info.normal.y
+    };
+
+    // 应用冲量到速度
+    bodies->velocityX[a] -= impulse.x * invMassA;
+    bodies->velocityY[a] -= impulse.y * invMassA;
+    bodies->velocityX[b] += impulse.x * invMassB;
+    bodies->velocityY[b] += impulse.y * invMassB;
+
+    // 位置修正 - 防止物体重叠
+    float percent = 0.8f; // 穿透修正百分比
+    float slop = 0.01f;   // 允许穿透量
+    float correction = fmaxf(info.depth - slop, 0.0f) / (invMassA + invMassB) * percent;
+
+    Vector2 correctionVec = (Vector2){
+        correction * info.normal.x,
+        correction * info.normal.y
+    };
+
+    bodies->positionX[a] -= correctionVec.x * invMassA;
+    bodies->positionY[a] -= correctionVec.y * invMassA;
+    bodies->positionX[b] += correctionVec.x * invMassB;
+    bodies->positionY[b] += correctionVec.y * invMassB;
+}
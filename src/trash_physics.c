@@ -0,0 +1,229 @@
+#include "trash_physics.h"
+#include "worker_pool.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define TRASH_PHYSICS_SSE 1
+#endif
+
+#define TRASH_BODY_ALIGNMENT 4       // 容量按 SIMD 宽度取整
+#define TRASH_STEP_BATCH 1024        // 并行步进每批的垃圾数（4 的倍数，保证每批的 SIMD 划分与串行一致）
+
+static bool GrowFloats(float **array, int capacity) {
+    float *grown = (float *)realloc(*array, (size_t)capacity * sizeof(float));
+    if (grown == NULL) return false;
+    *array = grown;
+    return true;
+}
+
+bool ReserveTrashBodies(TrashBodies *bodies, int capacity) {
+    if (capacity <= bodies->capacity) return true;
+    capacity = (capacity + TRASH_BODY_ALIGNMENT - 1) / TRASH_BODY_ALIGNMENT * TRASH_BODY_ALIGNMENT;
+
+    if (!GrowFloats(&bodies->positionX, capacity) || !GrowFloats(&bodies->positionY, capacity) ||
+        !GrowFloats(&bodies->previousX, capacity) || !GrowFloats(&bodies->previousY, capacity) ||
+        !GrowFloats(&bodies->velocityX, capacity) || !GrowFloats(&bodies->velocityY, capacity) ||
+        !GrowFloats(&bodies->radius, capacity) || !GrowFloats(&bodies->inverseMass, capacity) ||
+        !GrowFloats(&bodies->bounceFactor, capacity) || !GrowFloats(&bodies->friction, capacity) ||
+        !GrowFloats(&bodies->mobility, capacity) || !GrowFloats(&bodies->restTime, capacity)) {
+        return false;
+    }
+    int *island = (int *)realloc(bodies->island, (size_t)capacity * sizeof(int));
+    if (island == NULL) return false;
+    bodies->island = island;
+    bodies->capacity = capacity;
+    return true;
+}
+
+void FreeTrashBodies(TrashBodies *bodies) {
+    free(bodies->positionX);
+    free(bodies->positionY);
+    free(bodies->previousX);
+    free(bodies->previousY);
+    free(bodies->velocityX);
+    free(bodies->velocityY);
+    free(bodies->radius);
+    free(bodies->inverseMass);
+    free(bodies->bounceFactor);
+    free(bodies->friction);
+    free(bodies->mobility);
+    free(bodies->restTime);
+    free(bodies->island);
+    memset(bodies, 0, sizeof(TrashBodies));
+}
+
+int PushTrashBody(TrashBodies *bodies, float x, float y, float vx, float vy, float radius, float bounceFactor, float friction) {
+    if (!ReserveTrashBodies(bodies, bodies->count + 1)) return -1;
+
+    int i = bodies->count++;
+    bodies->positionX[i] = x;
+    bodies->positionY[i] = y;
+    bodies->previousX[i] = x;
+    bodies->previousY[i] = y;
+    bodies->velocityX[i] = vx;
+    bodies->velocityY[i] = vy;
+    bodies->radius[i] = radius;
+    bodies->inverseMass[i] = (radius > 0.0f) ? 1.0f / radius : 0.0f;
+    bodies->bounceFactor[i] = bounceFactor;
+    bodies->friction[i] = friction;
+    bodies->mobility[i] = 1.0f;
+    bodies->restTime[i] = 0.0f;
+    bodies->island[i] = 0;
+    return i;
+}
+
+void RemoveTrashBody(TrashBodies *bodies, int index) {
+    if (index < 0 || index >= bodies->count) return;
+
+    int last = --bodies->count;
+    if (index == last) return;
+
+    bodies->positionX[index] = bodies->positionX[last];
+    bodies->positionY[index] = bodies->positionY[last];
+    bodies->previousX[index] = bodies->previousX[last];
+    bodies->previousY[index] = bodies->previousY[last];
+    bodies->velocityX[index] = bodies->velocityX[last];
+    bodies->velocityY[index] = bodies->velocityY[last];
+    bodies->radius[index] = bodies->radius[last];
+    bodies->inverseMass[index] = bodies->inverseMass[last];
+    bodies->bounceFactor[index] = bodies->bounceFactor[last];
+    bodies->friction[index] = bodies->friction[last];
+    bodies->mobility[index] = bodies->mobility[last];
+    bodies->restTime[index] = bodies->restTime[last];
+    bodies->island[index] = bodies->island[last];
+}
+
+// v = (v + a * dt * m) * damping, p += v * dt * m
+// 两个版本的运算顺序完全相同，结果逐位一致
+static void IntegrateRange(TrashBodies *bodies, TrashIntegrator integrator, int first, int last) {
+    float stepX = integrator.accelerationX * integrator.timeStep;
+    float stepY = integrator.accelerationY * integrator.timeStep;
+
+    for (int i = first; i < last; i++) {
+        float mobility = bodies->mobility[i];
+        float vx = (bodies->velocityX[i] + stepX * mobility) * integrator.damping;
+        float vy = (bodies->velocityY[i] + stepY * mobility) * integrator.damping;
+        bodies->velocityX[i] = vx;
+        bodies->velocityY[i] = vy;
+        bodies->positionX[i] += vx * integrator.timeStep * mobility;
+        bodies->positionY[i] += vy * integrator.timeStep * mobility;
+    }
+}
+
+void IntegrateTrashBodiesScalar(TrashBodies *bodies, TrashIntegrator integrator) {
+    IntegrateRange(bodies, integrator, 0, bodies->count);
+}
+
+static void IntegrateRangeSimd(TrashBodies *bodies, TrashIntegrator integrator, int first, int last) {
+#ifdef TRASH_PHYSICS_SSE
+    int vectorLast = first + ((last - first) & ~3);
+    __m128 stepX = _mm_set1_ps(integrator.accelerationX * integrator.timeStep);
+    __m128 stepY = _mm_set1_ps(integrator.accelerationY * integrator.timeStep);
+    __m128 damping = _mm_set1_ps(integrator.damping);
+    __m128 timeStep = _mm_set1_ps(integrator.timeStep);
+
+    for (int i = first; i < vectorLast; i += 4) {
+        __m128 mobility = _mm_loadu_ps(&bodies->mobility[i]);
+        __m128 vx = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&bodies->velocityX[i]), _mm_mul_ps(stepX, mobility)), damping);
+        __m128 vy = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&bodies->velocityY[i]), _mm_mul_ps(stepY, mobility)), damping);
+        _mm_storeu_ps(&bodies->velocityX[i], vx);
+        _mm_storeu_ps(&bodies->velocityY[i], vy);
+
+        __m128 px = _mm_add_ps(_mm_loadu_ps(&bodies->positionX[i]), _mm_mul_ps(_mm_mul_ps(vx, timeStep), mobility));
+        __m128 py = _mm_add_ps(_mm_loadu_ps(&bodies->positionY[i]), _mm_mul_ps(_mm_mul_ps(vy, timeStep), mobility));
+        _mm_storeu_ps(&bodies->positionX[i], px);
+        _mm_storeu_ps(&bodies->positionY[i], py);
+    }
+    IntegrateRange(bodies, integrator, vectorLast, last);
+#else
+    IntegrateRange(bodies, integrator, first, last);
+#endif
+}
+
+void IntegrateTrashBodies(TrashBodies *bodies, TrashIntegrator integrator) {
+    IntegrateRangeSimd(bodies, integrator, 0, bodies->count);
+}
+
+bool IsTrashSimdEnabled(void) {
+#ifdef TRASH_PHYSICS_SSE
+    return true;
+#else
+    return false;
+#endif
+}
+
+static void ConstrainRange(TrashBodies *bodies, float width, float height, float timeStep, int first, int last) {
+    for (int i = first; i < last; i++) {
+        if (bodies->mobility[i] == 0.0f) continue;
+
+        float radius = bodies->radius[i];
+        // 反弹时增加10%反弹力
+        float bounce = bodies->bounceFactor[i] * 1.1f;
+
+        // 左右边界
+        if (bodies->positionX[i] < radius) {
+            bodies->positionX[i] = radius;
+            bodies->velocityX[i] = fabsf(bodies->velocityX[i]) * bounce;
+        } else if (bodies->positionX[i] > width - radius) {
+            bodies->positionX[i] = width - radius;
+            bodies->velocityX[i] = -fabsf(bodies->velocityX[i]) * bounce;
+        }
+
+        // 上下边界
+        if (bodies->positionY[i] < radius) {
+            bodies->positionY[i] = radius;
+            bodies->velocityY[i] = fabsf(bodies->velocityY[i]) * bounce;
+        } else if (bodies->positionY[i] > height - radius) {
+            bodies->positionY[i] = height - radius;
+            bodies->velocityY[i] = -fabsf(bodies->velocityY[i]) * bounce;
+
+            // 地面摩擦
+            bodies->velocityX[i] *= (1.0f - bodies->friction[i] * timeStep);
+        }
+    }
+}
+
+void ConstrainTrashBodies(TrashBodies *bodies, float width, float height, float timeStep) {
+    ConstrainRange(bodies, width, height, timeStep, 0, bodies->count);
+}
+
+void StoreTrashBodyPositions(TrashBodies *bodies) {
+    if (bodies->count == 0) return;
+    memcpy(bodies->previousX, bodies->positionX, (size_t)bodies->count * sizeof(float));
+    memcpy(bodies->previousY, bodies->positionY, (size_t)bodies->count * sizeof(float));
+}
+
+int WakeTrashBodies(TrashBodies *bodies, int island) {
+    int woken = 0;
+    for (int i = 0; i < bodies->count; i++) {
+        if (bodies->island[i] == 0) continue;
+        if (island > 0 && bodies->island[i] != island) continue;
+
+        bodies->island[i] = 0;
+        bodies->mobility[i] = 1.0f;
+        bodies->restTime[i] = 0.0f;
+        woken++;
+    }
+    return woken;
+}
+
+typedef struct {
+    TrashBodies *bodies;
+    TrashIntegrator integrator;
+    float width;
+    float height;
+} TrashStepJob;
+
+static void StepTrashBodyRange(int begin, int end, void *userData) {
+    TrashStepJob *job = (TrashStepJob *)userData;
+    IntegrateRangeSimd(job->bodies, job->integrator, begin, end);
+    ConstrainRange(job->bodies, job->width, job->height, job->integrator.timeStep, begin, end);
+}
+
+void StepTrashBodiesParallel(TrashBodies *bodies, TrashIntegrator integrator, float width, float height) {
+    TrashStepJob job = { bodies, integrator, width, height };
+    ParallelFor(bodies->count, TRASH_STEP_BATCH, StepTrashBodyRange, &job);
+}
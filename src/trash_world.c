@@ -0,0 +1,669 @@
+#include "trash_world.h"
+#include "raymath.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 物理常量 - 增加重力效果
+static const float GRAVITY = 9.8f * 8.0f;   // 重力效果
+static const float FLOOR_FRICTION = 0.8f;   // 摩擦力
+static const float BOUNCE_FACTOR = 0.85f;    // 弹跳系数
+static const float WINDOW_INFLUENCE = 1.2f; // 窗口移动影响
+static const float TRASH_REST_SPEED = 15.0f; // 低于该速度（像素/秒）视为静止，画面不再需要持续刷新
+static const float TRASH_CLEAN_TIME = 5.0f;  // 清理进度条走完的时间（秒），之后回收
+static const float TRASH_SLEEP_DELAY = 1.0f; // 整堆垃圾低于静止速度这么久后入睡，不再模拟
+static const float WINDOW_WAKE_ACCELERATION = 0.5f; // 窗口加速度超过该值时唤醒所有垃圾
+static const float TRASH_DAMPING = 0.99f;    // 60Hz 下每步的速度衰减
+static const float TRASH_LABEL_ATLAS_SIZE = 30.0f; // 数字图集按最大标签字号渲染，小字号缩小绘制
+
+// 多线程物理：只按垃圾数量决定走哪条路径，与线程数无关，同一输入在任意核数下结果相同
+#define PARALLEL_PHYSICS_MIN_BODIES 2000
+#define MAX_TRASH_TYPES 4
+
+static DigitAtlas trashAtlas = {0};     // 首次绘制时生成，之前创建的标签在那时补算宽度
+
+TrashWorld *CreateTrashWorld(void) {
+    TrashWorld *world = (TrashWorld *)calloc(1, sizeof(TrashWorld));
+    if (world == NULL) return NULL;
+
+    world->freeSlot = -1;
+    world->timeStep = 1.0f / 60.0f; // 60Hz物理更新
+    world->interpolation = true;
+    world->renderAlpha = 1.0f;
+    world->parallel = true;
+    world->gridStale = true;
+    InitTrashBroadPhase(&world->broadPhase);
+    SetTrashSleepParams(&world->broadPhase, TRASH_REST_SPEED, TRASH_SLEEP_DELAY);
+    return world;
+}
+
+void DestroyTrashWorld(TrashWorld *world) {
+    if (world == NULL) return;
+
+    free(world->items);
+    free(world->itemSlots);
+    free(world->labels);
+    free(world->ids);
+    free(world->slots);
+    free(world->queryIndices);
+    FreeTrashBodies(&world->bodies);
+    FreeTrashBroadPhase(&world->broadPhase);
+    free(world);
+}
+
+// 按块扩容，已有句柄不受影响
+static bool ReserveWorldTrash(TrashWorld *world, int count) {
+    if (count <= world->capacity) return true;
+
+    int capacity = (count + TRASH_CHUNK_SIZE - 1) / TRASH_CHUNK_SIZE * TRASH_CHUNK_SIZE;
+    Trash *items = (Trash *)realloc(world->items, (size_t)capacity * sizeof(Trash));
+    if (items == NULL) return false;
+    world->items = items;
+    int *itemSlots = (int *)realloc(world->itemSlots, (size_t)capacity * sizeof(int));
+    if (itemSlots == NULL) return false;
+    world->itemSlots = itemSlots;
+    DigitLabel *labels = (DigitLabel *)realloc(world->labels, (size_t)capacity * sizeof(DigitLabel));
+    if (labels == NULL) return false;
+    world->labels = labels;
+    unsigned int *ids = (unsigned int *)realloc(world->ids, (size_t)capacity * sizeof(unsigned int));
+    if (ids == NULL) return false;
+    world->ids = ids;
+    TrashSlot *slots = (TrashSlot *)realloc(world->slots, (size_t)capacity * sizeof(TrashSlot));
+    if (slots == NULL) return false;
+    world->slots = slots;
+    if (!ReserveTrashBodies(&world->bodies, capacity)) return false;
+    world->stats.allocations++;
+
+    // 新槽位倒序压入空闲链表，分配时按下标从小到大取用
+    for (int i = capacity - 1; i >= world->capacity; i--) {
+        world->slots[i] = (TrashSlot){ .dense = -1, .generation = 0, .nextFree = world->freeSlot };
+        world->freeSlot = i;
+    }
+    world->capacity = capacity;
+    return true;
+}
+
+static TrashHandle AddWorldTrashWithId(TrashWorld *world, const Trash *trash, unsigned int id) {
+    if (world->freeSlot < 0 && !ReserveWorldTrash(world, world->capacity + 1)) {
+        TraceLog(LOG_WARNING, "垃圾池扩容失败，当前 %d 个", world->count);
+        return TRASH_HANDLE_NONE;
+    }
+
+    int slot = world->freeSlot;
+    int dense = world->count;
+    world->freeSlot = world->slots[slot].nextFree;
+    world->slots[slot].dense = dense;
+    world->slots[slot].nextFree = -1;
+
+    world->items[dense] = *trash;
+    world->items[dense].active = true;
+    world->itemSlots[dense] = slot;
+    world->labels[dense] = MakeDigitLabel(&trashAtlas, trash->pomodoroDuration);
+    world->ids[dense] = id;
+    if (id >= world->nextId) world->nextId = id + 1;
+    PushTrashBody(&world->bodies, trash->position.x, trash->position.y, trash->velocity.x, trash->velocity.y,
+                  trash->radius, trash->bounceFactor, trash->friction);
+    if (trash->cleaning) {
+        world->bodies.mobility[dense] = 0.0f;
+        world->cleaningCount++;
+    }
+    world->count++;
+    world->settled = false;
+    world->gridStale = true;
+
+    return (TrashHandle){ slot, world->slots[slot].generation };
+}
+
+TrashHandle AddWorldTrash(TrashWorld *world, const Trash *trash) {
+    return AddWorldTrashWithId(world, trash, (world->nextId > 0) ? world->nextId : 1);
+}
+
+TrashHandle RestoreWorldTrash(TrashWorld *world, const Trash *trash, unsigned int id) {
+    if (id == 0) return AddWorldTrash(world, trash);
+    return AddWorldTrashWithId(world, trash, id);
+}
+
+// 回收 items[dense]：末尾元素移入空位，槽位放回空闲链表
+static void ReleaseWorldTrash(TrashWorld *world, int dense) {
+    int slot = world->itemSlots[dense];
+    int last = world->count - 1;
+    if (world->items[dense].cleaning) world->cleaningCount--;
+
+    if (dense != last) {
+        world->items[dense] = world->items[last];
+        world->itemSlots[dense] = world->itemSlots[last];
+        world->labels[dense] = world->labels[last];
+        world->ids[dense] = world->ids[last];
+        world->slots[world->itemSlots[dense]].dense = dense;
+    }
+    RemoveTrashBody(&world->bodies, dense);
+    world->count--;
+
+    world->slots[slot].dense = -1;
+    world->slots[slot].generation++;
+    world->slots[slot].nextFree = world->freeSlot;
+    world->freeSlot = slot;
+    world->gridStale = true;
+}
+
+void ClearTrashWorld(TrashWorld *world) {
+    // 释放所有存活的垃圾，旧句柄随代数递增而失效
+    while (world->count > 0) {
+        ReleaseWorldTrash(world, world->count - 1);
+    }
+}
+
+// 把物理状态写回记录，供外部读取或保存
+static void SyncWorldTrashRecord(TrashWorld *world, int dense) {
+    world->items[dense].position = (Vector2){ world->bodies.positionX[dense], world->bodies.positionY[dense] };
+    world->items[dense].velocity = (Vector2){ world->bodies.velocityX[dense], world->bodies.velocityY[dense] };
+}
+
+static int GetWorldTrashDenseIndex(const TrashWorld *world, TrashHandle handle) {
+    if (handle.slot < 0 || handle.slot >= world->capacity) return -1;
+    if (world->slots[handle.slot].generation != handle.generation) return -1;
+    return world->slots[handle.slot].dense;
+}
+
+void SetTrashWorldBounds(TrashWorld *world, int width, int height) {
+    if (width == world->width && height == world->height) return;
+
+    // 窗口尺寸变化后边界移动，堆积的垃圾需要重新落地
+    world->width = width;
+    world->height = height;
+    WakeTrashBodies(&world->bodies, 0);
+    world->settled = false;
+}
+
+void StepTrashWorld(TrashWorld *world, TrashStepInput input) {
+    TrashBodies *bodies = &world->bodies;
+    float timeStep = world->timeStep;
+
+    // 累计时间
+    world->elapsedTime += input.deltaTime;
+    // 拖动窗口、调试暂停或空闲等待后的第一帧时间可能很长：最多追赶 TRASH_MAX_SUBSTEPS 步，
+    // 其余时间丢弃，避免单帧执行成百上千个物理步、越追越慢
+    float maxElapsed = timeStep * TRASH_MAX_SUBSTEPS;
+    if (world->elapsedTime > maxElapsed) {
+        world->stats.clampedFrames++;
+        world->stats.droppedTime += world->elapsedTime - maxElapsed;
+        world->elapsedTime = maxElapsed;
+    }
+
+    // 清理进度按实际时间推进，走完后回收（倒序遍历，交换删除只会移入已访问过的元素）
+    for (int i = world->count - 1; i >= 0 && world->cleaningCount > 0; i--) {
+        if (!world->items[i].cleaning) continue;
+        world->items[i].cleanProgress += input.deltaTime;
+        if (world->items[i].cleanProgress >= TRASH_CLEAN_TIME) ReleaseWorldTrash(world, i);
+    }
+
+    SetTrashWorldBounds(world, input.width, input.height);
+
+    // 窗口晃动时整堆垃圾都会受力
+    Vector2 acceleration = input.windowAcceleration;
+    world->windowAcceleration = acceleration;
+    if (fabsf(acceleration.x) > WINDOW_WAKE_ACCELERATION || fabsf(acceleration.y) > WINDOW_WAKE_ACCELERATION) {
+        WakeTrashBodies(bodies, 0);
+        world->settled = false;
+    }
+
+    // 全部静止时不做任何模拟，也不积攒时间
+    if (world->settled) {
+        world->elapsedTime = 0.0f;
+        world->renderAlpha = 1.0f;
+        world->stats.substepFrames[0]++;
+        return;
+    }
+
+    // 应用重力、窗口加速度与速度衰减并更新位置（SIMD 核心，清理中的垃圾 mobility 为 0 不受影响）
+    TrashIntegrator integrator = {
+        .accelerationX = acceleration.x * WINDOW_INFLUENCE,
+        .accelerationY = GRAVITY + acceleration.y * WINDOW_INFLUENCE,
+        .damping = powf(TRASH_DAMPING, timeStep * 60.0f),
+        .timeStep = timeStep
+    };
+    float width = (float)world->width;
+    float height = (float)world->height;
+
+    // 确保固定时间步长更新
+    int substeps = 0;
+    while (world->elapsedTime >= timeStep && substeps < TRASH_MAX_SUBSTEPS) {
+        StoreTrashBodyPositions(bodies);
+        substeps++;
+        world->stats.steps++;
+        world->stats.bodySteps += (unsigned long)bodies->count;
+
+        int contacts;
+        if (world->parallel && bodies->count >= PARALLEL_PHYSICS_MIN_BODIES) {
+            // 积分与边界按批并行；碰撞对按颜色分组，同组内没有共享的垃圾
+            StepTrashBodiesParallel(bodies, integrator, width, height);
+            contacts = ResolveTrashCollisionsParallel(&world->broadPhase, bodies);
+        } else {
+            IntegrateTrashBodies(bodies, integrator);
+
+            // 边界碰撞检测 - 反弹与地面摩擦
+            ConstrainTrashBodies(bodies, width, height, timeStep);
+
+            // 垃圾之间的碰撞检测和解决：网格宽阶段只配对相邻格子里的垃圾
+            contacts = ResolveTrashCollisions(&world->broadPhase, bodies);
+        }
+        world->stats.pairsTested += (unsigned long)world->broadPhase.pairList.count;
+        world->stats.contacts += (unsigned long)contacts;
+
+        // 静止够久的接触岛入睡；没有醒着的垃圾时后续帧直接跳过
+        world->elapsedTime -= timeStep;
+        if (UpdateTrashSleep(&world->broadPhase, bodies, timeStep) == 0) {
+            world->settled = true;
+            world->elapsedTime = 0.0f;
+            // 插值起点与当前位置一致，唤醒后第一帧不会回退到入睡前一步
+            StoreTrashBodyPositions(bodies);
+            break;
+        }
+    }
+
+    world->renderAlpha = world->interpolation ? world->elapsedTime / timeStep : 1.0f;
+    world->stats.substepFrames[substeps]++;
+    if (substeps > 0) world->gridStale = true;
+}
+
+bool IsTrashWorldAnimating(const TrashWorld *world) {
+    Vector2 acceleration = world->windowAcceleration;
+    if (fabsf(acceleration.x) > WINDOW_WAKE_ACCELERATION || fabsf(acceleration.y) > WINDOW_WAKE_ACCELERATION) return true;
+    // 全部入睡后只剩清理进度条可能在动
+    if (world->settled) return world->cleaningCount > 0;
+
+    const TrashBodies *bodies = &world->bodies;
+    for (int i = 0; i < world->count; i++) {
+        // 清理进度条仍在前进
+        if (world->items[i].cleaning) return true;
+        float vx = bodies->velocityX[i];
+        float vy = bodies->velocityY[i];
+        if (vx * vx + vy * vy > TRASH_REST_SPEED * TRASH_REST_SPEED) return true;
+    }
+    return false;
+}
+
+TrashHandle GenerateWorldTrash(TrashWorld *world, int duration) {
+    // 根据时长决定垃圾类型
+    int trashType = duration / 15;  // 简单分类
+    if (trashType > 3) trashType = 3;
+
+    // 创建更快的初始速度 (从150-300提高到200-500)
+    float initialSpeed = GetRandomValue(200, 500) / 100.0f;
+    float angle = DEG2RAD * GetRandomValue(0, 360); // 随机角度
+
+    Trash trash = (Trash){
+        .position = {
+            (float)GetRandomValue(50, world->width - 50),
+            (float)GetRandomValue(world->height * 0.3f, world->height * 0.7f)
+        },
+        .velocity = {
+            cosf(angle) * initialSpeed, // X方向速度
+            sinf(angle) * initialSpeed  // Y方向速度
+        },
+        .acceleration = {0.0f, GRAVITY},
+        .scale = GetRandomValue(5, 10) / 10.0f,
+        .active = true,
+        .cleaning = false,
+        .cleanProgress = 0.0f,
+        .trashType = trashType,
+        .pomodoroDuration = duration,
+        .radius = 30.0f * GetRandomValue(5, 10) / 10.0f,
+        .bounceFactor = BOUNCE_FACTOR * (0.8f + (float)GetRandomValue(0, 40) / 100.0f),
+        .friction = FLOOR_FRICTION * (0.9f + (float)GetRandomValue(0, 20) / 100.0f)
+    };
+
+    return AddWorldTrash(world, &trash);
+}
+
+void CleanWorldTrash(TrashWorld *world, TrashHandle handle) {
+    int index = GetWorldTrashDenseIndex(world, handle);
+    if (index < 0 || world->items[index].cleaning) return;
+
+    TrashBodies *bodies = &world->bodies;
+    // 压在它上面的垃圾失去支撑，整岛唤醒
+    if (bodies->island[index] > 0) {
+        WakeTrashBodies(bodies, bodies->island[index]);
+        world->settled = false;
+    }
+    world->items[index].cleaning = true;
+    world->items[index].cleanProgress = 0.0f;  // 重置进度
+    world->cleaningCount++;
+    world->gridStale = true;
+    // 清理中的垃圾停在原地，不再参与积分与碰撞
+    bodies->mobility[index] = 0.0f;
+    bodies->velocityX[index] = 0.0f;
+    bodies->velocityY[index] = 0.0f;
+    if (world->items[index].trashType >= 0 && world->items[index].trashType < 32) {
+        world->cleanedTypes |= 1u << world->items[index].trashType;
+    }
+}
+
+bool IsWorldTrashHandleValid(const TrashWorld *world, TrashHandle handle) {
+    return GetWorldTrashDenseIndex(world, handle) >= 0;
+}
+
+const Trash *GetWorldTrash(TrashWorld *world, TrashHandle handle) {
+    int index = GetWorldTrashDenseIndex(world, handle);
+    if (index < 0) return NULL;
+
+    SyncWorldTrashRecord(world, index);
+    return &world->items[index];
+}
+
+// 绘制用的方块：位置在最近两个物理步之间按 renderAlpha 插值
+static Rectangle GetWorldTrashRect(const TrashWorld *world, int dense) {
+    const TrashBodies *bodies = &world->bodies;
+    float alpha = world->renderAlpha;
+    float size = 60.0f * world->items[dense].scale;
+    float x = bodies->previousX[dense] + (bodies->positionX[dense] - bodies->previousX[dense]) * alpha;
+    float y = bodies->previousY[dense] + (bodies->positionY[dense] - bodies->previousY[dense]) * alpha;
+    return (Rectangle){ x - size/2, y - size/2, size, size };
+}
+
+bool GetWorldTrashDrawRect(const TrashWorld *world, TrashHandle handle, Rectangle *rect) {
+    int index = GetWorldTrashDenseIndex(world, handle);
+    if (index < 0) return false;
+
+    *rect = GetWorldTrashRect(world, index);
+    return true;
+}
+
+// 查询前保证网格与当前位置一致
+static void RefreshWorldGrid(TrashWorld *world) {
+    if (!world->gridStale) return;
+    BuildTrashGrid(&world->broadPhase, &world->bodies);
+    world->gridStale = false;
+}
+
+static TrashHandle GetWorldTrashHandle(const TrashWorld *world, int dense) {
+    int slot = world->itemSlots[dense];
+    return (TrashHandle){ slot, world->slots[slot].generation };
+}
+
+unsigned int GetWorldTrashId(const TrashWorld *world, TrashHandle handle) {
+    int index = GetWorldTrashDenseIndex(world, handle);
+    return (index >= 0) ? world->ids[index] : 0;
+}
+
+TrashHandle FindWorldTrashById(const TrashWorld *world, unsigned int id) {
+    for (int i = 0; i < world->count; i++) {
+        if (world->ids[i] == id) return GetWorldTrashHandle(world, i);
+    }
+    return TRASH_HANDLE_NONE;
+}
+
+void RemoveWorldTrash(TrashWorld *world, TrashHandle handle) {
+    int index = GetWorldTrashDenseIndex(world, handle);
+    if (index < 0) return;
+
+    TrashBodies *bodies = &world->bodies;
+    if (bodies->island[index] > 0) {
+        WakeTrashBodies(bodies, bodies->island[index]);
+        world->settled = false;
+    }
+    if (world->items[index].trashType >= 0 && world->items[index].trashType < 32) {
+        world->cleanedTypes |= 1u << world->items[index].trashType;
+    }
+    ReleaseWorldTrash(world, index);
+}
+
+TrashHandle FindWorldTrashAt(TrashWorld *world, Vector2 point) {
+    RefreshWorldGrid(world);
+    int index = QueryTrashGridPoint(&world->broadPhase, &world->bodies, point);
+    return (index >= 0) ? GetWorldTrashHandle(world, index) : TRASH_HANDLE_NONE;
+}
+
+int FindWorldTrashInRect(TrashWorld *world, Rectangle rect, TrashHandle *handles, int maxCount) {
+    if (maxCount < 0) maxCount = 0;
+    if (maxCount > world->queryCapacity) {
+        int *indices = (int *)realloc(world->queryIndices, (size_t)maxCount * sizeof(int));
+        if (indices == NULL) return 0;
+        world->queryIndices = indices;
+        world->queryCapacity = maxCount;
+        world->stats.allocations++;
+    }
+
+    RefreshWorldGrid(world);
+    int found = QueryTrashGridRect(&world->broadPhase, &world->bodies, rect, world->queryIndices, maxCount);
+    int written = (found < maxCount) ? found : maxCount;
+    for (int i = 0; i < written; i++) {
+        handles[i] = GetWorldTrashHandle(world, world->queryIndices[i]);
+    }
+    return found;
+}
+
+// 检查是否清理了所有类型的垃圾
+bool IsAllWorldTrashTypeCleaned(const TrashWorld *world) {
+    // 还有未清理的垃圾
+    if (world->cleaningCount < world->count) return false;
+
+    // 检查是否所有类型都被清理过（包括已回收的垃圾）
+    unsigned int allTypes = (1u << MAX_TRASH_TYPES) - 1;
+    return (world->cleanedTypes & allTypes) == allTypes;
+}
+
+void SetTrashWorldPhysicsRate(TrashWorld *world, int hz) {
+    if (hz < 15) hz = 15;
+    if (hz > 240) hz = 240;
+    world->timeStep = 1.0f / (float)hz;
+}
+
+void SetTrashWorldInterpolation(TrashWorld *world, bool enabled) {
+    world->interpolation = enabled;
+}
+
+void SetTrashWorldParallel(TrashWorld *world, bool enabled) {
+    world->parallel = enabled;
+}
+
+TrashStepStats GetTrashWorldStats(const TrashWorld *world) {
+    TrashStepStats stats = world->stats;
+    stats.allocations += GetTrashBroadPhaseAllocations(&world->broadPhase) - world->broadPhaseAllocationBase;
+    return stats;
+}
+
+void ResetTrashWorldStats(TrashWorld *world) {
+    world->stats = (TrashStepStats){0};
+    world->broadPhaseAllocationBase = GetTrashBroadPhaseAllocations(&world->broadPhase);
+}
+
+// 只有时长对应的三种颜色，按时长直接选
+static Color GetTrashColor(int pomodoroDuration) {
+    if (pomodoroDuration == 25) return BROWN;
+    if (pomodoroDuration == 45) return DARKBROWN;
+    return (Color){100, 100, 100, 255};
+}
+
+// 方块、时长标签与进度条都从数字图集采样，整屏垃圾在一个批次中绘制，
+// 每个垃圾仍按 方块 -> 标签 -> 进度条 的顺序输出，遮挡关系与逐个绘制时相同
+void DrawTrashWorld(TrashWorld *world, Vector2 offset) {
+    if (world->count == 0) return;
+
+    // 图集在第一次绘制时生成，之前创建的标签在这里补算宽度
+    if (!trashAtlas.ready && !LoadDigitAtlas(&trashAtlas, GetFontDefault(), TRASH_LABEL_ATLAS_SIZE, 1.0f)) return;
+    if (world->labels[0].width < 0.0f) {
+        for (int i = 0; i < world->count; i++) {
+            world->labels[i] = MakeDigitLabel(&trashAtlas, world->items[i].pomodoroDuration);
+        }
+    }
+
+    BeginDigitBatch(&trashAtlas);
+    for (int i = 0; i < world->count; i++) {
+        const Trash *trash = &world->items[i];
+        float baseSize = 60.0f * trash->scale;
+        Rectangle rect = GetWorldTrashRect(world, i);
+        rect.x += offset.x;
+        rect.y += offset.y;
+
+        // 根据关联时长显示不同颜色
+        PushDigitRect(&trashAtlas, rect, GetTrashColor(trash->pomodoroDuration));
+
+        // 显示关联时长
+        float fontSize = baseSize * 0.4f;
+        if (fontSize < 15) fontSize = 15;
+        if (fontSize > 30) fontSize = 30;
+        PushDigitLabel(&trashAtlas, &world->labels[i],
+                       (Vector2){ rect.x + rect.width/2.0f, rect.y + rect.height/2.0f }, fontSize, WHITE);
+
+        // 清理进度条
+        if (trash->cleaning) {
+            float progress = trash->cleanProgress / TRASH_CLEAN_TIME;
+            PushDigitRect(&trashAtlas, (Rectangle){ rect.x, rect.y - 20.0f, rect.width, 10.0f }, LIGHTGRAY);
+            PushDigitRect(&trashAtlas, (Rectangle){ rect.x, rect.y - 20.0f, rect.width * progress, 10.0f }, GREEN);
+        }
+    }
+    EndDigitBatch();
+}
+
+void UnloadTrashWorldResources(void) {
+    UnloadDigitAtlas(&trashAtlas);
+}
+
+void WriteTrashRecord(StateWriter *writer, unsigned int id, const Trash *trash) {
+    WriteStateU32(writer, id);
+    WriteStateF32(writer, trash->position.x);
+    WriteStateF32(writer, trash->position.y);
+    WriteStateF32(writer, trash->velocity.x);
+    WriteStateF32(writer, trash->velocity.y);
+    WriteStateF32(writer, trash->acceleration.x);
+    WriteStateF32(writer, trash->acceleration.y);
+    WriteStateF32(writer, trash->scale);
+    WriteStateF32(writer, trash->radius);
+    WriteStateI32(writer, trash->trashType);
+    WriteStateI32(writer, trash->pomodoroDuration);
+    WriteStateF32(writer, trash->bounceFactor);
+    WriteStateF32(writer, trash->friction);
+}
+
+bool ReadTrashRecord(StateReader *reader, unsigned int *id, Trash *trash) {
+    if (GetStateReaderRemaining(reader) < TRASH_RECORD_SIZE) return false;
+
+    *id = ReadStateU32(reader);
+    memset(trash, 0, sizeof(Trash));
+    trash->position.x = ReadStateF32(reader);
+    trash->position.y = ReadStateF32(reader);
+    trash->velocity.x = ReadStateF32(reader);
+    trash->velocity.y = ReadStateF32(reader);
+    trash->acceleration.x = ReadStateF32(reader);
+    trash->acceleration.y = ReadStateF32(reader);
+    trash->scale = ReadStateF32(reader);
+    trash->radius = ReadStateF32(reader);
+    trash->trashType = ReadStateI32(reader);
+    trash->pomodoroDuration = ReadStateI32(reader);
+    trash->bounceFactor = ReadStateF32(reader);
+    trash->friction = ReadStateF32(reader);
+    trash->active = true;
+    return true;
+}
+
+void WriteTrashWorldSection(TrashWorld *world, StateWriter *writer) {
+    BeginStateSection(writer, TRASH_SECTION_TAG, TRASH_SECTION_VERSION);
+    WriteStateU32(writer, world->cleanedTypes);
+    WriteStateU32(writer, world->nextId);
+    WriteStateU32(writer, TRASH_RECORD_SIZE);
+
+    // 正在播放清理动画的垃圾已计入掩码，不再保存
+    WriteStateU32(writer, (uint32_t)(world->count - world->cleaningCount));
+    for (int i = 0; i < world->count; i++) {
+        const Trash *trash = &world->items[i];
+        if (trash->cleaning) continue;
+        SyncWorldTrashRecord(world, i);
+        WriteTrashRecord(writer, world->ids[i], trash);
+    }
+    EndStateSection(writer);
+}
+
+bool ReadTrashWorldSection(TrashWorld *world, const StateFile *file) {
+    StateReader reader;
+    if (!FindStateSection(file, TRASH_SECTION_TAG, 1, TRASH_SECTION_VERSION, &reader)) return false;
+
+    ClearTrashWorld(world);
+    world->cleanedTypes = ReadStateU32(&reader);
+    unsigned int nextId = ReadStateU32(&reader);
+    uint32_t recordSize = ReadStateU32(&reader);
+    uint32_t count = ReadStateU32(&reader);
+    if (recordSize < TRASH_RECORD_SIZE) return false;
+
+    for (uint32_t i = 0; i < count; i++) {
+        // 逐条按记录长度前进，新版本在记录末尾追加的字段被跳过
+        StateReader record = { .size = recordSize, .version = reader.version };
+        record.data = (const unsigned char*)ReadStateBytes(&reader, recordSize);
+        if (record.data == NULL) break;
+
+        unsigned int id;
+        Trash trash;
+        if (!ReadTrashRecord(&record, &id, &trash)) break;
+        if (!IsWorldTrashHandleValid(world, RestoreWorldTrash(world, &trash, id))) break;
+    }
+    if (nextId > world->nextId) world->nextId = nextId;
+    return true;
+}
+
+// 旧版本直接写出的存档: int 数量 | Trash[数量]，编号按顺序分配，已清理类型按记录推断
+static void ReadLegacyTrashWorld(TrashWorld *world, FILE *file) {
+    ClearTrashWorld(world);
+
+    int savedCount = 0;
+    if (fread(&savedCount, sizeof(int), 1, file) != 1 || savedCount < 0) savedCount = 0;
+
+    unsigned int cleanedTypes = 0;
+    for (int i = 0; i < savedCount; i++) {
+        Trash trash;
+        if (fread(&trash, sizeof(Trash), 1, file) != 1) break;
+
+        // 旧版本保留已清理的垃圾，这里只记下类型后丢弃
+        if (trash.cleaning) {
+            if (trash.trashType >= 0 && trash.trashType < 32) cleanedTypes |= 1u << trash.trashType;
+            continue;
+        }
+        if (!trash.active) continue;
+        if (!IsWorldTrashHandleValid(world, AddWorldTrash(world, &trash))) break;
+    }
+    world->cleanedTypes = cleanedTypes;
+}
+
+bool SaveTrashWorld(TrashWorld *world, const char *filename) {
+    StateWriter writer;
+    InitStateWriter(&writer);
+    WriteTrashWorldSection(world, &writer);
+    bool saved = SaveStateFile(&writer, filename);
+    FreeStateWriter(&writer);
+
+    if (!saved) {
+        TraceLog(LOG_WARNING, "垃圾状态写入失败: %s", filename);
+        return false;
+    }
+    TraceLog(LOG_INFO, "垃圾状态已保存到: %s", filename);
+    return true;
+}
+
+bool LoadTrashWorld(TrashWorld *world, const char *filename) {
+    StateFile file;
+    StateFileResult result = OpenStateFile(&file, filename);
+    if (result == STATE_FILE_MISSING) {
+        TraceLog(LOG_WARNING, "未找到垃圾状态文件: %s", filename);
+        return false;
+    }
+
+    bool loaded = false;
+    if (result == STATE_FILE_OK) {
+        loaded = ReadTrashWorldSection(world, &file);
+        CloseStateFile(&file);
+    } else if (result == STATE_FILE_LEGACY) {
+        FILE *legacy = fopen(filename, "rb");
+        if (legacy != NULL) {
+            ReadLegacyTrashWorld(world, legacy);
+            fclose(legacy);
+            loaded = true;
+        }
+    }
+
+    if (!loaded) {
+        TraceLog(LOG_WARNING, "垃圾状态文件无法读取: %s", filename);
+        return false;
+    }
+    TraceLog(LOG_INFO, "垃圾状态已从 %s 加载", filename);
+    return true;
+}
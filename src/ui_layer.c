@@ -0,0 +1,66 @@
+#include "ui_layer.h"
+#include "rlgl.h"
+
+bool BeginUILayer(UILayer *layer, int width, int height, unsigned long long key) {
+    if (width <= 0 || height <= 0) return false;
+    if (layer->valid && layer->width == width && layer->height == height && layer->key == key) {
+        return false;
+    }
+
+    // 窗口尺寸变化时重建渲染纹理
+    if (layer->target.id == 0 || layer->width != width || layer->height != height) {
+        if (layer->target.id != 0) UnloadRenderTexture(layer->target);
+        layer->target = LoadRenderTexture(width, height);
+        layer->width = width;
+        layer->height = height;
+        if (layer->target.id == 0) {
+            layer->valid = false;
+            return false;
+        }
+    }
+
+    layer->key = key;
+    layer->valid = true;
+    layer->rebuilds++;
+    BeginTextureMode(layer->target);
+    return true;
+}
+
+void EndUILayer(UILayer *layer) {
+    (void)layer;
+    EndTextureMode();
+}
+
+void DrawUILayer(const UILayer *layer) {
+    if (!layer->valid) return;
+
+    // 渲染纹理上下颠倒，源矩形高度取负
+    Rectangle source = { 0.0f, 0.0f, (float)layer->width, -(float)layer->height };
+
+    // 层内容不透明，但文字边缘混合后 alpha 会小于 1，关闭混合直接覆盖，避免透出底色
+    rlDrawRenderBatchActive();
+    rlDisableColorBlend();
+    DrawTextureRec(layer->target.texture, source, (Vector2){ 0.0f, 0.0f }, WHITE);
+    rlDrawRenderBatchActive();
+    rlEnableColorBlend();
+}
+
+void InvalidateUILayer(UILayer *layer) {
+    layer->valid = false;
+}
+
+void UnloadUILayer(UILayer *layer) {
+    if (layer->target.id != 0) {
+        UnloadRenderTexture(layer->target);
+    }
+    *layer = (UILayer){0};
+}
+
+unsigned long long HashUILayerData(unsigned long long hash, const void *data, size_t size) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
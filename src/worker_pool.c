@@ -0,0 +1,313 @@
+#include "worker_pool.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    typedef HANDLE WorkerThread;
+    typedef CRITICAL_SECTION WorkerMutex;
+    typedef CONDITION_VARIABLE WorkerCond;
+#else
+    #include <pthread.h>
+    #include <sched.h>
+    #include <unistd.h>
+    typedef pthread_t WorkerThread;
+    typedef pthread_mutex_t WorkerMutex;
+    typedef pthread_cond_t WorkerCond;
+#endif
+
+#define MAX_WORKER_THREADS 16
+#define INITIAL_JOB_CAPACITY 64
+
+typedef struct {
+    WorkerJobFunc func;
+    void *userData;
+} WorkerJob;
+
+// 线程池状态
+static WorkerThread workerThreads[MAX_WORKER_THREADS];
+static int workerThreadCount = 0;
+static WorkerMutex poolMutex;
+static WorkerCond jobAvailable;      // 有新任务或需要退出
+static WorkerCond jobsFinished;      // 队列清空且没有正在执行的任务
+static WorkerJob *jobQueue = NULL;   // 环形队列
+static int jobCapacity = 0;
+static int jobHead = 0;
+static int jobCount = 0;
+static int jobsRunning = 0;
+static bool poolStopping = false;
+
+// ---------------- 平台封装 ----------------
+#if defined(_WIN32)
+static void LockPool(void) { EnterCriticalSection(&poolMutex); }
+static void UnlockPool(void) { LeaveCriticalSection(&poolMutex); }
+static void WaitCond(WorkerCond *cond) { SleepConditionVariableCS(cond, &poolMutex, INFINITE); }
+static void SignalCond(WorkerCond *cond) { WakeConditionVariable(cond); }
+static void BroadcastCond(WorkerCond *cond) { WakeAllConditionVariable(cond); }
+static void YieldThread(void) { SwitchToThread(); }
+#else
+static void LockPool(void) { pthread_mutex_lock(&poolMutex); }
+static void UnlockPool(void) { pthread_mutex_unlock(&poolMutex); }
+static void WaitCond(WorkerCond *cond) { pthread_cond_wait(cond, &poolMutex); }
+static void SignalCond(WorkerCond *cond) { pthread_cond_signal(cond); }
+static void BroadcastCond(WorkerCond *cond) { pthread_cond_broadcast(cond); }
+static void YieldThread(void) { sched_yield(); }
+#endif
+
+int GetCpuCoreCount(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return (cores > 0) ? (int)cores : 1;
+#endif
+}
+
+// 工作线程主循环
+static void WorkerLoop(void) {
+    LockPool();
+    for (;;) {
+        while (jobCount == 0 && !poolStopping) {
+            WaitCond(&jobAvailable);
+        }
+        if (jobCount == 0 && poolStopping) break;
+
+        WorkerJob job = jobQueue[jobHead];
+        jobHead = (jobHead + 1) % jobCapacity;
+        jobCount--;
+        jobsRunning++;
+        UnlockPool();
+
+        job.func(job.userData);
+
+        LockPool();
+        jobsRunning--;
+        if (jobCount == 0 && jobsRunning == 0) {
+            BroadcastCond(&jobsFinished);
+        }
+    }
+    UnlockPool();
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI WorkerThreadMain(LPVOID arg) {
+    (void)arg;
+    WorkerLoop();
+    return 0;
+}
+#else
+static void *WorkerThreadMain(void *arg) {
+    (void)arg;
+    WorkerLoop();
+    return NULL;
+}
+#endif
+
+bool InitWorkerPool(int threadCount) {
+    if (workerThreadCount > 0) return true;
+
+    if (threadCount <= 0) threadCount = GetCpuCoreCount() - 1;  // 主线程保留一个核心
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > MAX_WORKER_THREADS) threadCount = MAX_WORKER_THREADS;
+
+#if defined(_WIN32)
+    InitializeCriticalSection(&poolMutex);
+    InitializeConditionVariable(&jobAvailable);
+    InitializeConditionVariable(&jobsFinished);
+#else
+    pthread_mutex_init(&poolMutex, NULL);
+    pthread_cond_init(&jobAvailable, NULL);
+    pthread_cond_init(&jobsFinished, NULL);
+#endif
+
+    jobCapacity = INITIAL_JOB_CAPACITY;
+    jobQueue = (WorkerJob *)malloc(jobCapacity * sizeof(WorkerJob));
+    jobHead = 0;
+    jobCount = 0;
+    jobsRunning = 0;
+    poolStopping = false;
+
+    for (int i = 0; i < threadCount; i++) {
+#if defined(_WIN32)
+        workerThreads[i] = CreateThread(NULL, 0, WorkerThreadMain, NULL, 0, NULL);
+        if (workerThreads[i] == NULL) break;
+#else
+        if (pthread_create(&workerThreads[i], NULL, WorkerThreadMain, NULL) != 0) break;
+#endif
+        workerThreadCount++;
+    }
+
+    return workerThreadCount > 0;
+}
+
+void ShutdownWorkerPool(void) {
+    if (workerThreadCount == 0) return;
+
+    LockPool();
+    poolStopping = true;
+    BroadcastCond(&jobAvailable);
+    UnlockPool();
+
+    for (int i = 0; i < workerThreadCount; i++) {
+#if defined(_WIN32)
+        WaitForSingleObject(workerThreads[i], INFINITE);
+        CloseHandle(workerThreads[i]);
+#else
+        pthread_join(workerThreads[i], NULL);
+#endif
+    }
+    workerThreadCount = 0;
+
+#if defined(_WIN32)
+    DeleteCriticalSection(&poolMutex);
+#else
+    pthread_cond_destroy(&jobsFinished);
+    pthread_cond_destroy(&jobAvailable);
+    pthread_mutex_destroy(&poolMutex);
+#endif
+
+    free(jobQueue);
+    jobQueue = NULL;
+    jobCapacity = 0;
+}
+
+bool SubmitWorkerJob(WorkerJobFunc func, void *userData) {
+    if (workerThreadCount == 0) {
+        func(userData);
+        return false;
+    }
+
+    LockPool();
+    if (jobCount == jobCapacity) {
+        // 队列满时扩容，并把环形队列展开为从 0 开始
+        int newCapacity = jobCapacity * 2;
+        WorkerJob *newQueue = (WorkerJob *)malloc(newCapacity * sizeof(WorkerJob));
+        for (int i = 0; i < jobCount; i++) {
+            newQueue[i] = jobQueue[(jobHead + i) % jobCapacity];
+        }
+        free(jobQueue);
+        jobQueue = newQueue;
+        jobCapacity = newCapacity;
+        jobHead = 0;
+    }
+    jobQueue[(jobHead + jobCount) % jobCapacity] = (WorkerJob){ func, userData };
+    jobCount++;
+    SignalCond(&jobAvailable);
+    UnlockPool();
+
+    return true;
+}
+
+void WaitWorkerJobs(void) {
+    if (workerThreadCount == 0) return;
+
+    LockPool();
+    while (jobCount > 0 || jobsRunning > 0) {
+        WaitCond(&jobsFinished);
+    }
+    UnlockPool();
+}
+
+int GetWorkerThreadCount(void) {
+    return workerThreadCount;
+}
+
+// 撤回仍在队列中、尚未被工作线程取走的任务，保持其余任务的顺序，返回撤回的数量
+static int CancelQueuedWorkerJobs(WorkerJobFunc func, void *userData) {
+    LockPool();
+    int kept = 0;
+    for (int i = 0; i < jobCount; i++) {
+        WorkerJob job = jobQueue[(jobHead + i) % jobCapacity];
+        if (job.func == func && job.userData == userData) continue;
+        jobQueue[(jobHead + kept) % jobCapacity] = job;
+        kept++;
+    }
+    int removed = jobCount - kept;
+    jobCount = kept;
+    if (jobCount == 0 && jobsRunning == 0) {
+        BroadcastCond(&jobsFinished);
+    }
+    UnlockPool();
+    return removed;
+}
+
+// ---------------- 并行循环 ----------------
+// 任务放在调用方的栈上，不做任何分配：辅助任务可能排在耗时的解码任务之后，
+// 主线程做完所有批次后把还没开始的辅助任务从队列中撤回，只等待已经开始的辅助任务退出
+typedef struct {
+    WorkerRangeFunc func;
+    void *userData;
+    int count;
+    int batchSize;
+    int batchCount;
+    atomic_int nextBatch;
+    atomic_int finishedBatches;
+    atomic_int activeHelpers;    // 已提交且未撤回、尚未退出的辅助任务
+} ParallelForTask;
+
+static void RunParallelBatches(ParallelForTask *task) {
+    for (;;) {
+        int batch = atomic_fetch_add(&task->nextBatch, 1);
+        if (batch >= task->batchCount) break;
+
+        int begin = batch * task->batchSize;
+        int end = begin + task->batchSize;
+        if (end > task->count) end = task->count;
+        task->func(begin, end, task->userData);
+        atomic_fetch_add(&task->finishedBatches, 1);
+    }
+}
+
+static void ParallelForJob(void *userData) {
+    ParallelForTask *task = (ParallelForTask *)userData;
+    RunParallelBatches(task);
+    // 之后不能再访问 task，主线程随时可能返回
+    atomic_fetch_sub(&task->activeHelpers, 1);
+}
+
+void ParallelFor(int count, int batchSize, WorkerRangeFunc func, void *userData) {
+    if (count <= 0) return;
+    if (batchSize < 1) batchSize = 1;
+
+    int batchCount = (count + batchSize - 1) / batchSize;
+    int helpers = (workerThreadCount < batchCount - 1) ? workerThreadCount : batchCount - 1;
+
+    // 没有工作线程或只有一个批次：在当前线程按同样的批次边界执行
+    if (helpers <= 0) {
+        for (int begin = 0; begin < count; begin += batchSize) {
+            func(begin, (begin + batchSize < count) ? begin + batchSize : count, userData);
+        }
+        return;
+    }
+
+    ParallelForTask task = {
+        .func = func,
+        .userData = userData,
+        .count = count,
+        .batchSize = batchSize,
+        .batchCount = batchCount
+    };
+    atomic_init(&task.nextBatch, 0);
+    atomic_init(&task.finishedBatches, 0);
+    atomic_init(&task.activeHelpers, helpers);
+
+    for (int i = 0; i < helpers; i++) {
+        SubmitWorkerJob(ParallelForJob, &task);
+    }
+
+    // 主线程同样领取批次，工作线程全忙时也能独立完成
+    RunParallelBatches(&task);
+    while (atomic_load(&task.finishedBatches) < batchCount) {
+        YieldThread();
+    }
+
+    int cancelled = CancelQueuedWorkerJobs(ParallelForJob, &task);
+    atomic_fetch_sub(&task.activeHelpers, cancelled);
+    while (atomic_load(&task.activeHelpers) > 0) {
+        YieldThread();
+    }
+}
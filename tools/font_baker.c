@@ -0,0 +1,141 @@
+// 构建期字体烘焙工具
+// 扫描源码中的字符串字面量，收集实际用到的字符，生成预烘焙字体图集（格式见 font_cache.h）
+//
+// 用法: font_baker <字体文件> <字号> <输出文件> <源码文件...>
+
+#include "raylib.h"
+#include "font_cache.h"
+#include "codepoint_set.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static CodepointSet usedCodepoints = {0};
+
+// 收集一个字符串字面量中的字符（转义序列之间分段加入）
+static void CollectLiteral(const char *text, int length) {
+    int start = 0;
+    for (int i = 0; i < length; i++) {
+        if (text[i] == '\\') {
+            AddCodepointsFromText(&usedCodepoints, &text[start], i - start);
+            start = ++i + 1;
+        }
+    }
+    if (start < length) AddCodepointsFromText(&usedCodepoints, &text[start], length - start);
+}
+
+// 扫描 C 源文件中的字符串字面量，跳过注释与字符常量
+static bool ScanSourceFile(const char *fileName) {
+    int size = 0;
+    unsigned char *data = LoadFileData(fileName, &size);
+    if (data == NULL) return false;
+
+    const char *text = (const char *)data;
+    int i = 0;
+    while (i < size) {
+        if (text[i] == '/' && i + 1 < size && text[i + 1] == '/') {
+            while (i < size && text[i] != '\n') i++;
+        } else if (text[i] == '/' && i + 1 < size && text[i + 1] == '*') {
+            i += 2;
+            while (i + 1 < size && !(text[i] == '*' && text[i + 1] == '/')) i++;
+            i += 2;
+        } else if (text[i] == '\'') {
+            i++;
+            while (i < size && text[i] != '\'') i += (text[i] == '\\') ? 2 : 1;
+            i++;
+        } else if (text[i] == '"') {
+            int start = ++i;
+            while (i < size && text[i] != '"' && text[i] != '\n') i += (text[i] == '\\') ? 2 : 1;
+            CollectLiteral(&text[start], i - start);
+            i++;
+        } else {
+            i++;
+        }
+    }
+
+    UnloadFileData(data);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        fprintf(stderr, "用法: %s <字体文件> <字号> <输出文件> <源码文件...>\n", argv[0]);
+        return 1;
+    }
+
+    const char *fontFile = argv[1];
+    int fontSize = atoi(argv[2]);
+    const char *outputFile = argv[3];
+    const int padding = 4;
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    // 可打印 ASCII 始终包含，用户输入的数字与符号无需回退
+    AddCodepointRanges(&usedCodepoints, CODEPOINT_RANGES_ASCII, CODEPOINT_RANGES_ASCII_COUNT);
+    for (int i = 4; i < argc; i++) {
+        if (!ScanSourceFile(argv[i])) {
+            fprintf(stderr, "无法读取源码文件: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    // 按码点升序排列，运行时可二分查找
+    int *codepoints = (int *)malloc(usedCodepoints.count * sizeof(int));
+    int count = CodepointSetToArray(&usedCodepoints, codepoints, usedCodepoints.count);
+
+    int fileSize = 0;
+    unsigned char *fileData = LoadFileData(fontFile, &fileSize);
+    if (fileData == NULL) {
+        fprintf(stderr, "无法读取字体文件: %s\n", fontFile);
+        return 1;
+    }
+
+    GlyphInfo *glyphs = LoadFontData(fileData, fileSize, fontSize, codepoints, count, FONT_DEFAULT);
+    if (glyphs == NULL) {
+        fprintf(stderr, "字体解析失败: %s\n", fontFile);
+        return 1;
+    }
+
+    Rectangle *recs = NULL;
+    Image atlas = GenImageFontAtlas(glyphs, &recs, count, fontSize, padding, 0);
+
+    FILE *file = fopen(outputFile, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "无法写入: %s\n", outputFile);
+        return 1;
+    }
+
+    BakedFontHeader header = {
+        .version = BAKED_FONT_VERSION,
+        .baseSize = fontSize,
+        .glyphPadding = padding,
+        .glyphCount = count,
+        .atlasWidth = atlas.width,
+        .atlasHeight = atlas.height,
+        .atlasFormat = atlas.format
+    };
+    memcpy(header.magic, BAKED_FONT_MAGIC, 4);
+    fwrite(&header, sizeof(header), 1, file);
+
+    for (int i = 0; i < count; i++) {
+        BakedGlyph glyph = {
+            .value = glyphs[i].value,
+            .offsetX = glyphs[i].offsetX,
+            .offsetY = glyphs[i].offsetY,
+            .advanceX = glyphs[i].advanceX,
+            .rec = recs[i]
+        };
+        fwrite(&glyph, sizeof(glyph), 1, file);
+    }
+    fwrite(atlas.data, 1, (size_t)GetPixelDataSize(atlas.width, atlas.height, atlas.format), file);
+    fclose(file);
+
+    printf("font_baker: %s -> %s (%d 字形, 图集 %dx%d)\n", fontFile, outputFile, count, atlas.width, atlas.height);
+
+    UnloadImage(atlas);
+    MemFree(recs);
+    UnloadFontData(glyphs, count);
+    UnloadFileData(fileData);
+    free(codepoints);
+    return 0;
+}